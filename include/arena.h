@@ -0,0 +1,264 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file arena.h
+///
+///  @brief
+///  Defines the Arena class and the Arena_allocator template.
+///
+///  @remarks
+///  The line tables of the functions and the non-inlined lines of their
+///  blocks are made of millions of small vectors, which live until the
+///  process exits. They are carved out of large chunks instead of being
+///  allocated and freed one by one.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef ARENA_H
+#define ARENA_H
+
+// SYSTEM INCLUDES
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+/// @brief
+/// A monotonic allocator: memory is only given back when the whole arena
+/// is released. Each thread carves its allocations out of a chunk of its
+/// own, so the threads only synchronize to get a new chunk.
+class Arena : boost::noncopyable
+{
+public:
+
+// PUBLIC CONSTANTS
+
+   /// The size of the chunks the allocations are carved out of.
+   static const std::size_t Chunk_size = 1 << 20;
+
+   /// The alignment of every allocation.
+   static const std::size_t Alignment = 2 * sizeof( void * );
+
+// PUBLIC TYPES
+
+   /// @brief
+   /// The usage of an arena.
+   struct Stats
+   {
+      /// The number of allocations served.
+      std::size_t m_allocations;
+
+      /// The number of bytes allocated.
+      std::size_t m_bytes;
+
+      /// The number of chunks reserved.
+      std::size_t m_chunks;
+
+      /// The number of bytes reserved in chunks.
+      std::size_t m_reserved;
+   };
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes an empty arena.
+   Arena();
+
+   /// @brief
+   /// Releases the chunks of the arena.
+   ~Arena();
+
+   /// @brief
+   /// Returns the arena of the parsed coverage model, which lives until
+   /// the process exits.
+   static Arena & get_model_arena();
+
+   /// @brief
+   /// Allocates memory from the chunk of the calling thread.
+   ///
+   /// @param size The number of bytes.
+   ///
+   /// @return The memory, aligned to Alignment.
+   void * allocate( std::size_t size );
+
+   /// @brief
+   /// Frees all the memory allocated from the arena at once.
+   ///
+   /// @remarks
+   /// No thread may allocate from the arena meanwhile, and nothing may use
+   /// the memory allocated so far afterwards.
+   void release();
+
+   /// @brief
+   /// Returns the usage of the arena since it was last released.
+   Stats get_stats() const;
+
+private:
+
+// PRIVATE TYPES
+
+   /// @brief
+   /// The free part of the chunk a thread allocates from.
+   struct Cursor
+   {
+      /// The next free byte.
+      char * m_next;
+
+      /// The end of the chunk.
+      char * m_end;
+
+      /// The number of allocations served to the thread.
+      std::size_t m_allocations;
+
+      /// The number of bytes allocated by the thread.
+      std::size_t m_bytes;
+   };
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Returns the cursor of the calling thread, creating it on first use.
+   Cursor & get_cursor();
+
+   /// @brief
+   /// Reserves a new chunk.
+   ///
+   /// @param size The size of the chunk.
+   char * reserve( std::size_t size );
+
+   /// @brief
+   /// Leaves the cursors owned by the arena to it when a thread exits.
+   static void keep_cursor( Cursor * cursor );
+
+// PRIVATE MEMBERS
+
+   /// Guards m_chunks, m_cursors and m_reserved.
+   mutable boost::mutex m_mutex;
+
+   /// The cursor of each thread, owned by m_cursors.
+   boost::thread_specific_ptr<Cursor> m_cursor;
+
+   /// The cursors of all the threads which allocated from the arena.
+   std::vector<Cursor *> m_cursors;
+
+   /// The chunks reserved.
+   std::vector<char *> m_chunks;
+
+   /// The number of bytes reserved in chunks.
+   std::size_t m_reserved;
+
+}; // End of class Arena
+
+/// @brief
+/// A standard allocator serving the parsed coverage model from the model
+/// arena. Deallocation does nothing, the memory is reclaimed with the
+/// arena. All the allocators are equal, so containers using it may be
+/// swapped and merged across the parser threads.
+template <class T>
+class Arena_allocator
+{
+public:
+
+// PUBLIC TYPES
+
+   typedef T value_type;
+   typedef T * pointer;
+   typedef const T * const_pointer;
+   typedef T & reference;
+   typedef const T & const_reference;
+   typedef std::size_t size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   template <class U>
+   struct rebind
+   {
+      typedef Arena_allocator<U> other;
+   };
+
+// PUBLIC METHODS
+
+   Arena_allocator()
+   {
+      // void
+   }
+
+   template <class U>
+   Arena_allocator( const Arena_allocator<U> & )
+   {
+      // void
+   }
+
+   pointer address( reference value ) const
+   {
+      return &value;
+   }
+
+   const_pointer address( const_reference value ) const
+   {
+      return &value;
+   }
+
+   pointer allocate( size_type count, const void * = 0 )
+   {
+      return static_cast<pointer>( 
+         Arena::get_model_arena().allocate( count * sizeof( T ) ) );
+   }
+
+   void deallocate( pointer, size_type )
+   {
+      // void
+   }
+
+   size_type max_size() const
+   {
+      return static_cast<size_type>( -1 ) / sizeof( T );
+   }
+
+   void construct( pointer p, const T & value )
+   {
+      new ( p ) T( value );
+   }
+
+   void destroy( pointer p )
+   {
+      p->~T();
+   }
+
+}; // End of class Arena_allocator
+
+template <class T, class U>
+bool operator==( const Arena_allocator<T> &, const Arena_allocator<U> & )
+{
+   return true;
+}
+
+template <class T, class U>
+bool operator!=( const Arena_allocator<T> &, const Arena_allocator<U> & )
+{
+   return false;
+}
+
+#endif
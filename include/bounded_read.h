@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file bounded_read.h
+///
+///  @brief
+///  Defines the bounded read of data whose size comes from the input.
+///
+///  @remarks
+///  The gcda streams, tar archives and parse traces announce the size of
+///  the data that follows. A corrupt or hostile size must fail the read
+///  rather than allocate all of it up front, so the data is read in
+///  chunks and the buffer only grows as the bytes arrive.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef BOUNDED_READ_H
+#define BOUNDED_READ_H
+
+// SYSTEM INCLUDES
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <inttypes.h>
+
+/// The most bytes a bounded read allocates ahead of the bytes read.
+const std::size_t Bounded_read_chunk = 64 * 1024;
+
+/// @brief
+/// Reads data of an untrusted size from a stream.
+///
+/// @param in The stream to read from.
+/// @param size The size of the data, as announced by the input.
+/// @param data Receives the data, a vector of char or a string. It is 
+/// left empty on failure.
+///
+/// @return success(true), the stream ended first(false)
+template <class Container>
+bool read_bounded( std::istream & in, uint64_t size, Container & data )
+{
+   data.clear();
+
+   while ( data.size() < size )
+   {
+      const std::size_t offset = data.size();
+      const std::size_t count = static_cast<std::size_t>( 
+         std::min<uint64_t>( Bounded_read_chunk, size - offset ) );
+
+      data.resize( offset + count );
+      if ( ! in.read( &data[offset], static_cast<std::streamsize>( count ) ) )
+      {
+         data.clear();
+         return false;
+      }
+   }
+
+   return true;
+}
+
+#endif
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file byte_order.h
+///
+///  @brief
+///  Declares the byte order helpers of the gcov decoder.
+///
+///  @remarks
+///  gcov files are written in the byte order of the target, so files of big
+///  endian targets have every int32 reversed when read on a little endian
+///  host. Runs of arc counters are converted in bulk with the widest vector
+///  unit the host supports, chosen at run time.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+// SYSTEM INCLUDES
+
+#include <cstddef>
+#include <inttypes.h>
+
+/// @brief
+/// Reverses the bytes of an int32.
+///
+/// @param value The int32 to reverse.
+///
+/// @return The reversed int32.
+inline unsigned int swap_int32( unsigned int value )
+{
+   return ( value >> 24 ) | ( ( value >> 8 ) & 0x0000FF00 ) |
+          ( ( value << 8 ) & 0x00FF0000 ) | ( value << 24 );
+}
+
+/// @brief
+/// Decodes a run of gcov int64 values, each stored as a low and a high int32.
+///
+/// @param first The first byte of the run.
+/// @param count The number of int64 values in the run.
+/// @param little_endian If the file does not need its bytes reversed.
+/// @param out Receives the count decoded values.
+void decode_int64_run(
+   const char * first,
+   std::size_t count,
+   const bool little_endian,
+   uint64_t * out );
+
+/// @brief
+/// Decodes a run of gcov int64 values one at a time. Used when the host has
+/// no vector unit, and as the reference of the vector kernels.
+///
+/// @param first The first byte of the run.
+/// @param count The number of int64 values in the run.
+/// @param little_endian If the file does not need its bytes reversed.
+/// @param out Receives the count decoded values.
+void decode_int64_run_scalar(
+   const char * first,
+   std::size_t count,
+   const bool little_endian,
+   uint64_t * out );
+
+/// @brief
+/// Returns the name of the kernel reversing int64 runs on this host.
+const char * int64_run_kernel_name();
+
+#endif
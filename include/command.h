@@ -52,6 +52,7 @@
 #include "dot_creator.h"
 #include "coverage_creator.h"
 #include "selector.h"
+#include "trace.h"
 
 /// @class Parser
 ///
@@ -120,6 +121,15 @@ private:
     /// Runs the report command the render command.
     int do_all_report();
 
+    /// @brief
+    /// Prints the parse traces of the selection as debug dump text.
+    int do_dump_trace();
+
+    /// @brief
+    /// Prints the peak resident set size of the process and the usage of
+    /// the arena of the parsed coverage data to stderr.
+    void print_memory_stats() const;
+
 //  PRIVATE MEMBERS
 
     /// Pointer to the instance.
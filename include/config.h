@@ -90,6 +90,8 @@ public:
    static const std::string Graph_report;
    /// The string of the all_report command.
    static const std::string All_report;
+   /// The string of the dump_trace command.
+   static const std::string Dump_trace;
 
    static const std::string Selection;
    /// The string of the source directory option.
@@ -97,6 +99,9 @@ public:
    /// The string of the build option.
    static const std::string Build_directory;
    static const std::string Command;
+
+   /// The number of pairs of files read ahead of the parsing by default.
+   static const unsigned int Default_prefetch_window = 4;
   
    enum Bool_flag
    {
@@ -118,7 +123,9 @@ public:
       Sort_name,  
       Show_external_inline,
       Hide_external_inline,
-      Secret_gui 
+      Secret_gui,
+      Spirit_parser,
+      Memory_stats
    };
 
    enum String_flag
@@ -129,7 +136,14 @@ public:
       Working_directory,
       Config_file,
       Cache_file,
-      Outfile  
+      Outfile,
+      Gcda_stream
+   };
+
+   enum Number_flag
+   {
+      Jobs,
+      Prefetch
    };
 
 // PUBLIC METHODS
@@ -151,9 +165,11 @@ public:
 
       bool get_flag_value(Bool_flag flag);
       std::string get_flag_value(String_flag flag);
+      unsigned int get_flag_value(Number_flag flag);
 
       std::string get_flag_name(Bool_flag flag);
       std::string get_flag_name(String_flag flag);
+      std::string get_flag_name(Number_flag flag);
 
       /// @brief
       /// Returns a list of ".c" or ".cpp" files from the src_dir.
@@ -163,6 +179,20 @@ public:
       /// Returns a list of ".gcno" and ".gcda" files from the build_dir.
       std::vector< std::pair<std::string, std::string> > get_build_files();
 
+      /// @brief
+      /// Returns every ".gcno" file from the build_dir, with or without a
+      /// ".gcda" file.
+      const std::vector<std::string> & get_gcno_files();
+
+      /// @brief
+      /// Returns the tar archives given as build directories.
+      const std::vector<std::string> & get_archive_files();
+
+      /// @brief
+      /// Returns the gcov json files (".gcov.json" or ".gcov.json.gz") from
+      /// the build_dir.
+      const std::vector<std::string> & get_json_files();
+
       /// @brief
       /// Returns a list of selection.
       const std::vector<std::string> & get_selection();
@@ -187,6 +217,9 @@ public:
       std::map<String_flag, std::string> m_string_flag_value; 
       std::map<String_flag, std::string> m_string_flag_name; 
 
+      std::map<Number_flag, unsigned int> m_number_flag_value; 
+      std::map<Number_flag, std::string> m_number_flag_name; 
+
       // List of source directorie(s)
       std::vector<std::string> srcdir;
 
@@ -199,6 +232,15 @@ public:
       // List of GCNO and GCDA fiels
       std::vector< std::pair<std::string, std::string> > build_list;
 
+      // List of all GCNO files
+      std::vector<std::string> gcno_list;
+
+      // List of tar archives of GCNO and GCDA files
+      std::vector<std::string> archive_list;
+
+      // List of gcov json files
+      std::vector<std::string> json_list;
+
       // List of selection.
       std::vector<std::string> select_list;
 
@@ -238,6 +280,12 @@ public:
       /// @param string file path.
       const bool is_gcda(std::string);
 
+      /// @brief
+      /// Determines the input path is a gcov json file or not
+      ///
+      /// @param file_name file path.
+      const bool is_gcov_json(const std::string & file_name);
+
       /// @brief
       /// Determines if a file is a C or C++ file.
       ///
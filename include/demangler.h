@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file demangler.h
+///
+///  @brief
+///  Defines the Demangler class.
+///
+///  @remarks
+///  The same function names, template instantiations especially, are
+///  found in the gcno files of many translation units. Each name is
+///  demangled once and shared by all the parser threads.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DEMANGLER_H
+#define DEMANGLER_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+
+/// @brief
+/// Demangles function names and remembers the names demangled so far.
+class Demangler : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Returns the single instance shared by the whole process.
+   static Demangler & get_instance();
+
+   /// @brief
+   /// Returns the demangled name of a function.
+   ///
+   /// @param name The mangled name of the function.
+   ///
+   /// @return The demangled name, or the name itself if it is not mangled.
+   /// The reference stays valid for the life of the process.
+   const std::string & demangle( const std::string & name );
+
+   /// @brief
+   /// Returns the number of names demangled so far.
+   std::size_t size() const;
+
+private:
+
+// PRIVATE TYPES
+
+   /// Maps a mangled name to its demangled name.
+   typedef boost::unordered_map<std::string, std::string> Name_map;
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Initializes an empty table.
+   Demangler() 
+   {
+      // void
+   }
+
+// PRIVATE MEMBERS
+
+   /// Guards m_names.
+   mutable boost::mutex m_mutex;
+
+   /// The names demangled so far. Its nodes are never moved, so the
+   /// references handed out stay valid while it grows.
+   Name_map m_names;
+
+}; // End of class Demangler
+
+#endif
@@ -0,0 +1,438 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file dense_map.h
+///
+///  @brief
+///  Defines the Dense_map template.
+///
+///  @remarks
+///  The sources and records of the coverage model are looked up by the
+///  decoders and walked in key order by every pass and report.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef DENSE_MAP_H
+#define DENSE_MAP_H
+
+// SYSTEM INCLUDES
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/utility/enable_if.hpp>
+
+/// @brief
+/// An associative container for the coverage model. The values are stored
+/// in chunks which never move, indexed by an open-addressing hash table,
+/// and walked through a vector of pointers sorted by key, so the iteration
+/// order is that of a std::map.
+///
+/// @remarks
+/// Values are never erased. Inserting a key invalidates the iterators but
+/// not the references to the values, which stay valid until the map is
+/// cleared or destroyed. Swapping maps keeps the references valid too.
+template <class Key, class Value, 
+   class Hash = boost::hash<Key>, class Compare = std::less<Key> >
+class Dense_map
+{
+public:
+
+// PUBLIC TYPES
+
+   typedef Key key_type;
+   typedef Value mapped_type;
+   typedef std::pair<const Key, Value> value_type;
+   typedef std::size_t size_type;
+
+   /// @brief
+   /// Walks the values of the map in key order.
+   template <class Pointee>
+   class Order_iterator
+   {
+   public:
+
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef Pointee value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Pointee * pointer;
+      typedef Pointee & reference;
+
+      Order_iterator() : m_pos( NULL )
+      {
+         // void
+      }
+
+      explicit Order_iterator( typename Dense_map::value_type * const * pos )
+         : m_pos( pos )
+      {
+         // void
+      }
+
+      /// Converts an iterator to a const_iterator.
+      template <class Other>
+      Order_iterator( const Order_iterator<Other> & other,
+         typename boost::enable_if< 
+            boost::is_convertible<Other *, Pointee *> >::type * = NULL )
+         : m_pos( other.base() )
+      {
+         // void
+      }
+
+      reference operator*() const
+      {
+         return **m_pos;
+      }
+
+      pointer operator->() const
+      {
+         return *m_pos;
+      }
+
+      Order_iterator & operator++()
+      {
+         ++m_pos;
+         return *this;
+      }
+
+      Order_iterator operator++( int )
+      {
+         Order_iterator old( *this );
+         ++m_pos;
+         return old;
+      }
+
+      Order_iterator & operator--()
+      {
+         --m_pos;
+         return *this;
+      }
+
+      Order_iterator operator--( int )
+      {
+         Order_iterator old( *this );
+         --m_pos;
+         return old;
+      }
+
+      /// @brief
+      /// Returns the position of the iterator in the order of the map.
+      typename Dense_map::value_type * const * base() const
+      {
+         return m_pos;
+      }
+
+      friend bool operator==( 
+         const Order_iterator & left, const Order_iterator & right )
+      {
+         return left.m_pos == right.m_pos;
+      }
+
+      friend bool operator!=( 
+         const Order_iterator & left, const Order_iterator & right )
+      {
+         return left.m_pos != right.m_pos;
+      }
+
+   private:
+
+      /// The position in the order of the map.
+      typename Dense_map::value_type * const * m_pos;
+
+   }; // End of class Order_iterator
+
+   typedef Order_iterator<value_type> iterator;
+   typedef Order_iterator<const value_type> const_iterator;
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes an empty map.
+   Dense_map() : m_size( 0 )
+   {
+      // void
+   }
+
+   /// @brief
+   /// Copies the keys and values of another map.
+   Dense_map( const Dense_map & other ) : m_size( 0 )
+   {
+      insert_all( other );
+   }
+
+   /// @brief
+   /// Destroys the values of the map.
+   ~Dense_map()
+   {
+      clear();
+   }
+
+   Dense_map & operator=( const Dense_map & other )
+   {
+      if ( this != &other )
+      {
+         Dense_map copy( other );
+         swap( copy );
+      }
+      return *this;
+   }
+
+   /// @brief
+   /// Returns the value of a key, inserting a default one if missing.
+   Value & operator[]( const Key & key )
+   {
+      value_type * const * slot = find_slot( key );
+      if ( slot != NULL && *slot != NULL )
+      {
+         return ( *slot )->second;
+      }
+      return insert_new( key )->second;
+   }
+
+   /// @brief
+   /// Returns the value of a key, or end() if missing.
+   ///
+   /// @remarks
+   /// The key is located by hash, then its position in the order by a
+   /// binary search. Use operator[] or count() when the position is not
+   /// needed.
+   iterator find( const Key & key )
+   {
+      return iterator( find_position( key ) );
+   }
+
+   const_iterator find( const Key & key ) const
+   {
+      return const_iterator( find_position( key ) );
+   }
+
+   /// @brief
+   /// Returns 1 if the map has a key, 0 otherwise.
+   size_type count( const Key & key ) const
+   {
+      value_type * const * slot = find_slot( key );
+      return slot != NULL && *slot != NULL ? 1 : 0;
+   }
+
+   iterator begin()
+   {
+      return iterator( order_begin() );
+   }
+
+   iterator end()
+   {
+      return iterator( order_begin() + m_size );
+   }
+
+   const_iterator begin() const
+   {
+      return const_iterator( order_begin() );
+   }
+
+   const_iterator end() const
+   {
+      return const_iterator( order_begin() + m_size );
+   }
+
+   size_type size() const
+   {
+      return m_size;
+   }
+
+   bool empty() const
+   {
+      return m_size == 0;
+   }
+
+   /// @brief
+   /// Destroys all the values of the map.
+   void clear()
+   {
+      for ( size_type i = 0; i < m_size; ++i )
+      {
+         m_order[i]->~value_type();
+      }
+      for ( size_type i = 0; i < m_chunks.size(); ++i )
+      {
+         ::operator delete( m_chunks[i] );
+      }
+      m_chunks.clear();
+      m_order.clear();
+      m_slots.clear();
+      m_size = 0;
+   }
+
+   /// @brief
+   /// Exchanges the contents of two maps, without moving the values.
+   void swap( Dense_map & other )
+   {
+      m_chunks.swap( other.m_chunks );
+      m_order.swap( other.m_order );
+      m_slots.swap( other.m_slots );
+      std::swap( m_size, other.m_size );
+   }
+
+private:
+
+// PRIVATE CONSTANTS
+
+   /// The number of values in a chunk.
+   static const size_type Chunk_count = 16;
+
+// PRIVATE TYPES
+
+   /// @brief
+   /// Orders the values by key.
+   struct Key_less
+   {
+      bool operator()( const value_type * left, const Key & right ) const
+      {
+         return Compare()( left->first, right );
+      }
+
+      bool operator()( const Key & left, const value_type * right ) const
+      {
+         return Compare()( left, right->first );
+      }
+   };
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Returns the first value in key order, or NULL if empty.
+   value_type * const * order_begin() const
+   {
+      return m_order.empty() ? NULL : &m_order[0];
+   }
+
+   /// @brief
+   /// Returns the slot of a key in the hash table: the slot holding its
+   /// value, or the empty slot ending its probe. Returns NULL if the table
+   /// is not allocated yet.
+   value_type * const * find_slot( const Key & key ) const
+   {
+      if ( m_slots.empty() )
+      {
+         return NULL;
+      }
+
+      const size_type mask = m_slots.size() - 1;
+      size_type index = Hash()( key ) & mask;
+      while ( m_slots[index] != NULL && ! ( m_slots[index]->first == key ) )
+      {
+         index = ( index + 1 ) & mask;
+      }
+      return &m_slots[index];
+   }
+
+   /// @brief
+   /// Returns the position of a key in the order, or the end if missing.
+   value_type * const * find_position( const Key & key ) const
+   {
+      value_type * const * slot = find_slot( key );
+      if ( slot == NULL || *slot == NULL )
+      {
+         return order_begin() + m_size;
+      }
+      return std::lower_bound( 
+         order_begin(), order_begin() + m_size, key, Key_less() );
+   }
+
+   /// @brief
+   /// Stores a key missing from the map.
+   value_type * insert_new( const Key & key, const Value & init = Value() )
+   {
+      // Keep the table at most half full
+      if ( 2 * ( m_size + 1 ) > m_slots.size() )
+      {
+         rehash( m_slots.empty() ? 2 * Chunk_count : 2 * m_slots.size() );
+      }
+
+      if ( m_size == m_chunks.size() * Chunk_count )
+      {
+         m_chunks.push_back( static_cast<value_type *>( 
+            ::operator new( Chunk_count * sizeof( value_type ) ) ) );
+      }
+      m_order.reserve( m_size + 1 );
+
+      value_type * value = 
+         m_chunks[m_size / Chunk_count] + m_size % Chunk_count;
+      new ( value ) value_type( key, init );
+      ++m_size;
+
+      *const_cast<value_type **>( find_slot( key ) ) = value;
+
+      // The keys mostly come in order, so the value is usually appended
+      m_order.insert( std::upper_bound( m_order.begin(), m_order.end(), 
+         key, Key_less() ), value );
+      return value;
+   }
+
+   /// @brief
+   /// Rebuilds the hash table with a number of slots.
+   ///
+   /// @param slot_count A power of two.
+   void rehash( size_type slot_count )
+   {
+      m_slots.assign( slot_count, NULL );
+      for ( size_type i = 0; i < m_size; ++i )
+      {
+         *const_cast<value_type **>( find_slot( m_order[i]->first ) ) = 
+            m_order[i];
+      }
+   }
+
+   /// @brief
+   /// Inserts copies of the values of another map, which is in key order.
+   void insert_all( const Dense_map & other )
+   {
+      for ( const_iterator value = other.begin(); 
+            value != other.end(); ++value )
+      {
+         insert_new( value->first, value->second );
+      }
+   }
+
+// PRIVATE MEMBERS
+
+   /// The chunks holding the values, in insertion order.
+   std::vector<value_type *> m_chunks;
+
+   /// The values in key order.
+   std::vector<value_type *> m_order;
+
+   /// The open-addressing hash table of the values, with linear probing.
+   std::vector<value_type *> m_slots;
+
+   /// The number of values.
+   size_type m_size;
+
+}; // End of class Dense_map
+
+#endif
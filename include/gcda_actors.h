@@ -44,6 +44,7 @@
 // SYSTEM INCLUDES
 
 #include <string>
+#include <vector>
 #include <iostream>
 
 #include <boost/version.hpp>
@@ -62,6 +63,7 @@
 
 #include "parser_builder.h"
 #include "record.h"
+#include "trace.h"
 
 // DATA DEFINITIONS
 
@@ -74,14 +76,14 @@ struct Parsing_data_gcda
     ///
     /// @param pd_ref Reference to data records.
     /// @param is_dump_ref Reference to dump flag.
-    /// @param dump_file_ref Reference to dump file output stream.
+    /// @param trace_ref Reference to the trace the dump is written to.
     Parsing_data_gcda( 
         Parser_builder & parser_builder_ref, 
         const bool is_dump_ref,
-        std::ofstream & dump_file_ref )
+        Trace_writer & trace_ref )
         : parser_builder( parser_builder_ref ), 
           is_dump( is_dump_ref ), 
-          dump_file( dump_file_ref )
+          trace( trace_ref )
     {
         // void
     }
@@ -97,6 +99,9 @@ struct Parsing_data_gcda
     uint64_t aCount;
     unsigned int aLength;
 
+    // Arc counts of the function, read as a single run
+    std::vector<uint64_t> counts;
+
     // Object Summary data
     unsigned int oChecksum;
     unsigned int oLength;
@@ -121,8 +126,8 @@ struct Parsing_data_gcda
     /// Determines if parser is dumping to data read to dump files.
     const bool is_dump;
    
-    /// The dump file output stream. 
-    std::ofstream & dump_file;
+    /// The trace the dump is written to.
+    Trace_writer & trace;
 
 }; // end of struct Parsing_data_gcda
 
@@ -141,8 +146,8 @@ struct gcda_action_gcdafile
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "Version: " << pd.version
-                         << " Stamp: "  << pd.stamp << "\n";
+            pd.trace.event( Trace_event::Gcda_file, first_ )
+                .number( pd.version ).number( pd.stamp );
         }
 #endif
     }
@@ -173,9 +178,9 @@ struct gcda_action_AnnounceFunction
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "rLength: " << pd.rLength
-                         << " rIdent: " << pd.rIdent
-                         << " rChecksum: " << pd.rChecksum << "\n";
+            pd.trace.event( Trace_event::Gcda_function, first_ )
+                .number( pd.rLength ).number( pd.rIdent )
+                .number( pd.rChecksum );
         }
 #endif
     }
@@ -208,7 +213,8 @@ struct gcda_action_aLength
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "   aLength: " << pd.aLength << "\n";
+            pd.trace.event( Trace_event::Gcda_arcs, first_ )
+                .number( pd.aLength );
         }
 #endif
     }
@@ -240,7 +246,8 @@ struct gcda_action_aCount
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "     aCount: " << pd.aCount << "\n";
+            pd.trace.event( Trace_event::Gcda_count, first_ )
+                .number( pd.aCount );
         }
 #endif
         // Store arc count
@@ -263,6 +270,48 @@ inline SPIRIT_NAMESPACE::ref_value_actor<Parsing_data_gcda, gcda_action_aCount>
                            gcda_action_aCount>(pd);
 }
 
+/// @brief
+/// Handles data storage / dump of the whole run of arc counts of a function
+struct gcda_action_Counts
+{
+    template<typename IteratorT>
+    void act(Parsing_data_gcda & pd, IteratorT const & first_,
+             IteratorT const & last_) const
+    {
+#ifdef DEBUGFLAG
+        if (pd.is_dump)
+        {
+            for (std::size_t i = 0; i < pd.counts.size(); ++i)
+            {
+                pd.trace.event( Trace_event::Gcda_count, first_ )
+                    .number( pd.counts[i] );
+            }
+        }
+#endif
+        // Store arc counts
+        if (!pd.counts.empty())
+        {
+            pd.parser_builder.store_counts( pd.rIdent, pd.rChecksum, 
+                &pd.counts[0], pd.counts.size() );
+        }
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns Functor to handle counts
+///
+/// @param pd Parsing Data of the grammar
+///
+/// @return ref_value_actor to perform functor
+///////////////////////////////////////////////////////////////////////////////
+inline SPIRIT_NAMESPACE::ref_value_actor<Parsing_data_gcda, gcda_action_Counts>
+       do_Counts(Parsing_data_gcda & pd)
+{
+    return SPIRIT_NAMESPACE::ref_value_actor<Parsing_data_gcda,
+                           gcda_action_Counts>(pd);
+}
+
 /// @brief
 /// Handles data storage / dump of Object Summary
 struct gcda_action_ObjectSummary
@@ -274,13 +323,11 @@ struct gcda_action_ObjectSummary
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << " oLength: " << pd.oLength << "\n"
-             << "   oChecksum: " << pd.oChecksum << "\n"
-             << "   oCounts: " << pd.oCounts << "\n"
-             << "   oRuns: " << pd.oRuns << "\n"
-             << "   oSumall: " << pd.oSumall << "\n"
-             << "   oRunmax: " << pd.oRunmax << "\n"
-             << "   oSummax: " << pd.oSummax << "\n";
+            pd.trace.event( Trace_event::Gcda_object_summary, first_ )
+                .number( pd.oLength ).number( pd.oChecksum )
+                .number( pd.oCounts ).number( pd.oRuns )
+                .number( pd.oSumall ).number( pd.oRunmax )
+                .number( pd.oSummax );
         }
 #endif
     }
@@ -313,13 +360,11 @@ struct gcda_action_ProgramSummary
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << " pLength: " << pd.pLength << "\n"
-               << "   pChecksum: " << pd.pChecksum << "\n"
-               << "   pCounts: " << pd.pCounts << "\n"
-               << "   pRuns: " << pd.pRuns << "\n"
-               << "   pSumall: " << pd.pSumall << "\n"
-               << "   pRunmax: " << pd.pRunmax << "\n"
-               << "   pSummax: " << pd.pSummax << "\n";
+            pd.trace.event( Trace_event::Gcda_program_summary, first_ )
+                .number( pd.pLength ).number( pd.pChecksum )
+                .number( pd.pCounts ).number( pd.pRuns )
+                .number( pd.pSumall ).number( pd.pRunmax )
+                .number( pd.pSummax );
         }
 #endif
     }
@@ -107,28 +107,28 @@ public:
 
             //  ALIAS DEFINITIONS
 
-            version   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.version, global_parsed_int32)];
-            stamp     = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.stamp, global_parsed_int32)];
-            rLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rLength, global_parsed_int32)];
-            rIdent    = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rIdent, global_parsed_int32)];
-            rChecksum = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rChecksum, global_parsed_int32)];
-            aCount    = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aCount, global_parsed_int64)];
-            aLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aLength, global_parsed_int32)]
+            version   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.version)];
+            stamp     = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.stamp)];
+            rLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rLength)];
+            rIdent    = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rIdent)];
+            rChecksum = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rChecksum)];
+            aCount    = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aCount)];
+            aLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aLength)]
                                  [phoenix::var(s.pd_ref.aLength) /= 2];
-            oChecksum = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oChecksum, global_parsed_int32)];
-            oLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oLength, global_parsed_int32)];
-            oCounts   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oCounts, global_parsed_int32)];
-            oRuns     = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oRuns, global_parsed_int32)];
-            oSumall   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oSumall, global_parsed_int64)];
-            oRunmax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oRunmax, global_parsed_int64)];
-            oSummax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oSummax, global_parsed_int64)];
-            pChecksum = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pChecksum, global_parsed_int32)];
-            pLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pLength, global_parsed_int32)];
-            pCounts   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pCounts, global_parsed_int32)];
-            pRuns     = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pRuns, global_parsed_int32)];
-            pSumall   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pSumall, global_parsed_int64)];
-            pRunmax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pRunmax, global_parsed_int64)];
-            pSummax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pSummax, global_parsed_int64)];
+            oChecksum = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oChecksum)];
+            oLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oLength)];
+            oCounts   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oCounts)];
+            oRuns     = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oRuns)];
+            oSumall   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oSumall)];
+            oRunmax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oRunmax)];
+            oSummax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.oSummax)];
+            pChecksum = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pChecksum)];
+            pLength   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pLength)];
+            pCounts   = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pCounts)];
+            pRuns     = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pRuns)];
+            pSumall   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pSumall)];
+            pRunmax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pRunmax)];
+            pSummax   = INT64 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.pSummax)];
 
             //  GRAMMAR RULE DEFINITIONS
 
@@ -226,8 +226,8 @@ public:
     /// @param records Reference to the map of records to be populated by the
     /// parse method.
     Gcda_grammar(Parser_builder & parser_builder, const bool is_dump,
-                 std::ofstream & dump_file) 
-        : parsing_data(parser_builder, is_dump, dump_file), pd_ref(parsing_data)
+                 Trace_writer & trace) 
+        : parsing_data(parser_builder, is_dump, trace), pd_ref(parsing_data)
     {
          // Do nothing 
     }
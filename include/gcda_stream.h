@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcda_stream.h
+///
+///  @brief
+///  Defines the Gcda_stream class.
+///
+///  @remarks
+///  A gcda stream carries the gcda data of many runs without writing them
+///  to files, such as the output of a fuzzing harness dumping its coverage
+///  to a pipe. Each payload is framed by a text line holding its size in
+///  bytes and the path of its gcda file, separated by a space, followed by
+///  the bytes of the gcda data:
+///
+///     <size> <gcda path>\n<size bytes of gcda data>
+///////////////////////////////////////////////////////////////////////////////
+#ifndef GCDA_STREAM_H
+#define GCDA_STREAM_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <istream>
+
+#include <boost/noncopyable.hpp>
+
+/// @brief
+/// Reads the framed gcda payloads of a stream one at a time.
+class Gcda_stream : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Reads payloads from the given stream, which must stay open while
+   /// the payloads are read.
+   ///
+   /// @param in The stream of framed payloads.
+   explicit Gcda_stream( std::istream & in );
+
+   /// @brief
+   /// Reads the next payload.
+   ///
+   /// @param path The gcda path of the payload.
+   /// @param payload The gcda data of the payload.
+   ///
+   /// @return read(true), end of the stream or malformed frame(false)
+   bool next( std::string & path, std::vector<char> & payload );
+
+   /// @brief
+   /// Returns if the stream ended within a frame or held a malformed one.
+   bool is_failed() const
+   {
+      return m_failed;
+   }
+
+private:
+
+// PRIVATE MEMBERS
+
+   /// The stream of framed payloads.
+   std::istream & m_in;
+
+   /// Set if the stream ended within a frame or held a malformed one.
+   bool m_failed;
+
+   /// The frame line being read.
+   std::string m_line;
+
+}; // End of class Gcda_stream
+
+#endif
@@ -63,6 +63,7 @@
 
 #include "parser_builder.h"
 #include "record.h"
+#include "trace.h"
 
 //  DATA DEFINITIONS
 
@@ -72,10 +73,10 @@ struct Parsing_data_gcno
     Parsing_data_gcno(
         Parser_builder & parser_builder_ref,
         const bool is_dump_ref, 
-        std::ofstream & dump_file_ref)
+        Trace_writer & trace_ref)
         : parser_builder(parser_builder_ref), 
           is_dump(is_dump_ref),
-          dump_file(dump_file_ref)
+          trace(trace_ref)
     {
         // void
     }
@@ -114,8 +115,8 @@ struct Parsing_data_gcno
     /// Determines if dump output should be created.
     const bool is_dump;
 
-    /// Dump file stream.
-    std::ofstream & dump_file;
+    /// The trace the dump is written to.
+    Trace_writer & trace;
 };
 
 //  GCNO GRAMMAR ACTIONS
@@ -131,8 +132,8 @@ struct gcno_action_gcnofile
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "Version: " << pd.version << "\n"
-                      << "Stamp:   " << pd.stamp   << "\n";
+            pd.trace.event( Trace_event::Gcno_file, first_ )
+                .number( pd.version ).number( pd.stamp );
         }
 #endif
     }
@@ -164,13 +165,10 @@ struct gcno_action_AnnounceFunction
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "AnnounceFunction: "
-                 << "rLength= " << pd.rLength
-                 << " rIdent= " << pd.rIdent
-                 << " rChecksum= " << pd.rChecksum << "\n";
-            pd.dump_file << "                  rName= " << pd.rName << std::endl
-                 << "                  rSource= " << pd.rSource << std::endl
-                 << "                  rLineno= " << pd.rLineno << std::endl;
+            pd.trace.event( Trace_event::Gcno_function, first )
+                .number( pd.rLength ).number( pd.rIdent )
+                .number( pd.rChecksum ).text( pd.rName ).text( pd.rSource )
+                .number( pd.rLineno );
         }
 #endif
         pd.parser_builder.store_record( pd.rIdent, pd.rChecksum, pd.rSource, 
@@ -202,7 +200,8 @@ struct gcno_action_BasicBlocks
 #ifdef DEBUGFLAG
         if ( pd.is_dump )
         {
-            pd.dump_file << "BasicBlocks:  bLength= " << pd.bLength << std::endl;
+            pd.trace.event( Trace_event::Gcno_blocks, first )
+                .number( pd.bLength );
         }
 #endif
     }
@@ -233,9 +232,9 @@ struct gcno_action_bFlags
 #ifdef DEBUGFLAG
         if ( pd.is_dump )
         {
-
-        pd.dump_file << "blocks=" << pd.blocks << "   bIteratin" << pd.bIteration <<  "   bFlags= " << pd.bFlags << std::endl;
-
+            pd.trace.event( Trace_event::Gcno_block, first )
+                .number( pd.blocks ).number( pd.bIteration )
+                .number( pd.bFlags );
         }
 #endif
         
@@ -268,8 +267,8 @@ struct gcno_action_Arcs
 #ifdef DEBUGFLAG
         if ( pd.is_dump )
         { 
-            pd.dump_file << "Arcs: aLength= " << pd.aLength << " aBlockno= "
-             << pd.aBlockno << std::endl;
+            pd.trace.event( Trace_event::Gcno_arcs, first )
+                .number( pd.aLength ).number( pd.aBlockno );
         }
 #endif
     }
@@ -300,8 +299,8 @@ struct gcno_action_Arc
 #ifdef DEBUGFLAG
         if ( pd.is_dump )
         {
-            pd.dump_file << "      destblock= " << pd.aDestBlock << " aFlags= "
-             << pd.aFlags << std::endl;
+            pd.trace.event( Trace_event::Gcno_arc, first )
+                .number( pd.aDestBlock ).number( pd.aFlags );
         }
 #endif
 
@@ -334,9 +333,8 @@ struct gcno_action_Lines
 #ifdef DEBUGFLAG
         if ( pd.is_dump )
         {
-            pd.dump_file << "  Lines:"
-                         << " lLength= " << pd.lLength
-                         << " lBlockno= " << pd.lBlockno << "\n";
+            pd.trace.event( Trace_event::Gcno_lines, first )
+                .number( pd.lLength ).number( pd.lBlockno );
         }
 #endif
     }
@@ -367,7 +365,8 @@ struct gcno_action_lName
 #ifdef DEBUGFLAG
         if ( pd.is_dump )
         {
-            pd.dump_file << "         lname= " << pd.lName << "\n";
+            pd.trace.event( Trace_event::Gcno_line_name, first )
+                .text( pd.lName );
         }
 #endif
     }
@@ -398,7 +397,8 @@ struct gcno_action_lLineno
 #ifdef DEBUGFLAG
         if (pd.is_dump)
         {
-            pd.dump_file << "         lLineno= " << pd.lLineno << "\n";
+            pd.trace.event( Trace_event::Gcno_line_number, first )
+                .number( pd.lLineno );
         }
 #endif
 
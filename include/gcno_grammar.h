@@ -108,27 +108,27 @@ public:
 
             //  ALIAS DEFINITIONS
 
-            version   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.version, global_parsed_int32)];
-            stamp     = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.stamp, global_parsed_int32)];
-            rLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rLength, global_parsed_int32)];
-            rIdent    = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rIdent, global_parsed_int32)];
-            rChecksum = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rChecksum, global_parsed_int32)];
-            rName     = STRING [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rName, global_parsed_string)];
-            rSource   = STRING [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rSource, global_parsed_string)];
-            rLineno   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rLineno, global_parsed_int32)];
-            bLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.bLength, global_parsed_int32)]
-                                   [SPIRIT_NAMESPACE::assign_a(s.pd_ref.blocks, global_parsed_int32)]
+            version   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.version)];
+            stamp     = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.stamp)];
+            rLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rLength)];
+            rIdent    = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rIdent)];
+            rChecksum = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rChecksum)];
+            rName     = STRING [assign_string_a(s.pd_ref.rName)];
+            rSource   = STRING [assign_string_a(s.pd_ref.rSource)];
+            rLineno   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.rLineno)];
+            bLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.bLength)]
+                                   [SPIRIT_NAMESPACE::assign_a(s.pd_ref.blocks)]
                                    [phoenix::var(s.pd_ref.blocks) -= 1];
-            bFlags    = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.bFlags, global_parsed_int32)];
-            aLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aLength, global_parsed_int32)]
+            bFlags    = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.bFlags)];
+            aLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aLength)]
                                    [phoenix::var(s.pd_ref.aLength) /= 2];
-            aBlockno  = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aBlockno, global_parsed_int32)];
-            aDestBlock = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aDestBlock, global_parsed_int32)];
-            aFlags    = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aFlags, global_parsed_int32)];
-            lLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.lLength, global_parsed_int32)];
-            lBlockno  = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.lBlockno, global_parsed_int32)];
-            lLineno   = NONZERO[SPIRIT_NAMESPACE::assign_a(s.pd_ref.lLineno, global_parsed_int32)];
-            lName     = STRING [SPIRIT_NAMESPACE::assign_a(s.pd_ref.lName, global_parsed_string)];
+            aBlockno  = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aBlockno)];
+            aDestBlock = INT32 [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aDestBlock)];
+            aFlags    = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.aFlags)];
+            lLength   = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.lLength)];
+            lBlockno  = INT32  [SPIRIT_NAMESPACE::assign_a(s.pd_ref.lBlockno)];
+            lLineno   = NONZERO[SPIRIT_NAMESPACE::assign_a(s.pd_ref.lLineno)];
+            lName     = STRING [assign_string_a(s.pd_ref.lName)];
 
             //  GRAMMAR RULE DEFINITIONS
 
@@ -240,8 +240,8 @@ public:
     /// @param records Reference to records map that will be populated by
     /// the parse method.
     Gcno_grammar(Parser_builder & parser_builder, 
-    const bool is_dump_ref, std::ofstream & dump_file_ref) 
-    : parsing_data(parser_builder, is_dump_ref, dump_file_ref), pd_ref(parsing_data)
+    const bool is_dump_ref, Trace_writer & trace_ref) 
+    : parsing_data(parser_builder, is_dump_ref, trace_ref), pd_ref(parsing_data)
     {
         // Initialize error messages
         error_msg_tag_blocks   =
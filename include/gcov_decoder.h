@@ -0,0 +1,364 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcov_decoder.h
+///
+///  @brief
+///  Defines the Gcov_decoder class.
+///
+///  @remarks
+///  The decoder walks the length prefixed records of a gcno or gcda buffer
+///  directly and hands each field to the same actors used by the Spirit
+///  grammars, so the Parser_builder and dump output see identical data.
+///  Records are framed by their length, so unknown tags, the bodies of
+///  unselected or already known functions and summaries that are not
+///  dumped are skipped without being read. The grammars remain available
+///  through the --spirit-parser option, for the gcc 3.4 to 4.6 layout only.
+///
+///  The record layout changed over the gcc releases. The version word of a
+///  file selects one of the Gcov_layout traits below, and the record loops
+///  are instantiated once per layout, so the fields of a layout are fixed at
+///  compile time rather than tested for each record.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef GCOV_DECODER_H
+#define GCOV_DECODER_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <inttypes.h>
+
+#include <boost/noncopyable.hpp>
+
+// LOCAL INCLUDES
+
+#include "byte_order.h"
+#include "parser_builder.h"
+#include "prims.h"
+#include "gcno_actors.h"
+#include "gcda_actors.h"
+
+/// @brief
+/// The layout written by gcc 3.4 to 4.6.
+struct Gcov_layout_3_4
+{
+   /// Functions carry a cfg checksum after their line checksum.
+   static const bool Cfg_checksum = false;
+   /// Functions carry an artificial flag and their start and end positions.
+   static const bool Function_extents = false;
+   /// TAG_BLOCKS holds the number of blocks instead of the flags of each.
+   static const bool Block_count = false;
+   /// The gcno header ends with the has_unexecuted_blocks flag.
+   static const bool Unexecuted_flag = false;
+   /// The gcno header holds the working directory of the compilation.
+   static const bool Header_cwd = false;
+   /// Both headers hold a checksum after the stamp.
+   static const bool Header_checksum = false;
+   /// Record and string lengths count bytes rather than int32 words, and
+   /// strings are not padded.
+   static const bool Byte_lengths = false;
+   /// A negative counter length stands for a run of zero counters.
+   static const bool Zero_counters = false;
+   /// The summaries hold checksum, counts, runs, sum, max and sum max.
+   static const bool Count_summaries = true;
+};
+
+/// @brief
+/// The layout written by gcc 4.7 to 7.
+struct Gcov_layout_4_7 : Gcov_layout_3_4
+{
+   static const bool Cfg_checksum = true;
+};
+
+/// @brief
+/// The layout written by gcc 8.
+struct Gcov_layout_8 : Gcov_layout_4_7
+{
+   static const bool Function_extents = true;
+   static const bool Block_count = true;
+   static const bool Unexecuted_flag = true;
+};
+
+/// @brief
+/// The layout written by gcc 9 to 11.
+struct Gcov_layout_9 : Gcov_layout_8
+{
+   static const bool Header_cwd = true;
+   static const bool Count_summaries = false;
+};
+
+/// @brief
+/// The layout written by gcc 12 and later.
+struct Gcov_layout_12 : Gcov_layout_9
+{
+   static const bool Header_checksum = true;
+   static const bool Byte_lengths = true;
+   static const bool Zero_counters = true;
+};
+
+/// @brief
+/// Decodes gcno and gcda buffers record by record into a Parser_builder.
+class Gcov_decoder : boost::noncopyable
+{
+public:
+
+// PUBLIC CONSTANTS
+
+   /// Magic number of a gcno file.
+   static const unsigned int Gcno_magic = 0x67636E6F;
+   /// Magic number of a gcda file.
+   static const unsigned int Gcda_magic = 0x67636461;
+
+   /// Tag announcing a function in both gcno and gcda files.
+   static const unsigned int Tag_function = 0x01000000;
+   /// Tag of the basic block flags of a function.
+   static const unsigned int Tag_blocks = 0x01410000;
+   /// Tag of the outgoing arcs of a basic block.
+   static const unsigned int Tag_arcs = 0x01430000;
+   /// Tag of the line numbers of a basic block.
+   static const unsigned int Tag_lines = 0x01450000;
+   /// Tag of the arc counters of a function.
+   static const unsigned int Tag_counter_base = 0x01A10000;
+   /// Tag of the object summary.
+   static const unsigned int Tag_object_summary = 0xA1000000;
+   /// Tag of a program summary.
+   static const unsigned int Tag_program_summary = 0xA3000000;
+
+   /// Most basic blocks a function may have. A larger count is taken as a
+   /// corrupt file rather than allocated.
+   static const unsigned int Max_blocks = 1 << 20;
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes the decoder with the builder receiving the parsed data.
+   ///
+   /// @param parser_builder The builder of the data structure.
+   /// @param is_dump Determines if dump output should be created.
+   /// @param trace The trace the dump is written to.
+   Gcov_decoder(
+      Parser_builder & parser_builder,
+      const bool is_dump,
+      Trace_writer & trace );
+
+   /// @brief
+   /// Decodes a whole gcno file.
+   ///
+   /// @param first The beginning of the gcno buffer.
+   /// @param last The end of the gcno buffer.
+   /// @param little_endian If the file does not need its bytes reversed.
+   ///
+   /// @return success(true), failure(false)
+   bool decode_gcno(
+      const char * first,
+      const char * last,
+      const bool little_endian );
+
+   /// @brief
+   /// Decodes a whole gcda file.
+   ///
+   /// @param first The beginning of the gcda buffer.
+   /// @param last The end of the gcda buffer.
+   /// @param little_endian If the file does not need its bytes reversed.
+   ///
+   /// @return success(true), failure(false)
+   bool decode_gcda(
+      const char * first,
+      const char * last,
+      const bool little_endian );
+
+   /// @brief
+   /// Returns the gcc release that wrote a file, as major * 100 + minor.
+   ///
+   /// @param version The version word of the file, such as "403*" for gcc
+   /// 4.3 or "B22*" for gcc 12.2.
+   static unsigned int get_gcc_release( unsigned int version );
+
+private:
+
+// PRIVATE TYPES
+
+   /// The layouts, named after the gcc release that introduced them.
+   enum Layout
+   {
+      Layout_3_4,
+      Layout_4_7,
+      Layout_8,
+      Layout_9,
+      Layout_12
+   };
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Returns the layout of the files of a version word.
+   static Layout get_layout( unsigned int version );
+
+   /// @brief
+   /// Positions the decoder at the start of a buffer.
+   void reset( const char * first, const char * last, const bool little_endian );
+
+   /// @brief
+   /// Returns the number of whole int32 words left before the record end.
+   std::size_t words_left() const
+   {
+      return ( m_record_end - m_pos ) / int32_size;
+   }
+
+   /// @brief
+   /// Reads the next int32. The caller must have checked words_left().
+   unsigned int next_int32()
+   {
+      unsigned int value;
+      std::memcpy( &value, m_pos, int32_size );
+      m_pos += int32_size;
+
+      if ( ! m_little_endian )
+      {
+         value = swap_int32( value );
+      }
+      return value;
+   }
+
+   /// @brief
+   /// Reads the next int64 stored as a low and a high int32. The caller
+   /// must have checked words_left().
+   uint64_t next_int64()
+   {
+      uint64_t low = next_int32();
+      uint64_t high = next_int32();
+
+      return low | ( high << int32_size * 8 );
+   }
+
+   /// @brief
+   /// Reads an int32 if one is left in the current record.
+   bool read_int32( unsigned int & value );
+
+   /// @brief
+   /// Reads an int64 if one is left in the current record.
+   bool read_int64( uint64_t & value );
+
+   /// @brief
+   /// Reads a length prefixed, null terminated string.
+   template <typename LayoutT>
+   bool read_string( std::string & value );
+
+   /// @brief
+   /// Reads the characters of a string whose length was already read.
+   template <typename LayoutT>
+   bool read_string_data( unsigned int length, std::string & value );
+
+   /// @brief
+   /// Reads the tag and length of the next record and bounds the record.
+   /// The length is returned in int32 words whatever the layout.
+   template <typename LayoutT>
+   bool read_header( unsigned int & tag, unsigned int & length );
+
+   /// Decodes the gcno header fields after the stamp and the records.
+   template <typename LayoutT>
+   bool decode_gcno_records();
+   /// Decodes the gcda header fields after the stamp and the records.
+   template <typename LayoutT>
+   bool decode_gcda_records();
+
+   /// @brief
+   /// Returns if the blocks, arcs and lines of the current gcno function
+   /// must be decoded. Those of unselected functions and of functions
+   /// whose structure is already known are only dumped.
+   bool wants_function_body() const
+   {
+      return m_gcno_data.is_dump || 
+         m_gcno_data.parser_builder.wants_last_structure();
+   }
+
+   /// @brief
+   /// Returns if the lines of the current gcno function must be decoded.
+   /// Commands that never print lines do not store them.
+   bool wants_function_lines() const
+   {
+      return m_gcno_data.is_dump || 
+         m_gcno_data.parser_builder.wants_last_lines();
+   }
+
+   /// @brief
+   /// Returns if the counters of the current gcda function must be decoded.
+   bool wants_counters() const
+   {
+      return m_gcda_data.is_dump || 
+         m_gcda_data.parser_builder.is_record_selected( 
+            m_gcda_data.rIdent, m_gcda_data.rChecksum );
+   }
+
+   /// Decodes the body of a gcno TAG_FUNCTION record.
+   template <typename LayoutT>
+   bool decode_gcno_function( unsigned int length );
+   /// Decodes the body of a gcno TAG_BLOCKS record.
+   template <typename LayoutT>
+   bool decode_blocks( unsigned int length );
+   /// Decodes the body of a gcno TAG_ARCS record.
+   bool decode_arcs( unsigned int length );
+   /// Decodes the body of a gcno TAG_LINES record.
+   template <typename LayoutT>
+   bool decode_lines( unsigned int length );
+
+   /// Decodes the body of a gcda TAG_FUNCTION record.
+   template <typename LayoutT>
+   bool decode_gcda_function( unsigned int length );
+   /// Decodes the body of a gcda TAG_COUNTER_BASE record.
+   bool decode_counters( unsigned int length );
+   /// Decodes the body of the gcda object summary record.
+   bool decode_object_summary( unsigned int length );
+   /// Decodes the body of a gcda program summary record.
+   bool decode_program_summary( unsigned int length );
+
+// PRIVATE MEMBERS
+
+   /// The fields of the gcno file, shared with the gcno actors.
+   Parsing_data_gcno m_gcno_data;
+
+   /// The fields of the gcda file, shared with the gcda actors.
+   Parsing_data_gcda m_gcda_data;
+
+   /// The current read position.
+   const char * m_pos;
+
+   /// The end of the record being decoded.
+   const char * m_record_end;
+
+   /// The end of the buffer being decoded.
+   const char * m_last;
+
+   /// If the file does not need its bytes reversed.
+   bool m_little_endian;
+
+   /// Set if the current counter record stands for a run of zero counters
+   /// and holds no payload.
+   bool m_zero_counters;
+
+}; // End of class Gcov_decoder
+
+#endif
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcov_json_decoder.h
+///
+///  @brief
+///  Defines the Gcov_json_decoder class.
+///
+///  @remarks
+///  gcov --json-format writes, for each source file of an object, the
+///  functions with their execution counts and the lines with their counts
+///  and branches. It holds no control flow graph, so the decoder builds a
+///  graph per function that carries those counts through the Parser_builder
+///  exactly as a gcno and gcda pair would:
+///
+///  - Block 0 enters the function, and the last block exits it.
+///  - Each line is a block whose count is the line count. A line with two
+///    or more branches gets one target block per branch, holding the line,
+///    and the arcs to the targets are the branches.
+///  - A line, or each of its branch targets, has one arc to the next line
+///    carrying its own count, so the blocks are colored by their counts.
+///    A fake block after the lines makes up the difference between the
+///    counts reaching a line and the line count through fake arcs, which
+///    are neither branches nor shown, and may have negative counts.
+///
+///  The shape of the graph only depends on the lines and branches of the
+///  function, and its checksum is computed from them, so the counts of the
+///  same function in several JSON files are added up as gcda counts are.
+///
+///  The JSON text is read SAX style: only the functions and lines of the
+///  source file being read are kept, and they are handed to the builder as
+///  soon as the source file ends.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef GCOV_JSON_DECODER_H
+#define GCOV_JSON_DECODER_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <inttypes.h>
+
+#include <boost/noncopyable.hpp>
+
+// LOCAL INCLUDES
+
+#include "json_reader.h"
+#include "parser_builder.h"
+
+/// @brief
+/// Decodes the gcov JSON intermediate format into a Parser_builder.
+class Gcov_json_decoder : public Json_handler, boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes the decoder with the builder receiving the parsed data.
+   ///
+   /// @param parser_builder The builder of the data structure.
+   explicit Gcov_json_decoder( Parser_builder & parser_builder );
+
+   /// @brief
+   /// Decodes a whole JSON text.
+   ///
+   /// @param in The stream of the text, already decompressed.
+   ///
+   /// @return success(true), failure(false)
+   bool decode( std::istream & in );
+
+   /// @brief
+   /// Decodes a gcov JSON file, decompressing it if its name ends with
+   /// ".gz".
+   ///
+   /// @param path The path of the file.
+   ///
+   /// @return success(true), failure(false)
+   bool decode_file( const std::string & path );
+
+   // The Json_handler events.
+   virtual bool start_object();
+   virtual bool end_object();
+   virtual bool start_array();
+   virtual bool end_array();
+   virtual bool key( const std::string & name );
+   virtual bool string_value( const std::string & value );
+   virtual bool number_value( const std::string & text );
+   virtual bool bool_value( bool value );
+   virtual bool null_value();
+
+private:
+
+// PRIVATE TYPES
+
+   /// The JSON values the decoder is within.
+   enum Context
+   {
+      /// The top level object.
+      Root,
+      /// The array of the source files.
+      Files,
+      /// The object of a source file.
+      File,
+      /// The array of the functions of a source file.
+      Functions,
+      /// The object of a function.
+      Function,
+      /// The array of the lines of a source file.
+      Lines,
+      /// The object of a line.
+      Line,
+      /// The array of the branches of a line.
+      Branches,
+      /// The object of a branch.
+      Branch,
+      /// A value the decoder does not use.
+      Ignored
+   };
+
+   /// A branch of a line. Throws are branches too, as the exception arcs
+   /// of a gcno file are not fake.
+   struct Json_branch
+   {
+      uint64_t m_count;
+      bool m_fallthrough;
+   };
+
+   /// A line of a source file.
+   struct Json_line
+   {
+      unsigned int m_line_number;
+      uint64_t m_count;
+      /// The mangled name of the function of the line, which gcc 9 does
+      /// not write.
+      std::string m_function_name;
+      std::vector<Json_branch> m_branches;
+   };
+
+   /// A function of a source file.
+   struct Json_function
+   {
+      std::string m_name;
+      unsigned int m_start_line;
+      unsigned int m_end_line;
+      uint64_t m_execution_count;
+   };
+
+   /// An arc of the graph built for a function.
+   struct Graph_arc
+   {
+      unsigned int m_dest;
+      unsigned int m_flags;
+      uint64_t m_count;
+   };
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Enters a container, from the context and the key it is the value of.
+   ///
+   /// @param is_object If the container is an object.
+   void enter( bool is_object );
+
+   /// @brief
+   /// Stores the functions and lines of the source file just read.
+   void store_file();
+
+   /// @brief
+   /// Builds the graph of a function from its lines and stores it.
+   ///
+   /// @param function The function.
+   /// @param lines The lines of the function, sorted by number.
+   void store_function( 
+      const Json_function & function,
+      const std::vector<const Json_line *> & lines );
+
+   /// @brief
+   /// Converts the text of a number to an unsigned count. Negative and
+   /// fractional numbers, which gcov does not write for counts, become 0
+   /// and their integer part.
+   static uint64_t to_count( const std::string & text );
+
+// PRIVATE MEMBERS
+
+   /// The builder of the data structure.
+   Parser_builder & m_parser_builder;
+
+   /// The contexts of the values being read, innermost last.
+   std::vector<Context> m_contexts;
+
+   /// The key of the member being read.
+   std::string m_key;
+
+   /// The name of the source file being read.
+   std::string m_file;
+
+   /// The functions of the source file being read.
+   std::vector<Json_function> m_functions;
+
+   /// The lines of the source file being read.
+   std::vector<Json_line> m_lines;
+
+}; // End of class Gcov_json_decoder
+
+#endif
@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file json_reader.h
+///
+///  @brief
+///  Defines the Json_reader class and its Json_handler.
+///
+///  @remarks
+///  The reader walks a JSON text one character at a time and reports each
+///  value to a handler as it is read, SAX style. Nothing but the key or
+///  scalar being read and the nesting of the containers is kept, so texts
+///  far larger than the memory, such as the decompressed gcov JSON output
+///  of a large project, are read in a single pass of bounded size.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+
+/// @brief
+/// Receives the values of a JSON text in the order they are read. Each
+/// method returns false to stop the reading.
+class Json_handler
+{
+public:
+
+// PUBLIC METHODS
+
+   virtual ~Json_handler()
+   {
+      // void
+   }
+
+   /// Called on the '{' opening an object.
+   virtual bool start_object() = 0;
+   /// Called on the '}' closing an object.
+   virtual bool end_object() = 0;
+   /// Called on the '[' opening an array.
+   virtual bool start_array() = 0;
+   /// Called on the ']' closing an array.
+   virtual bool end_array() = 0;
+
+   /// @brief
+   /// Called on the key of the next member of an object.
+   ///
+   /// @param name The unescaped key.
+   virtual bool key( const std::string & name ) = 0;
+
+   /// @brief
+   /// Called on a string value.
+   ///
+   /// @param value The unescaped string.
+   virtual bool string_value( const std::string & value ) = 0;
+
+   /// @brief
+   /// Called on a number value.
+   ///
+   /// @param text The number as written, which the handler converts to the
+   /// type it needs.
+   virtual bool number_value( const std::string & text ) = 0;
+
+   /// @brief
+   /// Called on a true or false value.
+   virtual bool bool_value( bool value ) = 0;
+
+   /// Called on a null value.
+   virtual bool null_value() = 0;
+
+}; // End of class Json_handler
+
+/// @brief
+/// Reads a JSON text from a stream into a Json_handler.
+class Json_reader : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Reads the text of the given stream, which must stay open while it is
+   /// read.
+   ///
+   /// @param in The stream of the JSON text.
+   explicit Json_reader( std::istream & in );
+
+   /// @brief
+   /// Reads the whole text, a single value, into the handler.
+   ///
+   /// @param handler The handler of the values.
+   ///
+   /// @return success(true), malformed text or stopped by the
+   /// handler(false)
+   bool read( Json_handler & handler );
+
+   /// @brief
+   /// Returns the number of characters read so far, which locates the
+   /// error after a failed read.
+   std::size_t get_offset() const
+   {
+      return m_offset;
+   }
+
+private:
+
+// PRIVATE TYPES
+
+   /// What the next token of the text may be.
+   enum Expect
+   {
+      /// A value.
+      Value,
+      /// A value or the end of the array just opened.
+      First_value,
+      /// The key of a member.
+      Key,
+      /// A key or the end of the object just opened.
+      First_key,
+      /// The colon after a key.
+      Colon,
+      /// A comma or the end of the enclosing container.
+      Separator,
+      /// Nothing, the value of the text was read.
+      Done
+   };
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Reads the next character.
+   ///
+   /// @return read(true), end of the stream(false)
+   bool next( char & c )
+   {
+      if ( m_pos == m_end && ! fill() )
+      {
+         return false;
+      }
+      c = *m_pos++;
+      ++m_offset;
+      return true;
+   }
+
+   /// @brief
+   /// Returns the next character without reading it, or '\0' at the end of
+   /// the stream.
+   char peek()
+   {
+      if ( m_pos == m_end && ! fill() )
+      {
+         return '\0';
+      }
+      return *m_pos;
+   }
+
+   /// @brief
+   /// Reads the next chunk of the stream into the buffer.
+   bool fill();
+
+   /// @brief
+   /// Reads the next character that is not white space.
+   bool next_token( char & c );
+
+   /// @brief
+   /// Reads a string whose opening quote was read into m_text.
+   bool read_string();
+
+   /// @brief
+   /// Reads the four hex digits of a \u escape.
+   bool read_hex( unsigned int & value );
+
+   /// @brief
+   /// Reads a number whose first character was read into m_text.
+   bool read_number( char first );
+
+   /// @brief
+   /// Reads the rest of the literal whose first character was read.
+   bool read_literal( const char * rest );
+
+   /// @brief
+   /// Reads the value starting with the given character.
+   bool read_value( char c, Json_handler & handler );
+
+   /// @brief
+   /// Returns what follows a value in the current container.
+   Expect after_value() const
+   {
+      return m_containers.empty() ? Done : Separator;
+   }
+
+// PRIVATE MEMBERS
+
+   /// The stream of the text.
+   std::istream & m_in;
+
+   /// The chunk of the stream being read.
+   std::vector<char> m_buffer;
+
+   /// The next character of the chunk.
+   const char * m_pos;
+
+   /// The end of the chunk.
+   const char * m_end;
+
+   /// The number of characters read so far.
+   std::size_t m_offset;
+
+   /// The opening character of each container being read, innermost last.
+   std::vector<char> m_containers;
+
+   /// What the next token may be.
+   Expect m_expect;
+
+   /// The key or scalar being read.
+   std::string m_text;
+
+}; // End of class Json_reader
+
+#endif
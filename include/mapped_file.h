@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file mapped_file.h
+///
+///  @brief
+///  Defines the Mapped_file class.
+///
+///  @remarks
+///  Maps a whole input file into memory so it can be parsed in place. Files
+///  that cannot be mapped, such as pipes or files on some network
+///  filesystems, are read into a buffer instead.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+
+/// @brief
+/// A read only view of the whole contents of a file.
+class Mapped_file : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Maps the file, or reads it if it cannot be mapped.
+   ///
+   /// @param path The path of the file.
+   explicit Mapped_file( const std::string & path );
+
+   /// @brief
+   /// Unmaps the file.
+   ~Mapped_file();
+
+   /// @brief
+   /// Asks the kernel to start reading a file into the page cache, so a
+   /// later Mapped_file of it does not wait on the disk or the network.
+   /// Returns at once; the reads complete in the background.
+   ///
+   /// @param path The path of the file.
+   static void prefetch( const std::string & path );
+
+   /// @brief
+   /// Returns if the file could be opened and read.
+   bool is_open() const
+   {
+      return m_open;
+   }
+
+   /// @brief
+   /// Returns if the contents are mapped rather than read into a buffer.
+   bool is_mapped() const
+   {
+      return m_mapped;
+   }
+
+   /// @brief
+   /// Returns the first byte of the contents.
+   const char * begin() const
+   {
+      return m_data;
+   }
+
+   /// @brief
+   /// Returns one past the last byte of the contents.
+   const char * end() const
+   {
+      return m_data + m_size;
+   }
+
+   /// @brief
+   /// Returns the number of bytes of the contents.
+   std::size_t size() const
+   {
+      return m_size;
+   }
+
+private:
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Reads the file into m_buffer until its end.
+   ///
+   /// @return success(true), failure(false)
+   bool read_all( int fd );
+
+// PRIVATE MEMBERS
+
+   /// The first byte of the contents.
+   const char * m_data;
+
+   /// The number of bytes of the contents.
+   std::size_t m_size;
+
+   /// Set if the file could be opened and read.
+   bool m_open;
+
+   /// Set if m_data is a mapping rather than m_buffer.
+   bool m_mapped;
+
+   /// The contents of a file that could not be mapped.
+   std::vector<char> m_buffer;
+
+}; // End of class Mapped_file
+
+#endif
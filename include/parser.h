@@ -54,6 +54,7 @@
 // PROJECT INCLUDES
 
 #include <boost/version.hpp>
+#include <boost/shared_ptr.hpp>
 
 #if BOOST_VERSION < NEW_SPIRIT_VERSION
    #include <boost/spirit/core.hpp>
@@ -68,6 +69,9 @@
 // LOCAL INCLUDES
 
 #include "parser_builder.h"
+#include "project_context.h"
+#include "gcov_decoder.h"
+#include "trace.h"
 #include "gcno_grammar.h"
 #include "gcda_grammar.h"
 #include "record.h"
@@ -129,18 +133,11 @@ public:
    Parser(const char * gcnoFile, const char * gcdaFile);
 
    ///////////////////////////////////////////////////////////////////////////
+   ///  @brief
+   ///  Parses one gcno and gcda pair straight into the source files.
    ///
-   ///  @return success(0), failure(-1)
-   ///
-   ///  @remarks
-   ///  Parses the entire input file
-   ///  Pre  : infile points to a valid input file stream
-   ///  Post : Parse Tree is constructed and all data on the program and test
-   ///         coverage has been gathered/calculated.
-   ///  Throw: IOException
-   ////////////////////////////////////////////////////////////////////////////
-   int parse();
-
+   ///  @return success(0), failure(1)
+   ///////////////////////////////////////////////////////////////////////////
    int parse(
        const std::string & gcnoFile, 
        const std::string & gcdaFile,
@@ -150,16 +147,26 @@ public:
        const std::string & gcnoFile, 
        const std::string & gcdaFile );
 
-   bool parse_all(); 
+   ///////////////////////////////////////////////////////////////////////////
+   ///  @brief
+   ///  Parses every gcno and gcda pair of the build directories, on as many
+   ///  threads as the jobs option asks for, and normalizes the results.
+   ///
+   ///  @param with_lines Decodes and normalizes the line numbers of the
+   ///  blocks. Commands that never print lines pass false.
+   ///
+   ///  @return success(true), failure(false)
+   ///////////////////////////////////////////////////////////////////////////
+   bool parse_all( bool with_lines = true ); 
 
    double get_coverage_percentage() const
    {
       return m_coverage_percentage;
    }
 
-   std::map<std::string, Source_file> & get_source_files();
+   Source_file_map & get_source_files();
 
-   std::map<unsigned int, Record> & get_records();
+   Source_file::Record_map & get_records();
 
    // PUBLIC VARAIBLES
 
@@ -170,9 +177,9 @@ public:
 
    bool gui_dump( std::ofstream & out )
    {
-      std::map<std::string, Source_file> & sources = get_source_files(); 
+      Source_file_map & sources = get_source_files(); 
 
-      for ( std::map<std::string, Source_file>::iterator it_src = sources.begin();
+      for ( Source_file_map::iterator it_src = sources.begin();
          it_src != sources.end();
          ++it_src )
       {
@@ -180,12 +187,12 @@ public:
              << it_src->second.m_coverage_percentage * 100 << "%\n";
 
 
-         std::map<unsigned int, Record> & records = it_src->second.m_records;
-         for ( std::map<unsigned int, Record>::iterator it_rec = records.begin();
+         Source_file::Record_map & records = it_src->second.m_records;
+         for ( Source_file::Record_map::iterator it_rec = records.begin();
             it_rec != records.end();
             ++it_rec )
          {
-            out  << it_rec->second.m_name_demangled << "\n" 
+            out  << it_rec->second.get_name_demangled() << "\n" 
                  << it_rec->second.m_report_path << "\n"
                  << it_rec->second.m_graph_path << "\n"
                  << it_rec->second.m_line_num << "\n";
@@ -212,6 +219,27 @@ public:
 
 private:
 
+   // PRIVATE TYPES
+
+   /// The configuration read by the parsing threads.
+   struct Parse_settings
+   {
+      /// The project context shared by the parser builders.
+      boost::shared_ptr<const Project_context> m_project;
+      /// Parse with the Spirit grammars instead of the record decoder.
+      bool m_use_grammar;
+      /// Decode the line numbers of the blocks.
+      bool m_with_lines;
+      /// The structures shared by the pairs of a batch, or NULL.
+      Known_structures * m_known_structures;
+   };
+
+   /// Parses the pairs of the build list and stages their results.
+   class Parse_batch;
+
+   /// Adds up the gcda payloads streamed for one object.
+   class Stream_object;
+
    // PRIVATE METHODS
 
    /// @brief
@@ -244,7 +272,32 @@ private:
       return *this;
    }
 
-   /// Populate each Block's m_from_arcs with incoming Arc pointers
+   /// Reads the parse settings from the configuration.
+   static Parse_settings get_parse_settings();
+   /// Parses a gcno and gcda pair into the given source files; reentrant.
+   static int parse_pair( const std::string & gcnoFile,
+      const std::string & gcdaFile, const std::string & dumpFile,
+      const Parse_settings & settings,
+      Source_file_map & source_files, std::ostream & log );
+   /// Parses the contents of a gcno and gcda pair; reentrant.
+   static int parse_buffers( const std::string & gcnoFile,
+      const char * gcno_first, const char * gcno_last,
+      const std::string & gcdaFile,
+      const char * gcda_first, const char * gcda_last,
+      const std::string & dumpFile, const Parse_settings & settings,
+      Source_file_map & source_files, std::ostream & log );
+   /// Parses the pairs of the build list into m_source_files.
+   bool parse_pairs( const Parse_settings & settings );
+   /// Parses the gcda payloads of a stream into m_source_files.
+   bool parse_gcda_stream( const std::string & stream_path,
+      const Parse_settings & settings );
+   /// Parses the gcov json files of the build list into m_source_files.
+   bool parse_gcov_json( const Parse_settings & settings );
+   /// Merges the source files parsed from one pair into m_source_files.
+   void merge_source_files( Source_file_map & parsed );
+   /// Gives records parsed without a graph the graph of a failed pair.
+   void fill_known_structures( const Known_structures & known );
+   /// Build each Record's flow graph of its outgoing and incoming Arcs
    void assign_entry_arcs();
    /// Assign each counted Arc a value
    void assign_arc_counts();
@@ -254,39 +307,33 @@ private:
    void normalize_lines();
    /// Calculate whether each block is fake
    void normalize_fake_blocks();
-   /// Populate m_blocks_sorted with Blocks sorted by line #
+   /// Populate m_block_order with the blocks sorted by line #
    void sort_blocks();
    /// Calculates the total coverage for each source and the entire project.
    void calculate_total_coverage(); 
    /// Create a vector with the first source line of each function within
    /// a source file
    void order_by_line( std::vector<unsigned> & first_line,
-      const std::map<Source_file::Source_key, Record> & records );
+      const Source_file::Record_map & records );
    /// Find the last source line of a record
    int find_last_line( const std::vector<unsigned> & first_line,
       const Record & rec );
    /// Mark a line number as inlined if it meets certain criteria
-   void assign_inline_status( Lines_data & line_data, const std::string & source,
+   void assign_inline_status( Line * lines, unsigned size, String_id source,
       Record & rec, const unsigned last_line );
    /// Get a line from the current source file
-   void assign_line_current( Lines_data & line_data, Record & rec,
+   void assign_line_current( Line_range lines, Record & rec,
       unsigned block_no );
    /// Get a line from an outside source file
-   void assign_line_inlined( std::map<std::string, Lines_data> & lines, Record & rec, unsigned block_no );
+   void assign_line_inlined( unsigned origin_block, Record & rec,
+      unsigned block_no );
 
    // PRIVATE VARAIBLES
 
-   std::ifstream    mGcnoFile;                 // Gcno file stream
-   std::ifstream    mGcdaFile;                 // Gcda file stream
-   std::ofstream    mDumpFile;
-   bool        mIsDump;
    std::string      mMagic;                    // Magic
    std::string      mVersion;                  // Version of the input file
    std::string      mStamp;                    // Stamp of the file
 
-   std::string      m_gcno_name;
-   std::string      m_gcda_name;
-
    bool        mIsGCNO;
    bool        mIsLittleEndian;
 
@@ -295,14 +342,11 @@ private:
    /// Pointer to the singleton instance of Dot_creator.
    static Parser * ptr_instance;
    /// Map of all source files within the project
-   std::map<std::string, Source_file> m_source_files;
+   Source_file_map m_source_files;
 
 }; // end of class Parse
 
 /// Compares the last line numbers of two blocks to determine order
 const bool compare_line_nums( const Block & lhs, const Block & rhs );
 
-/// Compares two Line structs to determine order
-const bool compare_lines( const Line & lhs, const Line & rhs );
-
 #endif
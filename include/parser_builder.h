@@ -34,16 +34,77 @@
 
 #include <string>
 #include <map>
+#include <utility>
+#include <cstddef>
 
 #include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 // LOCAL INCLUDES
 
 #include "record.h"
 #include "selector.h"
-#include "revision_script_manager.h"
+#include "project_context.h"
 #include "source_file.h"
 
+/// @brief
+/// The functions whose gcno structure a builder of a parse batch has
+/// already decoded. Builders sharing it store only the counts of these
+/// functions, and the decoder skips their blocks, arcs and lines.
+class Known_structures : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Returns if the structure of a function was already published.
+   ///
+   /// @param source The source file of the function.
+   /// @param key The function key in the source file.
+   bool is_known( const std::string & source,
+      const Source_file::Source_key & key ) const;
+
+   /// @brief
+   /// Publishes the functions decoded with their structure into the given
+   /// source files. The first publisher of a function owns its structure.
+   ///
+   /// @param source_files The source files of a decoded gcno file.
+   void publish( Source_file_map & source_files );
+
+   /// @brief
+   /// Returns the record holding the published structure of a function.
+   ///
+   /// @param source The source file of the function.
+   /// @param key The function key in the source file.
+   ///
+   /// @return The record, or NULL if the function is unknown or its
+   /// owner no longer holds it.
+   Record * find_structure( const std::string & source,
+      const Source_file::Source_key & key ) const;
+
+private:
+
+// PRIVATE TYPES
+
+   /// Maps the source and key of a function to the source files owning
+   /// its structure.
+   typedef boost::unordered_map< 
+      std::pair<std::string, Source_file::Source_key>,
+      Source_file_map * > Owner_map;
+
+// PRIVATE MEMBERS
+
+   /// Guards m_owners.
+   mutable boost::mutex m_mutex;
+
+   /// The owner of each published function.
+   Owner_map m_owners;
+
+}; // End of class Known_structures
+
 /// @brief
 /// Builds the data structure of a map of files for the parser class.
 class Parser_builder : boost::noncopyable
@@ -55,14 +116,26 @@ public:
    /// @brief
    /// Initializes the Parser_builder and stores a reference to the internal
    /// data of the Parser class.
+   ///
+   /// @param project The project context shared by the builders, which
+   /// must outlive the builder.
+   /// @param known_structures The structures already decoded by other
+   /// builders, whose blocks are not stored again.
    Parser_builder(
-      std::map<std::string, Source_file> & source_files,
-      const std::string & revision_script_path,
-      std::vector<std::string> found_source_files );
+      Source_file_map & source_files,
+      const Project_context & project,
+      const Known_structures * known_structures = NULL );
 
    /// @brief
-   /// Free memory used for demangling.
-   ~Parser_builder( );
+   /// Initializes the Parser_builder with a project context of its own.
+   ///
+   /// @param known_structures The structures already decoded by other
+   /// builders, whose blocks are not stored again.
+   Parser_builder(
+      Source_file_map & source_files,
+      const std::string & revision_script_path,
+      const std::vector<std::string> & found_source_files,
+      const Known_structures * known_structures = NULL );
 
    /// @brief 
    /// Will add or merge a record into the m_records data in the correct
@@ -71,8 +144,8 @@ public:
    /// @param rIdent The record unique indentifier.
    /// @param rChecksum The record unique checksum.
    /// @param rSource The record source file name.
-   /// @param rName The record source name.
-   /// @param m_name_demangled The demangled name of the record source name.
+   /// @param rName The record mangled name.
+   /// @param rLineno The first line of the record.
    void store_record(
       unsigned int rIdent, 
       unsigned int rChecksum,
@@ -116,36 +189,118 @@ public:
       const std::string & lName );
 
    /// @brief
-   /// Stores the arc count in the last record added.
+   /// Stores the next arc count of a function.
    ///
+   /// @param rIdent The function unique indentifier.
+   /// @param rChecksum The function checksum.
    /// @param aCount The arc count.
    void store_count( 
       unsigned int rIdent,
       unsigned int rChecksum,
       uint64_t aCount );
 
+   /// @brief
+   /// Stores the next run of arc counts of a function.
+   ///
+   /// @param rIdent The function unique indentifier.
+   /// @param rChecksum The function checksum.
+   /// @param counts The first arc count of the run.
+   /// @param size The number of arc counts in the run.
+   void store_counts( 
+      unsigned int rIdent,
+      unsigned int rChecksum,
+      const uint64_t * counts,
+      std::size_t size );
+
    /// @brief
    /// Assign arcs from cache to data structure.   
    void assign_arcs();
 
+   /// @brief
+   /// Prepares for another gcda file of the functions already stored, whose
+   /// counts are added to the counts stored so far.
+   void begin_gcda();
+
+   /// @brief
+   /// Returns if the last function stored was selected.
+   bool is_last_record_selected() const
+   {
+      return m_last_record_selected;
+   }
+
+   /// @brief
+   /// Returns if the blocks, arcs and lines of the last function stored are
+   /// wanted: it is selected and its structure is not known yet.
+   bool wants_last_structure() const
+   {
+      return m_last_record_selected && ! m_merging;
+   }
+
+   /// @brief
+   /// Sets if the line numbers of the blocks are stored.
+   void set_with_lines( bool with_lines )
+   {
+      m_with_lines = with_lines;
+   }
+
+   /// @brief
+   /// Returns if the line numbers of the last function stored are wanted.
+   bool wants_last_lines() const
+   {
+      return m_with_lines && wants_last_structure();
+   }
+
+   /// @brief
+   /// Returns if the counts of a function are wanted.
+   ///
+   /// @param rIdent The function unique indentifier.
+   /// @param rChecksum The function checksum.
+   bool is_record_selected( unsigned int rIdent, unsigned int rChecksum ) const
+   {
+      return m_record_index.find( std::make_pair( rIdent, rChecksum ) ) 
+         != m_record_index.end();
+   }
+
 private:
 
+// PRIVATE TYPES
+
+   /// @brief
+   /// The record the arc counts of a selected function are stored in.
+   struct Count_target
+   {
+      Count_target() : record( NULL ), merging( false ), merged( 0 )
+      {
+         // void
+      }
+
+      /// The record of the function.
+      Record * record;
+
+      /// Set if the record already had counts, which are added to.
+      bool merging;
+
+      /// The number of counts added to so far when merging.
+      std::size_t merged;
+   };
+
+   /// Maps the ident and checksum of a function to its count target.
+   typedef boost::unordered_map< std::pair<unsigned int, unsigned int>, 
+      Count_target > Record_index;
+
 // PRIVATE METHODS
 
    /// @brief
    /// Caches the last record stored / merged.
    ///
-   /// @param last_record_ident The unique indentifier of the last record 
-   /// added.
+   /// @param last_record The last record added.
    ///
    /// @remarks
-   /// This function exists to hide the fact the m_last_record_stores is an
-   /// iterator.
-   void set_last_record( 
-      std::map<Source_file::Source_key, Record> & records,
-      Source_file::Source_key last_record_key )
+   /// The records of a source file never move once added, so the cache
+   /// stays valid while more records are stored.
+   void set_last_record( Record & last_record )
    {
-      m_last_record_stored = records.find( last_record_key );
+      m_last_record_stored = &last_record;
    } 
 
    /// @brief
@@ -154,29 +309,37 @@ private:
    /// @return Reference to the last Record stored / merged.
    ///
    /// @remarks
-   /// This function exists to hide the fact that m_last_record_stored is
-   /// an iterator. By not having the code use the member field directory,
-   /// we help minimize the chance that the code will incorrectly modify the
-   /// cache pointer. 
+   /// By not having the code use the member field directly, we help
+   /// minimize the chance that the code will incorrectly modify the cache
+   /// pointer. 
    Record & get_last_record()
    {
-      return m_last_record_stored->second;
+      return *m_last_record_stored;
    }
 
+   /// @brief
+   /// Returns the id of the source file of a line.
+   ///
+   /// @param lName The source file of the line.
+   String_id intern_line_source( const std::string & lName );
+
 // PRIVATE MEMBERS
 
    /// A cache of the last record added. Thus we don't have to keep looking 
    /// it up.
-   std::map<Source_file::Source_key, Record>::iterator m_last_record_stored;
+   Record * m_last_record_stored;
 
    /// A reference to the internal source file map in the Parser class.
-   std::map<std::string, Source_file> & m_source_files;
+   Source_file_map & m_source_files;
 
-   /// A list of all the source files found in the project directory.
-   std::vector<std::string> m_found_source_files;
+   /// The project context of the builder, if it owns one.
+   boost::shared_ptr<const Project_context> m_own_project;
 
-   /// Used to pull the revision numbers for the source files.
-   Revision_script_manager m_revision_script_manager;
+   /// The source files of the project and their revision numbers.
+   const Project_context & m_project;
+
+   /// The structures decoded by other builders, if shared.
+   const Known_structures * m_known_structures;
 
    /// A cache if last record parsed was selected or not.
    bool m_last_record_selected;
@@ -184,20 +347,18 @@ private:
    /// Flags whether or not functions are being merged vs. added
    bool m_merging;
 
-   /// List of function checksums to flagged for merging counts
-   std::vector<unsigned> m_to_merge;
-
-   /// Index for use with m_counts when merging count data
-   unsigned m_index;
+   /// Set if the line numbers of the blocks are stored.
+   bool m_with_lines;
 
-   /// The checksum of the last merged record
-   unsigned m_last_merge;
+   /// The source file of the last line stored.
+   std::string m_line_source;
 
-   /// Cache allocation used for demangling;
-   std::size_t m_demangle_size;
+   /// The id of m_line_source.
+   String_id m_line_source_id;
 
-   /// Cache allocation used for demangling;
-   char* m_demangle_buffer;
+   /// The selected functions stored by this builder, by ident and 
+   /// checksum.
+   Record_index m_record_index;
 }; // End of class Parser_builder
 
 #endif
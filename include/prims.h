@@ -32,6 +32,12 @@
 ///  Defines TOKEN32 primitive: Matches specific int32 value
 ///  Defines STRING primitive: Reads an arbitrary length string
 ///  Defines NONZERO pirmitive: Reads nonzero int32 and returns value
+///  Defines INT64 primitive: Reads int64 and returns value
+///
+///  The primitives return the value read as their match attribute, and
+///  read the byte order of the input from the scanner, so each parse
+///  keeps its own state. STRING returns a view of the characters in the
+///  input, which assign_string_a copies into a reused string buffer.
 ///
 ///  Requirements Specification: 
 ///       < http://code.google.com/p/trucov/wiki/SRS > 
@@ -50,35 +56,49 @@
 
 #include <boost/ref.hpp>
 #include <boost/version.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #if BOOST_VERSION < NEW_SPIRIT_VERSION
    #define SPIRIT_NAMESPACE boost::spirit
+   #include <boost/spirit/actor.hpp>
    #include <boost/spirit/core.hpp>
 #else
    #define SPIRIT_NAMESPACE boost::spirit::classic
+   #include <boost/spirit/include/classic_actor.hpp>
    #include <boost/spirit/include/classic_core.hpp>
 #endif
 
 //  GLOBAL VARIABLES
 
-// Used by grammar to determine if the parsing file is little endian
-extern bool global_little_endian;
-
-// Last int32 read. 
-extern unsigned int global_parsed_int32;
-
-// Last int64 read.
-extern uint64_t global_parsed_int64;
-
-// Last string read.
-extern std::string global_parsed_string;
-
 // Size of int32 values in the GCNO and GCDA files.
 static const unsigned int int32_size = 4;
 
 // Size of int64 values in the GCNO and GCDA files. 
 static const unsigned int int64_size = 8;
 
+/// @brief
+/// Iteration policy of the scanners used by raw_parse. Carries the byte
+/// order of the input to the primitives.
+struct gcov_iteration_policy : public SPIRIT_NAMESPACE::iteration_policy
+{
+    /// @brief
+    /// Initializes the byte order of the input.
+    ///
+    /// @param little_endian_ If the input is little endian.
+    explicit gcov_iteration_policy(bool little_endian_ = false)
+    : little_endian(little_endian_)
+    {
+        // void
+    }
+
+    /// Determines if the input is little endian.
+    bool little_endian;
+};
+
+/// The scanner policies used by raw_parse.
+typedef SPIRIT_NAMESPACE::scanner_policies<gcov_iteration_policy> 
+    gcov_scanner_policies;
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief
 /// Performs parsing over the specified input using the specified grammar  
@@ -91,6 +111,7 @@ static const unsigned int int64_size = 8;
 /// @param first_ The begginning of the input.
 /// @param last The end of the input. 
 /// @param p The parser (grammar) used to parse the input.
+/// @param little_endian If the input is little endian.
 ///
 /// @return parse_info
 ///////////////////////////////////////////////////////////////////////////////
@@ -99,13 +120,15 @@ inline SPIRIT_NAMESPACE::parse_info<IteratorT>
 raw_parse(
     IteratorT const& first_
   , IteratorT const& last
-  , SPIRIT_NAMESPACE::parser<ParserT> const& p)
+  , SPIRIT_NAMESPACE::parser<ParserT> const& p
+  , bool little_endian)
 {
     // Create a scanner that will iterate from first to last byte in the 
     // input buffer.
     IteratorT first = first_;
-    SPIRIT_NAMESPACE::scanner<IteratorT, SPIRIT_NAMESPACE::scanner_policies<> >
-        scan(first, last);
+    SPIRIT_NAMESPACE::scanner<IteratorT, gcov_scanner_policies>
+        scan(first, last, 
+             gcov_scanner_policies(gcov_iteration_policy(little_endian)));
 
     // Call spirit parse method on the parser p.
     SPIRIT_NAMESPACE::match<SPIRIT_NAMESPACE::nil_t> hit = p.derived().parse(scan);
@@ -149,7 +172,7 @@ struct int32_parser : public SPIRIT_NAMESPACE::parser<DerivedT>
    struct result
    {
       typedef typename SPIRIT_NAMESPACE::match_result<ScannerT,   
-             typename ScannerT::value_t>::type type;
+             unsigned int>::type type;
    };
 
    /// @brief
@@ -183,18 +206,17 @@ struct int32_parser : public SPIRIT_NAMESPACE::parser<DerivedT>
       if (i == int32_size)
       {
          // Flip big endian
-         if (!global_little_endian)
+         if (!scan.little_endian)
          {
              reverse_buffer(buf);
          } 
 
          // Convert 4 bytes into unsigned int
          i = *((unsigned int *) buf);
-         global_parsed_int32 = i;      
    
          if (this->derived().test(i))
          {
-               return scan.create_match(int32_size, 0, save, scan.first);  
+               return scan.create_match(int32_size, i, save, scan.first);  
          }
       }
    
@@ -285,12 +307,23 @@ nonzero32<unsigned int> const NONZERO = nonzero32<unsigned int>();
 /// Parser used to extract an string from the input
 ///
 /// @remarks
-/// String format: size (int32), null terminated string, padding  
+/// String format: size (int32), null terminated string, padding. The
+/// attribute is constructed once from the characters before the null, so
+/// StrT may be a string or a view such as boost::iterator_range.
 template<typename StrT>
 struct string_parser : public SPIRIT_NAMESPACE::parser<string_parser<StrT> >
 {
    typedef string_parser<StrT> self_t;
 
+   /// @brief
+   /// Result value type, the string read.
+   template <typename ScannerT>
+   struct result
+   {
+      typedef typename SPIRIT_NAMESPACE::match_result<ScannerT,   
+             StrT>::type type;
+   };
+
    ///  @brief
    ///  Reads an arbitrary length string and returns the value 
    ///
@@ -306,7 +339,6 @@ struct string_parser : public SPIRIT_NAMESPACE::parser<string_parser<StrT> >
          SPIRIT_NAMESPACE::parser_result<self_t, ScannerT>::type result_t;
 
       iterator_t save;
-      std::string str;
       char buf[int32_size];
       unsigned int i, length;
 
@@ -329,7 +361,7 @@ struct string_parser : public SPIRIT_NAMESPACE::parser<string_parser<StrT> >
       }
 
       // Flip big endian
-      if (!global_little_endian)
+      if (!scan.little_endian)
       {
          reverse_buffer(buf);
       } 
@@ -343,24 +375,28 @@ struct string_parser : public SPIRIT_NAMESPACE::parser<string_parser<StrT> >
          return scan.no_match();
       }
 
-      // Read String
-      for (i = 0; !scan.at_end() && *scan != 0; i++, scan.first++)
-      {
-         str.push_back(*scan);   
-      }
-
-      // Consume padding
-      while (i < length && !scan.at_end())
+      // Read String up to its null, then consume padding
+      iterator_t str_first = scan.first;
+      iterator_t str_last = scan.first;
+      bool terminated = false;
+      for (i = 0; i < length && !scan.at_end(); i++, scan.first++)
       {
-         scan.first++;
-         i++;  
+         if (!terminated && *scan == 0)
+         {
+            str_last = scan.first;
+            terminated = true;
+         }
       }
 
       // If entire length of string was read, then no failure
       if (i == length)
       {
-         global_parsed_string = str;
-         return scan.create_match(length, str, save, scan.first);    
+         if (!terminated)
+         {
+            str_last = scan.first;
+         }
+         return scan.create_match(length, StrT(str_first, str_last), 
+                                  save, scan.first);    
       }
    
       // Failure when whole string was not read
@@ -371,9 +407,42 @@ struct string_parser : public SPIRIT_NAMESPACE::parser<string_parser<StrT> >
 }; // end of struct string_parser  
 
 /// @brief
-/// Primitive Indentifier used for primitive string_parser
-string_parser<std::string> const STRING = 
-    string_parser<std::string>();
+/// View of a string inside the buffer being parsed.
+typedef boost::iterator_range<const char *> String_ref;
+
+/// @brief
+/// Primitive Indentifier used for primitive string_parser. Matches a view
+/// of the input, so reading a string does not allocate.
+string_parser<String_ref> const STRING = 
+    string_parser<String_ref>();
+
+/// @brief
+/// Action copying a matched String_ref into a string.
+struct assign_string_action
+{
+   template <typename T, typename ValueT>
+   void act(T & ref_, ValueT const & value_) const
+   {
+      ref_.assign(value_.begin(), value_.end());
+   }
+
+   template <typename T, typename IteratorT>
+   void act(T & ref_, IteratorT const & first_, IteratorT const & last_) const
+   {
+      ref_.assign(first_, last_);
+   }
+};
+
+/// @brief
+/// Copies the view matched by STRING into a string, reusing its storage.
+///
+/// @param ref_ The string assigned.
+template <typename T>
+inline SPIRIT_NAMESPACE::ref_value_actor<T, assign_string_action>
+       assign_string_a(T & ref_)
+{
+   return SPIRIT_NAMESPACE::ref_value_actor<T, assign_string_action>(ref_);
+}
 
 /// @brief
 /// Parser used to extract an int64 from the input
@@ -382,6 +451,15 @@ struct int64_parser : public SPIRIT_NAMESPACE::parser<int64_parser<Int64T> >
 {
    typedef int64_parser<Int64T> self_t;
 
+   /// @brief
+   /// Result value type, the int64 read.
+   template <typename ScannerT>
+   struct result
+   {
+      typedef typename SPIRIT_NAMESPACE::match_result<ScannerT,   
+             uint64_t>::type type;
+   };
+
    ///  @brief
    ///  Reads an int64 from parsing input.
    ///  
@@ -425,7 +503,7 @@ struct int64_parser : public SPIRIT_NAMESPACE::parser<int64_parser<Int64T> >
       char * first = buf + 0;
       char * last = buf + int64_size;
 
-      if (global_little_endian)
+      if (scan.little_endian)
       {
           low = *((unsigned int *) first);
           high = *((unsigned int *) (first + int32_size));
@@ -457,8 +535,7 @@ struct int64_parser : public SPIRIT_NAMESPACE::parser<int64_parser<Int64T> >
           value |= (uint64_t) high << int32_size * 8;
       }
 
-      global_parsed_int64 = value;
-      return scan.create_match(int64_size, 0, save, scan.first);   
+      return scan.create_match(int64_size, value, save, scan.first);   
    
    } // end of parse(...)
 
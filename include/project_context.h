@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file project_context.h
+///
+///  @brief
+///  Defines the Project_context class.
+///
+///  @remarks
+///  The context is built once the source files of the project are found,
+///  and is only read afterwards, so the parse workers share it without
+///  locking.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef PROJECT_CONTEXT_H
+#define PROJECT_CONTEXT_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+
+/// @brief
+/// A source file found in the project directories.
+struct Project_source
+{
+   /// The path of the source file.
+   std::string m_path;
+
+   /// The revision number of the source file, empty if unknown.
+   std::string m_revision_number;
+};
+
+/// @brief
+/// The source files of the project, indexed by their file name, and their
+/// revision numbers.
+class Project_context : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Indexes the source files and resolves their revision numbers.
+   ///
+   /// @param source_files The source files found in the project directories.
+   /// @param revision_script_path The revision script, or empty for none.
+   Project_context( const std::vector<std::string> & source_files,
+      const std::string & revision_script_path );
+
+   /// @brief
+   /// Returns the project source file a gcno source file name refers to.
+   /// Sources are matched by file name, and the first one found wins.
+   ///
+   /// @param source_name The source file name found in a gcno file.
+   ///
+   /// @return The project source, or NULL if the source is not within the
+   /// project.
+   const Project_source * find_source( const std::string & source_name ) const;
+
+   /// @brief
+   /// Returns the source files found in the project directories.
+   const std::vector<std::string> & get_source_files() const
+   {
+      return m_source_files;
+   }
+
+private:
+
+// PRIVATE TYPES
+
+   /// Maps a file name to the index of its source in m_sources.
+   typedef boost::unordered_map<std::string, std::size_t> Name_index;
+
+// PRIVATE MEMBERS
+
+   /// The source files found in the project directories.
+   std::vector<std::string> m_source_files;
+
+   /// The sources of distinct file names, in the order they were found.
+   std::vector<Project_source> m_sources;
+
+   /// The index of each source by its file name.
+   Name_index m_by_name;
+
+}; // End of class Project_context
+
+#endif
@@ -39,8 +39,13 @@
 #include <map>
 #include <vector>
 #include <iostream>
+#include <cstddef>
 #include <stdint.h>
 
+//  LOCAL INCLUDES
+#include "arena.h"
+#include "string_table.h"
+
 //  TYPE DEFINITIONS
 
 /// A line number entry that may or may not be inlined
@@ -52,34 +57,8 @@ typedef struct line
    bool m_inlined;
 } Line;
 
-/// @brief
-/// Contains the name of the source file, the function block number
-/// and all lines associated with that block
-class Lines_data
-{
-public:
-
-   // PUBLIC METHODS
-
-   /// Returns the block's line numbers of a particular source file
-   const std::vector<Line> & get_lines() const;
-
-   // FRIEND CLASSES
-
-   /// Block class must add data to Lines_data class as GCNO file is being parsed
-   friend class Block;
-   /// Parser class must be able to normalize data within Lines_data class
-   friend class Parser;
-   /// Parser_builder class mst be able to add lines and sources to Lines_data
-   friend class Parser_builder;
-
-private:
-
-   // PRIVATE MEMBERS
-
-   /// The source lines that make up the function block
-   std::vector<Line> m_lines;
-};
+/// The line numbers of a block, allocated from the model arena
+typedef std::vector<Line, Arena_allocator<Line> > Line_list;
 
 /// @brief
 /// Contains the destination block, arc flag, and a count of how
@@ -120,6 +99,8 @@ public:
 
    /// Parser needs to be a friend class for arc normalization function
    friend class Parser;
+   /// Flow_graph groups the arcs by their blocks
+   friend class Flow_graph;
 
 private:
 
@@ -136,10 +117,362 @@ private:
 };
 
 /// @brief
-/// Contains the block number, arcs leaving the block, pointers
-/// to arcs entering the block, data about the function block's
-/// associated line numbers, and a bool indicating if the arc
-/// count for that block has been normalized
+/// A view of the arcs leaving a block, which are stored contiguously in
+/// the flow graph of their function
+class Arc_range
+{
+public:
+
+   // PUBLIC TYPES
+
+   typedef const Arc * const_iterator;
+
+   // PUBLIC METHODS
+
+   /// Constructs an empty range
+   Arc_range() : m_first( NULL ), m_size( 0 )
+   {
+   }
+
+   /// @brief
+   /// Constructs the range of size arcs starting at first
+   Arc_range( const Arc * first, unsigned size )
+      : m_first( first ), m_size( size )
+   {
+   }
+
+   /// Returns the number of arcs
+   unsigned size() const
+   {
+      return m_size;
+   }
+
+   /// Returns whether or not the range has no arcs
+   bool empty() const
+   {
+      return m_size == 0;
+   }
+
+   /// Returns the i-th arc of the range
+   const Arc & operator[]( unsigned i ) const
+   {
+      return m_first[i];
+   }
+
+   /// Returns the first arc of the range
+   const_iterator begin() const
+   {
+      return m_first;
+   }
+
+   /// Returns the end of the range
+   const_iterator end() const
+   {
+      return m_first + m_size;
+   }
+
+private:
+
+   // PRIVATE MEMBERS
+
+   /// The first arc of the range
+   const Arc * m_first;
+   /// The number of arcs in the range
+   unsigned m_size;
+};
+
+/// @brief
+/// The control flow graph of a function held in flat arrays. The arcs
+/// leaving the blocks are stored block after block, and the arcs entering
+/// each block are indexed in the same compressed row form.
+///
+/// @remarks
+/// Arcs are added in any order while the gcno file is parsed; build()
+/// then groups them by origin block, keeping their order within a block,
+/// which is the order of their counts in the gcda file.
+class Flow_graph
+{
+public:
+
+   // PUBLIC METHODS
+
+   /// @brief
+   /// Adds an arc, which is not seen by the blocks before the next build()
+   ///
+   /// @param origin The arc's origin block number
+   /// @param dest The arc's destination block number
+   /// @param flag The arc's flag value
+   void add_arc( unsigned origin, unsigned dest, unsigned flag );
+
+   /// @brief
+   /// Groups the arcs by origin block and indexes the entering arcs
+   ///
+   /// @param block_count The number of blocks of the function
+   void build( unsigned block_count );
+
+   /// @brief
+   /// Exchanges the arrays with another flow graph
+   void swap( Flow_graph & other );
+
+   /// Returns the total number of arcs of the function
+   unsigned size() const
+   {
+      return m_arcs.size();
+   }
+
+   /// Returns the arcs leaving a block
+   Arc_range get_arcs( unsigned block ) const;
+
+   /// Returns the number of arcs leaving a block
+   unsigned get_arc_count( unsigned block ) const;
+
+   /// Returns the k-th arc leaving a block
+   Arc & get_arc( unsigned block, unsigned k )
+   {
+      return m_arcs[ m_arc_begin[block] + k ];
+   }
+
+   /// Returns the number of arcs entering a block
+   unsigned get_from_arc_count( unsigned block ) const;
+
+   /// Returns the k-th arc entering a block
+   const Arc & get_from_arc( unsigned block, unsigned k ) const
+   {
+      return m_arcs[ m_from_arcs[ m_from_begin[block] + k ] ];
+   }
+
+   /// Returns the k-th arc entering a block
+   Arc & get_from_arc( unsigned block, unsigned k )
+   {
+      return m_arcs[ m_from_arcs[ m_from_begin[block] + k ] ];
+   }
+
+   // FRIEND CLASSES
+
+   /// Parser assigns the counts of the arcs in graph order
+   friend class Parser;
+
+private:
+
+   // PRIVATE MEMBERS
+
+   /// The arcs of the function, grouped by origin block once built
+   std::vector<Arc> m_arcs;
+   /// The index in m_arcs of the first arc leaving each block, followed
+   /// by the number of arcs
+   std::vector<unsigned> m_arc_begin;
+   /// The index in m_arcs of the arcs entering the blocks, grouped by
+   /// destination block
+   std::vector<unsigned> m_from_arcs;
+   /// The index in m_from_arcs of the first arc entering each block,
+   /// followed by the number of arcs
+   std::vector<unsigned> m_from_begin;
+};
+
+/// @brief
+/// A view of the lines of a block from one source file, which are stored
+/// contiguously in the line table of their function
+class Line_range
+{
+public:
+
+   // PUBLIC TYPES
+
+   typedef const Line * const_iterator;
+
+   // PUBLIC METHODS
+
+   /// Constructs an empty range
+   Line_range() : m_first( NULL ), m_size( 0 )
+   {
+   }
+
+   /// @brief
+   /// Constructs the range of size lines starting at first
+   Line_range( const Line * first, unsigned size )
+      : m_first( first ), m_size( size )
+   {
+   }
+
+   /// Returns the number of lines
+   unsigned size() const
+   {
+      return m_size;
+   }
+
+   /// Returns whether or not the range has no lines
+   bool empty() const
+   {
+      return m_size == 0;
+   }
+
+   /// Returns the i-th line of the range
+   const Line & operator[]( unsigned i ) const
+   {
+      return m_first[i];
+   }
+
+   /// Returns the first line of the range
+   const_iterator begin() const
+   {
+      return m_first;
+   }
+
+   /// Returns the end of the range
+   const_iterator end() const
+   {
+      return m_first + m_size;
+   }
+
+private:
+
+   // PRIVATE MEMBERS
+
+   /// The first line of the range
+   const Line * m_first;
+   /// The number of lines in the range
+   unsigned m_size;
+};
+
+/// @brief
+/// The line numbers of a function held in one flat table. The lines of
+/// each block are stored in runs, one run per source file in source file
+/// name order, and the runs of a block are stored contiguously.
+///
+/// @remarks
+/// Lines are added in any order while the gcno file is parsed; build()
+/// then groups them into runs, sorting each run by line number and
+/// dropping the repeated ones. Lines pushed once the table is built are
+/// appended to their run and seen at once.
+class Line_table
+{
+public:
+
+   // PUBLIC METHODS
+
+   /// @brief
+   /// Adds a line, which is not seen by the blocks before the next build()
+   ///
+   /// @param block The block number of the line
+   /// @param source The id of the line's source file name
+   /// @param line_num The line number
+   void add_line( unsigned block, String_id source, unsigned line_num );
+
+   /// @brief
+   /// Groups the lines into runs by block and source file, each sorted
+   /// by line number
+   ///
+   /// @param block_count The number of blocks of the function
+   void build( unsigned block_count );
+
+   /// @brief
+   /// Appends a line to the run of a block from a source file, creating
+   /// the run if the block has no lines from the source file yet
+   ///
+   /// @param block The block number, which the table was built with
+   /// @param source The id of the line's source file name
+   /// @param line The line
+   void push_line( unsigned block, String_id source, const Line & line );
+
+   /// @brief
+   /// Exchanges the table with another line table
+   void swap( Line_table & other );
+
+   /// Returns the total number of lines of the function
+   unsigned size() const
+   {
+      return m_lines.size();
+   }
+
+   /// Returns the number of source files a block has lines from
+   unsigned get_source_count( unsigned block ) const;
+
+   /// Returns the id of the k-th source file a block has lines from
+   String_id get_source( unsigned block, unsigned k ) const
+   {
+      return m_runs[ m_block_runs[block].m_first + k ].m_source;
+   }
+
+   /// Returns the lines of a block from its k-th source file
+   Line_range get_lines( unsigned block, unsigned k ) const;
+
+   /// @brief
+   /// Returns the index of a block's source file
+   ///
+   /// @return get_source_count( block ) if the block has no lines from it
+   unsigned find_source( unsigned block, String_id source ) const;
+
+   // FRIEND CLASSES
+
+   /// Parser sets the inline status of the lines in place
+   friend class Parser;
+
+private:
+
+   // PRIVATE TYPES
+
+   /// A line added before the table is built
+   struct Added_line
+   {
+      /// The block number of the line
+      unsigned m_block;
+      /// The id of the line's source file name
+      String_id m_source;
+      /// The line
+      Line m_line;
+   };
+
+   /// Orders the added lines by block, source file name and line number
+   struct Added_line_less
+   {
+      bool operator()( const Added_line & lhs, const Added_line & rhs ) const;
+   };
+
+   /// The lines of a block from one source file
+   struct Line_run
+   {
+      /// The id of the source file name
+      String_id m_source;
+      /// The index in m_lines of the first line
+      unsigned m_first;
+      /// The number of lines
+      unsigned m_size;
+   };
+
+   /// The runs of a block
+   struct Run_span
+   {
+      /// The index in m_runs of the first run
+      unsigned m_first;
+      /// The number of runs
+      unsigned m_size;
+   };
+
+   // PRIVATE METHODS
+
+   /// Returns the first of the lines of a block from its k-th source file
+   Line * get_first_line( unsigned block, unsigned k )
+   {
+      return &m_lines[ m_runs[ m_block_runs[block].m_first + k ].m_first ];
+   }
+
+   // PRIVATE MEMBERS
+
+   /// The lines added since the table was last built, freed by build()
+   std::vector<Added_line> m_added;
+   /// The lines of the function, run after run
+   Line_list m_lines;
+   /// The runs of the function, grouped by block
+   std::vector<Line_run, Arena_allocator<Line_run> > m_runs;
+   /// The runs of each block
+   std::vector<Run_span, Arena_allocator<Run_span> > m_block_runs;
+};
+
+/// @brief
+/// Contains the block number and a bool indicating if the arc count
+/// for that block has been normalized. The arcs leaving and entering
+/// the block are viewed in the flow graph of its function, and its line
+/// numbers in the line table of its function.
 class Block
 {
 public:
@@ -150,8 +483,9 @@ public:
    /// Block object constructor
    ///
    /// @param block_no  The Block's number
-   Block( const unsigned block_no ) : m_block_no( block_no ),
-      m_normalized( false ), m_fake( false )
+   Block( const unsigned block_no ) : m_graph( NULL ), m_line_table( NULL ),
+      m_block_no( block_no ), m_normalized( false ), m_fake( false ),
+      m_inlined( false )
    {
    }
 
@@ -184,10 +518,23 @@ public:
    const unsigned get_block_no() const;
 
    /// Returns a function block's outgoing Arcs
-   const std::vector<Arc> & get_arcs() const;
+   Arc_range get_arcs() const;
 
-   /// Returns the line numbers that make up the block
-   const std::map<std::string,Lines_data> & get_lines() const;
+   /// Returns the number of Arcs entering the block
+   unsigned get_from_arc_count() const;
+
+   /// Returns the k-th Arc entering the block
+   const Arc & get_from_arc( unsigned k ) const;
+
+   /// Returns the number of source files the block has lines from
+   unsigned get_source_count() const;
+
+   /// Returns the id of the k-th source file the block has lines from,
+   /// in source file name order
+   String_id get_source( unsigned k ) const;
+
+   /// Returns the line numbers of the block from its k-th source file
+   Line_range get_lines( unsigned k ) const;
 
    /// Returns the total number of taken arcs in a branch
    const unsigned get_branch_arc_taken() const;
@@ -199,25 +546,25 @@ public:
    const int64_t get_count() const;
 
    /// Returns the non-inlined line numbers of a block
-   const std::vector<Line> & get_non_inlined() const;
+   const Line_list & get_non_inlined() const;
 
    // FRIEND CLASSES
 
-   // Parser class must access Lines_data and Arc classes for normalization
+   // Parser class must access the block for normalization
    friend class Parser;
-   // Parser_builder must access Block class for access to Lines_data member
+   // Parser_builder must access Block class for access to its members
    friend class Parser_builder;
+   // Record binds its blocks to its flow graph and line table
+   friend class Record;
 
 private:
 
    // PRIVATE MEMBERS
 
-   /// The function block's outgoing Arcs
-   std::vector<Arc>  m_arcs;
-   /// The function block's incoming Arcs
-   std::vector<Arc*> m_from_arcs;
-   /// The line numbers that make up a block and their associated source files
-   std::map<std::string, Lines_data> m_lines;
+   /// The flow graph of the block's function, NULL until it is built
+   const Flow_graph * m_graph;
+   /// The line table of the block's function, NULL until it is built
+   const Line_table * m_line_table;
    /// The function block's number
    unsigned m_block_no;
    /// The normalization status of a function block
@@ -227,7 +574,7 @@ private:
    /// The status of whether a block only has inlined source code
    bool m_inlined;
    /// The non-inlined lines that make up the block
-   std::vector<Line> m_non_inlined;
+   Line_list m_non_inlined;
 };
 
 ///  @brief
@@ -242,6 +589,64 @@ class Record
 
    // PUBLIC METHODS
 
+   /// Record object constructor
+   Record() : m_ident( 0 ), m_checksum( 0 ), 
+      m_source( String_table::Empty ), m_line_num( 0 )
+   {
+   }
+
+   /// Copies a record, binding the copied blocks to the copied graph and
+   /// line table
+   Record( const Record & other );
+
+   /// Assigns a record, binding the assigned blocks to the assigned graph
+   /// and line table
+   Record & operator=( const Record & other );
+
+   /// @brief
+   /// Adds an arc to the function's flow graph
+   ///
+   /// @param origin The arc's origin block number
+   /// @param dest The arc's destination block number
+   /// @param flag The arc's flag value
+   void add_arc( unsigned origin, unsigned dest, unsigned flag )
+   {
+      m_graph.add_arc( origin, dest, flag );
+   }
+
+   /// @brief
+   /// Adds a line number to the function's line table
+   ///
+   /// @param block The line's block number
+   /// @param source The id of the line's source file name
+   /// @param line_num The line number
+   void add_line( unsigned block, String_id source, unsigned line_num )
+   {
+      m_line_table.add_line( block, source, line_num );
+   }
+
+   /// @brief
+   /// Builds the flow graph and the line table of the blocks and binds the
+   /// blocks to them
+   void build();
+
+   /// @brief
+   /// Exchanges the whole record with another record without copying it
+   void swap( Record & other );
+
+   /// @brief
+   /// Exchanges the blocks, flow graph and line table with another record
+   void swap_graph( Record & other );
+
+   /// Returns the record's source file name
+   const std::string & get_source() const
+   {
+      return String_table::get_instance().get_string( m_source );
+   }
+
+   /// Returns the demangled function signature, demangling it on first use
+   const std::string & get_name_demangled() const;
+
    /// Returns the function signature in HTML friendly style
    const std::string get_HTML_name() const;
 
@@ -265,18 +670,22 @@ class Record
    unsigned m_checksum;
    /// The record's mangled signature
    std::string m_name;
-   /// The record's demangled signature
-   std::string m_name_demangled;
-   /// The record's source file name
-   std::string m_source;
+   /// The record's demangled signature, empty until it is first asked for
+   mutable std::string m_name_demangled;
+   /// The id of the record's source file name
+   String_id m_source;
    /// The first line number of the record
    unsigned m_line_num;
    /// The record's function blocks
    std::vector<Block> m_blocks;
+   /// The arcs between the record's function blocks
+   Flow_graph m_graph;
+   /// The line numbers of the function's blocks
+   Line_table m_line_table;
    /// The GCDA parsed arc counts
    std::vector<uint64_t> m_counts; 
-   /// A function's blocks, sorted by their line numbers
-   std::vector<Block> m_blocks_sorted;
+   /// The numbers of a function's blocks, sorted by their line numbers
+   std::vector<unsigned> m_block_order;
 
 #ifdef DEBUGFLAG
    void set_graph_path(const std::string & path)
@@ -291,6 +700,13 @@ class Record
    std::string m_graph_path;
    std::string m_report_path;
 #endif
+
+   private:
+
+   // PRIVATE METHODS
+
+   /// Points the blocks at the record's own flow graph and line table
+   void bind_blocks();
 };
 
 /// @brief
@@ -78,11 +78,15 @@ public:
     /// Returns if a function or source was selected or not
     ///
     /// @param source_name The source file name
-    /// @param function_signature The name of the function
+    /// @param mangled_name The mangled name of the function
     ///
     /// @return bool
+    ///
+    /// @remarks
+    /// The name is demangled only if it is matched against the selection,
+    /// and never when mangled names are output.
     bool is_selected( const std::string & source_name,
-        const std::string & function_signature ); 
+        const std::string & mangled_name ); 
 
 private:
 
@@ -132,6 +136,9 @@ private:
     /// Determines is to match the signature or the name of a function
     bool is_signature_match;
 
+    /// Determines if the mangled names of the functions are matched
+    bool is_mangled_match;
+
     /// Lists all functions selected
     std::vector< boost::regex > regex_selections;
 
@@ -32,17 +32,65 @@
 
 // SYSTEM INCLUDES
 
-#include <map>
+#include <string>
+#include <cstddef>
+
+#include <boost/functional/hash.hpp>
 
 // LOCAL INCLUDES
 
+#include "dense_map.h"
 #include "record.h"
 
 class Source_file
 {
 public:
 
-    typedef unsigned int Source_key; 
+    /// @brief
+    /// Identifies a function of the source file. The copies of a function
+    /// compiled into several objects share their checksum and name, and
+    /// are merged into one record.
+    struct Source_key
+    {
+        Source_key() : m_checksum( 0 )
+        {
+            // void
+        }
+
+        Source_key( unsigned int checksum, const std::string & name )
+            : m_checksum( checksum ), m_name( name )
+        {
+            // void
+        }
+
+        /// The function checksum.
+        unsigned int m_checksum;
+
+        /// The function mangled name.
+        std::string m_name;
+
+        /// Orders the keys by checksum first.
+        bool operator<( const Source_key & other ) const
+        {
+            return m_checksum != other.m_checksum
+               ? m_checksum < other.m_checksum : m_name < other.m_name;
+        }
+
+        bool operator==( const Source_key & other ) const
+        {
+            return m_checksum == other.m_checksum && m_name == other.m_name;
+        }
+
+        friend std::size_t hash_value( const Source_key & key )
+        {
+            std::size_t seed = key.m_checksum;
+            boost::hash_combine( seed, key.m_name );
+            return seed;
+        }
+    };
+
+    /// The records of the source file, by function.
+    typedef Dense_map<Source_key, Record> Record_map;
 
 // PUBLIC MEMBERS
     std::string m_source_path;
@@ -50,9 +98,12 @@ public:
     // The current version of the source file read by trucov.
     std::string m_revision_number;
 
-    std::map<Source_key, Record> m_records;
+    Record_map m_records;
 
     double m_coverage_percentage;
 };
 
+/// The source files of the coverage model, by source name.
+typedef Dense_map<std::string, Source_file> Source_file_map;
+
 #endif
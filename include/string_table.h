@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file string_table.h
+///
+///  @brief
+///  Defines the String_table class.
+///
+///  @remarks
+///  The same few source and header paths name the line data of every
+///  block of the coverage model. The model holds them as 32-bit ids of a
+///  process-wide table instead of copies of the paths.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+// SYSTEM INCLUDES
+
+#include <cstddef>
+#include <string>
+#include <stdint.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/mutex.hpp>
+
+/// The id of a string interned in the String_table.
+typedef uint32_t String_id;
+
+/// @brief
+/// Interns strings: every distinct string gets an id, which stands for it
+/// until the process exits. Id 0 is the empty string.
+///
+/// @remarks
+/// Interning is synchronized, so the parser threads may share the table.
+/// Looking up the string of an id is not, as an id is only ever obtained
+/// after its string was stored.
+class String_table : boost::noncopyable
+{
+public:
+
+// PUBLIC CONSTANTS
+
+   /// The id of the empty string.
+   static const String_id Empty = 0;
+
+// PUBLIC TYPES
+
+   /// @brief
+   /// Orders ids as their strings, so containers keyed by id keep the
+   /// same order whatever order the strings were interned in.
+   struct Less
+   {
+      bool operator()( String_id left, String_id right ) const;
+   };
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Returns the table of the process, which is never destroyed so the
+   /// ids stay valid in static destructors.
+   static String_table & get_instance();
+
+   /// @brief
+   /// Returns the id of a string, interning it on first use.
+   ///
+   /// @param value The string.
+   String_id intern( const std::string & value );
+
+   /// @brief
+   /// Returns the string of an id.
+   ///
+   /// @param id An id returned by intern().
+   const std::string & get_string( String_id id ) const
+   {
+      return *m_chunks[id / Chunk_size][id % Chunk_size];
+   }
+
+   /// @brief
+   /// Returns the number of strings interned.
+   std::size_t size() const;
+
+private:
+
+// PRIVATE CONSTANTS
+
+   /// The number of strings of a chunk.
+   static const std::size_t Chunk_size = 1024;
+
+   /// The maximum number of chunks, which never move once allocated.
+   static const std::size_t Max_chunks = 4096;
+
+// PRIVATE TYPES
+
+   /// Maps each string interned to its id.
+   typedef boost::unordered_map<std::string, String_id> Index;
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Initializes the table with the empty string.
+   String_table();
+
+// PRIVATE MEMBERS
+
+   /// Guards m_index, m_size and the allocation of the chunks.
+   mutable boost::mutex m_mutex;
+
+   /// The strings interned, which own their text.
+   Index m_index;
+
+   /// The strings by id, pointing to the keys of m_index.
+   const std::string ** m_chunks[Max_chunks];
+
+   /// The number of strings interned.
+   std::size_t m_size;
+
+}; // End of class String_table
+
+#endif
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file tar_archive.h
+///
+///  @brief
+///  Defines the Tar_archive class.
+///
+///  @remarks
+///  Coverage bundles are tar archives of a build tree, either plain or
+///  compressed with gzip or zstd. The archive is read in a single pass and
+///  only its gcno and gcda members are kept in memory, so the files are
+///  parsed without being extracted.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TAR_ARCHIVE_H
+#define TAR_ARCHIVE_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <istream>
+
+#include <boost/noncopyable.hpp>
+
+/// @brief
+/// The gcno and gcda members of a tar archive.
+class Tar_archive : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Returns if a path names a tar archive this class can read, by its
+   /// extension: .tar, .tar.gz, .tgz or .tar.zst.
+   ///
+   /// @param path The path of the file.
+   static bool is_archive( const std::string & path );
+
+   /// @brief
+   /// Initializes an empty archive.
+   Tar_archive();
+
+   /// @brief
+   /// Reads the gcno and gcda members of an archive file, decompressing it
+   /// as its extension tells.
+   ///
+   /// @param path The path of the archive.
+   ///
+   /// @return success(true), failure(false)
+   bool open( const std::string & path );
+
+   /// @brief
+   /// Returns if the archive could be read to its end.
+   bool is_open() const
+   {
+      return m_open;
+   }
+
+   /// @brief
+   /// Returns the path of the archive.
+   const std::string & get_path() const
+   {
+      return m_path;
+   }
+
+   /// @brief
+   /// Returns the gcno members that have a gcda member of the same name,
+   /// paired with it, in archive order.
+   const std::vector< std::pair<std::string, std::string> > & get_pairs() const
+   {
+      return m_pairs;
+   }
+
+   /// @brief
+   /// Returns the contents of a gcno or gcda member.
+   ///
+   /// @param name The member name.
+   ///
+   /// @return The contents, or NULL if there is no such member.
+   const std::vector<char> * find_member( const std::string & name ) const;
+
+   /// @brief
+   /// Reads the gcno and gcda members of an uncompressed tar stream.
+   ///
+   /// @param in The tar stream.
+   ///
+   /// @return success(true), failure(false)
+   bool read( std::istream & in );
+
+private:
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Pairs the gcno members with the gcda members of the same name.
+   void pair_members();
+
+// PRIVATE MEMBERS
+
+   /// The path of the archive.
+   std::string m_path;
+
+   /// Set if the archive could be read to its end.
+   bool m_open;
+
+   /// The gcno and gcda members, by name.
+   std::map< std::string, std::vector<char> > m_members;
+
+   /// The gcno member names, in archive order.
+   std::vector<std::string> m_gcno_names;
+
+   /// The paired gcno and gcda member names.
+   std::vector< std::pair<std::string, std::string> > m_pairs;
+
+}; // End of class Tar_archive
+
+#endif
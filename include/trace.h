@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file trace.h
+///
+///  @brief
+///  Defines the Trace_writer and Trace_reader classes.
+///
+///  @remarks
+///  A parse trace is the binary form of the debug dump of a gcno and gcda
+///  pair. Each event is a tag byte, the offset of the event in the file
+///  being parsed and the fields of the event, numbers as LEB128 varints
+///  and strings as their length followed by their bytes. The events are
+///  packed into a fixed buffer that is written out when full, so tracing
+///  costs no formatting while parsing. The reader formats a trace back
+///  into the text of the debug dump.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TRACE_H
+#define TRACE_H
+
+// SYSTEM INCLUDES
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <cstddef>
+#include <stdint.h>
+
+#include <boost/noncopyable.hpp>
+
+/// @brief
+/// An event of a parse trace.
+struct Trace_event
+{
+   /// The kinds of events. The values are stored in the traces.
+   enum Tag
+   {
+      Pair = 1,
+      Gcno_file,
+      Gcno_function,
+      Gcno_blocks,
+      Gcno_block,
+      Gcno_arcs,
+      Gcno_arc,
+      Gcno_lines,
+      Gcno_line_name,
+      Gcno_line_number,
+      Gcda_file,
+      Gcda_function,
+      Gcda_arcs,
+      Gcda_count,
+      Gcda_object_summary,
+      Gcda_program_summary,
+      Tag_count
+   };
+
+   /// The kind of the event.
+   Tag m_tag;
+
+   /// The offset of the event in the file being parsed.
+   uint64_t m_offset;
+
+   /// The number fields of the event, in order.
+   std::vector<uint64_t> m_numbers;
+
+   /// The string fields of the event, in order.
+   std::vector<std::string> m_strings;
+};
+
+/// @brief
+/// Writes the events of a parse trace to a file.
+class Trace_writer : boost::noncopyable
+{
+public:
+
+// PUBLIC CONSTANTS
+
+   /// The bytes starting every trace.
+   static const char Magic[4];
+
+   /// The size of the buffer the events are packed into.
+   static const std::size_t Buffer_size = 64 * 1024;
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes a writer not tracing to any file.
+   Trace_writer();
+
+   /// @brief
+   /// Writes out the events still buffered.
+   ~Trace_writer();
+
+   /// @brief
+   /// Starts a trace, replacing the file.
+   ///
+   /// @param path The path of the trace file.
+   ///
+   /// @return success(true), failure(false)
+   bool open( const std::string & path );
+
+   /// @brief
+   /// Returns if the writer traces to a file.
+   bool is_open() const
+   {
+      return m_file.is_open();
+   }
+
+   /// @brief
+   /// Writes out the events still buffered and closes the file.
+   void close();
+
+   /// @brief
+   /// Sets the start of the file being parsed, which the offsets of the
+   /// events are relative to.
+   ///
+   /// @param base The first byte of the file.
+   void set_base( const char * base )
+   {
+      m_base = base;
+   }
+
+   /// @brief
+   /// Starts an event. Its fields are added next, in the order of its tag.
+   ///
+   /// @param tag The kind of the event.
+   /// @param position The position of the event in the file being parsed.
+   Trace_writer & event( Trace_event::Tag tag, const char * position );
+
+   /// @brief
+   /// Adds a number field to the event.
+   Trace_writer & number( uint64_t value );
+
+   /// @brief
+   /// Adds a string field to the event.
+   Trace_writer & text( const std::string & value );
+
+private:
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Makes room for a number of bytes in the buffer.
+   void reserve( std::size_t size );
+
+   /// @brief
+   /// Writes out the bytes buffered.
+   void flush();
+
+   /// @brief
+   /// Packs a varint into the buffer, which has room for it.
+   void put_varint( uint64_t value );
+
+// PRIVATE MEMBERS
+
+   /// The trace file.
+   std::ofstream m_file;
+
+   /// The events not written out yet.
+   std::vector<char> m_buffer;
+
+   /// The number of bytes used in m_buffer.
+   std::size_t m_used;
+
+   /// The start of the file being parsed.
+   const char * m_base;
+
+}; // End of class Trace_writer
+
+/// @brief
+/// Reads the events of a parse trace.
+class Trace_reader : boost::noncopyable
+{
+public:
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes the reader of a trace.
+   ///
+   /// @param input The trace, read from its start.
+   explicit Trace_reader( std::istream & input );
+
+   /// @brief
+   /// Reads the next event.
+   ///
+   /// @param event Receives the event.
+   ///
+   /// @return read(true), end of trace or error(false)
+   bool read( Trace_event & event );
+
+   /// @brief
+   /// Returns if the trace was read to its end without an error.
+   bool is_complete() const
+   {
+      return m_complete;
+   }
+
+   /// @brief
+   /// Formats an event as the text of the debug dump.
+   ///
+   /// @param event The event.
+   /// @param out The stream the text is written to.
+   static void write_text( const Trace_event & event, std::ostream & out );
+
+   /// @brief
+   /// Formats a whole trace as the text of the debug dump.
+   ///
+   /// @param out The stream the text is written to.
+   ///
+   /// @return success(true), failure(false)
+   bool write_text( std::ostream & out );
+
+private:
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Reads a varint.
+   ///
+   /// @return success(true), failure(false)
+   bool get_varint( uint64_t & value );
+
+// PRIVATE MEMBERS
+
+   /// The trace.
+   std::istream & m_input;
+
+   /// Set once the magic bytes were read.
+   bool m_started;
+
+   /// Set once the trace was read to its end without an error.
+   bool m_complete;
+
+}; // End of class Trace_reader
+
+#endif
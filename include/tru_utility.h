@@ -56,6 +56,8 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/progress.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include "source_file.h"
 
@@ -63,6 +65,8 @@
 
 namespace fs = boost::filesystem;
 
+class Project_context;
+
 ///////////////////////////////////////////////////////////////////////////////
 ///  @class Tru_Utility
 ///
@@ -173,10 +177,32 @@ class Tru_utility
       ///
       /// @return 
       /// const boolean
+      ///
+      /// @remarks srcFiles is only scanned while no project context is set.
       const bool is_within_project( const std::vector<std::string> &srcFiles,  
                                     const std::string & srcGCNO,
                                     std::string & source_path ) const;
 
+      /// @brief
+      /// Same as above for an interned source file name, which is looked
+      /// up by its id once it has been cached.
+      ///
+      /// @param srcFiles The source files of the project.
+      /// @param source The id of the source file name from the GCNO.
+      /// @param source_path Receives the path of the project source file.
+      const bool is_within_project( const std::vector<std::string> &srcFiles,  
+                                    String_id source,
+                                    std::string & source_path ) const;
+
+      /// @brief
+      /// Sets the index is_within_project looks the source files up in,
+      /// instead of scanning them.
+      ///
+      /// @param project The project context built from the source files
+      /// given to is_within_project.
+      void set_project_context( 
+         const boost::shared_ptr<const Project_context> & project );
+
       /// @brief
       /// 
       /// @param const  string & pathname : path from GCNO
@@ -250,7 +276,7 @@ class Tru_utility
       /// Populates a vector with witht the sorted records.
       void sort_records(
          std::vector<Record *> & list, 
-         std::map<Source_file::Source_key, Record> & records,
+         Source_file::Record_map & records,
          bool sort_line);
 
       /// @brief
@@ -294,7 +320,25 @@ class Tru_utility
       };
       typedef boost::unordered_map<std::string,Cache_value> Cache;
 
+      /// @brief
+      /// Returns the cache entry of a source file name, filling it on
+      /// first use. m_cache_mutex must be held.
+      const Cache_value & find_cache_value( 
+         const std::vector<std::string> &srcFiles,
+         const std::string & srcGCNO ) const;
+
       /// cache lookup for is_within_project
       mutable Cache m_cache;
+
+      /// The entries of m_cache by the id of their source file name, or
+      /// NULL if not cached yet.
+      mutable std::vector<const Cache_value *> m_id_cache;
+
+      /// The index of the project source files, NULL until it is set.
+      boost::shared_ptr<const Project_context> m_project;
+
+      /// Guards m_cache, m_id_cache and m_project, which the parsing 
+      /// threads share.
+      mutable boost::mutex m_cache_mutex;
 };
 #endif
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file work_pool.h
+///
+///  @brief
+///  Defines the Work_pool class.
+///
+///  @remarks
+///  Each worker owns a queue of job indices. A worker takes jobs from the
+///  front of its own queue and, once it runs dry, steals from the back of
+///  the other queues, so a few large jobs do not leave the other workers
+///  idle.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+// SYSTEM INCLUDES
+
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+/// @brief
+/// Runs a fixed list of jobs on a set of work stealing threads.
+class Work_pool : boost::noncopyable
+{
+public:
+
+// PUBLIC TYPES
+
+   /// The function run for each job index.
+   typedef boost::function<void ( std::size_t )> Job;
+
+// PUBLIC METHODS
+
+   /// @brief
+   /// Initializes an idle pool.
+   ///
+   /// @param worker_count The number of threads to run the jobs on.
+   explicit Work_pool( unsigned int worker_count );
+
+   /// @brief
+   /// Waits for the running jobs to complete.
+   ~Work_pool();
+
+   /// @brief
+   /// Deals the jobs round robin to the workers and starts the threads.
+   ///
+   /// @param jobs The job indices, in the order they should be started.
+   /// @param job The function run for each index.
+   void start( const std::vector<std::size_t> & jobs, const Job & job );
+
+   /// @brief
+   /// Waits for every job to complete.
+   void join();
+
+private:
+
+// PRIVATE TYPES
+
+   /// The jobs dealt to one worker.
+   struct Queue
+   {
+      boost::mutex m_mutex;
+      std::deque<std::size_t> m_jobs;
+   };
+
+// PRIVATE METHODS
+
+   /// @brief
+   /// Runs jobs until every queue is empty.
+   void work( unsigned int worker );
+
+   /// @brief
+   /// Takes the next job of a worker, stealing one if its queue is empty.
+   ///
+   /// @return found(true), no jobs left(false)
+   bool take_job( unsigned int worker, std::size_t & job );
+
+// PRIVATE MEMBERS
+
+   /// One queue per worker.
+   std::vector< boost::shared_ptr<Queue> > m_queues;
+
+   /// The running workers.
+   boost::thread_group m_threads;
+
+   /// The function run for each job index.
+   Job m_job;
+
+}; // End of class Work_pool
+
+#endif
@@ -10,7 +10,7 @@ fi
 if [ -e "../output" ]
 then
    echo "Clearing output directory"
-   rm ../output/*.svg ../output/*.dot ../output/*.pdf ../output/*.trucov ../output/*.dump
+   rm ../output/*.svg ../output/*.dot ../output/*.pdf ../output/*.trucov ../output/*.dump ../output/*.trace
 else
    echo "Creating output directory"
    mkdir ../output/
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file arena.cpp
+///
+///  @brief
+///  Implements the Arena class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <cstdlib>
+
+// LOCAL INCLUDES
+
+#include "arena.h"
+
+// CONSTANT DEFINITIONS
+
+const std::size_t Arena::Chunk_size;
+const std::size_t Arena::Alignment;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes an empty arena.
+///////////////////////////////////////////////////////////////////////////////
+Arena::Arena() : m_cursor( &Arena::keep_cursor ), m_reserved( 0 )
+{
+   // void
+} // End of Arena::Arena()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Releases the chunks of the arena and the cursors of the threads.
+///////////////////////////////////////////////////////////////////////////////
+Arena::~Arena()
+{
+   release();
+   for ( std::size_t i = 0; i < m_cursors.size(); ++i )
+   {
+      delete m_cursors[i];
+   }
+} // End of Arena::~Arena()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the arena of the parsed coverage model.
+///////////////////////////////////////////////////////////////////////////////
+Arena & Arena::get_model_arena()
+{
+   static Arena instance;
+   return instance;
+} // End of Arena::get_model_arena()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Allocates memory from the chunk of the calling thread. An allocation
+/// larger than a quarter of a chunk gets a chunk of its own, so it neither
+/// wastes the rest of the current chunk nor takes a new one.
+///
+/// @param size The number of bytes.
+///
+/// @return The memory, aligned to Alignment.
+///////////////////////////////////////////////////////////////////////////////
+void * Arena::allocate( std::size_t size )
+{
+   size = ( size + Alignment - 1 ) & ~( Alignment - 1 );
+   Cursor & cursor = get_cursor();
+   ++cursor.m_allocations;
+   cursor.m_bytes += size;
+
+   if ( size > Chunk_size / 4 )
+   {
+      return reserve( size );
+   }
+
+   if ( static_cast<std::size_t>( cursor.m_end - cursor.m_next ) < size )
+   {
+      cursor.m_next = reserve( Chunk_size );
+      cursor.m_end = cursor.m_next + Chunk_size;
+   }
+
+   void * memory = cursor.m_next;
+   cursor.m_next += size;
+   return memory;
+} // End of Arena::allocate(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Frees all the memory allocated from the arena at once.
+///////////////////////////////////////////////////////////////////////////////
+void Arena::release()
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   for ( std::size_t i = 0; i < m_chunks.size(); ++i )
+   {
+      std::free( m_chunks[i] );
+   }
+   m_chunks.clear();
+   m_reserved = 0;
+
+   for ( std::size_t i = 0; i < m_cursors.size(); ++i )
+   {
+      m_cursors[i]->m_next = NULL;
+      m_cursors[i]->m_end = NULL;
+      m_cursors[i]->m_allocations = 0;
+      m_cursors[i]->m_bytes = 0;
+   }
+} // End of Arena::release()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the usage of the arena since it was last released. The counts
+/// of the threads still allocating may be behind.
+///////////////////////////////////////////////////////////////////////////////
+Arena::Stats Arena::get_stats() const
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   Stats stats;
+   stats.m_allocations = 0;
+   stats.m_bytes = 0;
+   stats.m_chunks = m_chunks.size();
+   stats.m_reserved = m_reserved;
+
+   for ( std::size_t i = 0; i < m_cursors.size(); ++i )
+   {
+      stats.m_allocations += m_cursors[i]->m_allocations;
+      stats.m_bytes += m_cursors[i]->m_bytes;
+   }
+   return stats;
+} // End of Arena::get_stats()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the cursor of the calling thread, creating it on first use.
+///////////////////////////////////////////////////////////////////////////////
+Arena::Cursor & Arena::get_cursor()
+{
+   Cursor * cursor = m_cursor.get();
+   if ( cursor == NULL )
+   {
+      cursor = new Cursor();
+      cursor->m_next = NULL;
+      cursor->m_end = NULL;
+      cursor->m_allocations = 0;
+      cursor->m_bytes = 0;
+
+      boost::mutex::scoped_lock lock( m_mutex );
+      m_cursors.push_back( cursor );
+      m_cursor.reset( cursor );
+   }
+   return *cursor;
+} // End of Arena::get_cursor()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reserves a new chunk.
+///
+/// @param size The size of the chunk.
+///////////////////////////////////////////////////////////////////////////////
+char * Arena::reserve( std::size_t size )
+{
+   char * chunk = static_cast<char *>( std::malloc( size ) );
+   if ( chunk == NULL )
+   {
+      throw std::bad_alloc();
+   }
+
+   boost::mutex::scoped_lock lock( m_mutex );
+   m_chunks.push_back( chunk );
+   m_reserved += size;
+   return chunk;
+} // End of Arena::reserve(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Leaves a cursor to the arena owning it when its thread exits, so the
+/// counts of the thread are kept.
+///////////////////////////////////////////////////////////////////////////////
+void Arena::keep_cursor( Cursor * )
+{
+   // void
+} // End of Arena::keep_cursor(...)
@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file byte_order.cpp
+///
+///  @brief
+///  Implements the byte order helpers of the gcov decoder.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <cstring>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define TRUCOV_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// LOCAL INCLUDES
+
+#include "byte_order.h"
+
+namespace
+{
+
+/// Reverses the int32 halves of a run of int64 values into out.
+typedef void (*Swap_kernel)( const char *, std::size_t, uint64_t * );
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reverses the int32 halves of a run of int64 values one at a time.
+///////////////////////////////////////////////////////////////////////////////
+void swap_run_scalar( const char * first, std::size_t count, uint64_t * out )
+{
+   decode_int64_run_scalar( first, count, false, out );
+}
+
+#ifdef TRUCOV_X86_KERNELS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reverses the int32 halves of a run of int64 values two at a time. The
+/// low int32 stays first, so each reversed pair is already a little endian
+/// int64.
+///////////////////////////////////////////////////////////////////////////////
+__attribute__((target("ssse3")))
+void swap_run_ssse3( const char * first, std::size_t count, uint64_t * out )
+{
+   const __m128i mask = _mm_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+
+   std::size_t i = 0;
+   for ( ; i + 2 <= count; i += 2 )
+   {
+      __m128i words = _mm_loadu_si128(
+         reinterpret_cast<const __m128i *>( first + i * 8 ) );
+      _mm_storeu_si128( reinterpret_cast<__m128i *>( out + i ),
+         _mm_shuffle_epi8( words, mask ) );
+   }
+
+   swap_run_scalar( first + i * 8, count - i, out + i );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reverses the int32 halves of a run of int64 values four at a time.
+///////////////////////////////////////////////////////////////////////////////
+__attribute__((target("avx2")))
+void swap_run_avx2( const char * first, std::size_t count, uint64_t * out )
+{
+   const __m256i mask = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+
+   std::size_t i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      __m256i words = _mm256_loadu_si256(
+         reinterpret_cast<const __m256i *>( first + i * 8 ) );
+      _mm256_storeu_si256( reinterpret_cast<__m256i *>( out + i ),
+         _mm256_shuffle_epi8( words, mask ) );
+   }
+
+   swap_run_scalar( first + i * 8, count - i, out + i );
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Selects the widest kernel the host supports.
+///////////////////////////////////////////////////////////////////////////////
+Swap_kernel select_swap_kernel( const char * & name )
+{
+#ifdef TRUCOV_X86_KERNELS
+   __builtin_cpu_init();
+   if ( __builtin_cpu_supports( "avx2" ) )
+   {
+      name = "avx2";
+      return swap_run_avx2;
+   }
+   if ( __builtin_cpu_supports( "ssse3" ) )
+   {
+      name = "ssse3";
+      return swap_run_ssse3;
+   }
+#endif
+   name = "scalar";
+   return swap_run_scalar;
+}
+
+/// The name of the selected kernel.
+const char * swap_kernel_name = 0;
+
+/// The kernel reversing int64 runs, selected once at start up.
+const Swap_kernel swap_kernel = select_swap_kernel( swap_kernel_name );
+
+} // End of anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes a run of gcov int64 values. Runs that need their bytes reversed
+/// go through the vector kernel, and runs in host order on a little endian
+/// host are copied as is.
+///////////////////////////////////////////////////////////////////////////////
+void decode_int64_run(
+   const char * first,
+   std::size_t count,
+   const bool little_endian,
+   uint64_t * out )
+{
+#ifdef TRUCOV_X86_KERNELS
+   if ( little_endian )
+   {
+      std::memcpy( out, first, count * 8 );
+   }
+   else
+   {
+      swap_kernel( first, count, out );
+   }
+#else
+   decode_int64_run_scalar( first, count, little_endian, out );
+#endif
+} // End of decode_int64_run(...)
+
+///////////////////////////////////////////////////////////////////////////////
+void decode_int64_run_scalar(
+   const char * first,
+   std::size_t count,
+   const bool little_endian,
+   uint64_t * out )
+{
+   for ( std::size_t i = 0; i < count; ++i, first += 8 )
+   {
+      unsigned int low, high;
+      std::memcpy( &low, first, 4 );
+      std::memcpy( &high, first + 4, 4 );
+
+      if ( ! little_endian )
+      {
+         low = swap_int32( low );
+         high = swap_int32( high );
+      }
+      out[i] = static_cast<uint64_t>( low ) | 
+               ( static_cast<uint64_t>( high ) << 32 );
+   }
+} // End of decode_int64_run_scalar(...)
+
+///////////////////////////////////////////////////////////////////////////////
+const char * int64_run_kernel_name()
+{
+   return swap_kernel_name;
+}
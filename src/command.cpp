@@ -36,6 +36,14 @@
 
 #include "command.h"
 
+//  SYSTEM INCLUDES
+
+#include <sys/resource.h>
+
+//  LOCAL INCLUDES
+
+#include "arena.h"
+
 //  USING STATEMENTS
 
 using boost::bind;
@@ -69,6 +77,7 @@ Command::Command()
     command_lookup[Config::Graph] = bind(&Command::do_render, *this);
     command_lookup[Config::Graph_report] = bind(&Command::do_render_report, *this);
     command_lookup[Config::All_report] = bind(&Command::do_all_report, *this);
+    command_lookup[Config::Dump_trace] = bind(&Command::do_dump_trace, *this);
 
 } // End of Command default constructor.
 
@@ -98,16 +107,16 @@ int Command::do_status()
    Parser & parser = Parser::get_instance();
 
    // For all source files. 
-   for ( map<string, Source_file>::const_iterator source_iter =
+   for ( Source_file_map::const_iterator source_iter =
             parser.get_source_files().begin();
          source_iter != parser.get_source_files().end();
          source_iter++ )
    {
-      const map<Source_file::Source_key, Record> & records =
+      const Source_file::Record_map & records =
          source_iter->second.m_records;
 
       // For all functions in a source file.
-      for ( map<Source_file::Source_key, Record>::const_iterator record_it =
+      for ( Source_file::Record_map::const_iterator record_it =
                records.begin();
             record_it != records.end();
             ++record_it )
@@ -121,7 +130,7 @@ int Command::do_status()
             // Output either 0% or 100%
             double percentage = rec.get_coverage_percentage();
             cout << setw(3) << fixed << setprecision(0) 
-                    << percentage * 100 << "% " << rec.m_name_demangled 
+                    << percentage * 100 << "% " << rec.get_name_demangled() 
                     << " no branches\n";
          }
          else
@@ -130,7 +139,7 @@ int Command::do_status()
             double num = rec.get_function_arc_taken();
             double percentage = rec.get_coverage_percentage();
             cout << setw(3) << fixed << setprecision(0) 
-                    << percentage * 100 << "% " << rec.m_name_demangled 
+                    << percentage * 100 << "% " << rec.get_name_demangled() 
                     << " (" << num << "/" << den << ") branches\n";
          } 
       }
@@ -150,22 +159,22 @@ int Command::do_list()
    Parser & parser = Parser::get_instance();
   
    // For all source files. 
-   for ( map<string, Source_file>::const_iterator source_iter =
+   for ( Source_file_map::const_iterator source_iter =
             parser.get_source_files().begin();
          source_iter != parser.get_source_files().end();
          source_iter++ )
    {
-      const map<Source_file::Source_key, Record> & records =
+      const Source_file::Record_map & records =
          source_iter->second.m_records;
 
       // For all functions in a source file.
-      for ( map<Source_file::Source_key, Record>::const_iterator record_it =
+      for ( Source_file::Record_map::const_iterator record_it =
                records.begin();
             record_it != records.end();
             record_it++ )
       {
          // Output function name.
-         cout << record_it->second.m_name_demangled << "\n";
+         cout << record_it->second.get_name_demangled() << "\n";
       }
    }
 
@@ -264,6 +273,32 @@ int Command::do_all_report()
    do_render_report();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Prints the parse traces given as the selection as the text of the debug
+/// dump.
+///
+/// @return success(0), failure(1)
+//////////////////////////////////////////////////////////////////////////////
+int Command::do_dump_trace()
+{
+   const vector<string> & trace_files = 
+      Config::get_instance().get_selection();
+
+   for ( unsigned int i = 0; i < trace_files.size(); ++i )
+   {
+      std::ifstream trace( trace_files[i].c_str(), std::ios::binary );
+      Trace_reader reader( trace );
+      if ( ! trace.is_open() || ! reader.write_text( cout ) )
+      {
+         cerr << "ERROR: Failed to read trace file " << trace_files[i] << endl;
+         return 1;
+      }
+   }
+
+   return 0;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief
 /// Executes the command specified.
@@ -283,9 +318,18 @@ bool Command::do_command( const string & command_name )
         return false;             
     }
 
-    // Parse Gcno files.
+    // Traces are decoded offline, without parsing the build directory.
+    if ( command_name == Config::Dump_trace )
+    {
+        return command_lookup[command_name]() == 0;
+    }
+
+    // Parse Gcno files. Status and list never print line numbers, so
+    // the line records are skipped.
     Parser & ref_parser = Parser::get_instance();
-    if ( !ref_parser.parse_all() )
+    const bool with_lines = 
+        command_name != Config::Status && command_name != Config::List;
+    if ( !ref_parser.parse_all( with_lines ) )
     {
         return false;
     }
@@ -293,6 +337,11 @@ bool Command::do_command( const string & command_name )
     // Execute command.
     command_lookup[command_name]();
 
+    if ( config.get_flag_value(Config::Memory_stats) )
+    {
+        print_memory_stats();
+    }
+
 #ifdef DEBUGFLAG
    if (config.get_flag_value(Config::Secret_gui))
    {
@@ -312,3 +361,24 @@ bool Command::do_command( const string & command_name )
 
 } // End of Command::do_command(...)
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Prints the peak resident set size of the process and the usage of the
+/// arena of the parsed coverage data to stderr.
+///////////////////////////////////////////////////////////////////////////////
+void Command::print_memory_stats() const
+{
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) == 0 )
+    {
+        // Linux reports the peak in kilobytes
+        cerr << "Peak resident set size: " << usage.ru_maxrss << " KB\n";
+    }
+
+    const Arena::Stats stats = Arena::get_model_arena().get_stats();
+    cerr << "Coverage data arena: " << stats.m_allocations 
+         << " allocations, " << stats.m_bytes << " bytes in " 
+         << stats.m_chunks << " chunks of " << stats.m_reserved 
+         << " bytes" << endl;
+} // End of Command::print_memory_stats()
+
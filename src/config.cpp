@@ -32,8 +32,11 @@
 #include <iostream>
 #include <vector>
 
+#include <boost/thread/thread.hpp>
+
 // LOCAL INCLUDES
 #include "config.h"
+#include "tar_archive.h"
 
 // USING STATEMENTS
 
@@ -58,6 +61,7 @@ const string Config::Dot_report = "dot_report";
 const string Config::Graph = "graph";
 const string Config::Graph_report = "graph_report";
 const string Config::All_report = "all_report";
+const string Config::Dump_trace = "dump_trace";
 
 // Initialize the string options. 
 const string Config::Selection = "selection";
@@ -91,6 +95,8 @@ Config::Config()
    m_bool_flag_name[Show_external_inline] = "show-external-inline";
    m_bool_flag_name[Hide_external_inline] = "hide-external-inline";
    m_bool_flag_name[Secret_gui] = "secret-gui";
+   m_bool_flag_name[Spirit_parser] = "spirit-parser";
+   m_bool_flag_name[Memory_stats] = "memory-stats";
 
    m_string_flag_name[Render_format] = "render-format";
    m_string_flag_name[Revision_script] = "revision-script";
@@ -99,6 +105,10 @@ Config::Config()
    m_string_flag_name[Config_file] = "config-file";
    m_string_flag_name[Cache_file] = "cache-file";
    m_string_flag_name[Outfile] = "outfile";
+   m_string_flag_name[Gcda_stream] = "gcda-stream";
+
+   m_number_flag_name[Jobs] = "jobs";
+   m_number_flag_name[Prefetch] = "prefetch";
 
    command = "status";
 }
@@ -138,6 +148,9 @@ bool Config::initialize(po::variables_map var_map, int ac, char* av[])
     sys_utility->change_dir("");
     src_list.clear();
     build_list.clear();
+    gcno_list.clear();
+    archive_list.clear();
+    json_list.clear();
     
     command = Status;
     if (ac > 1 && av[1][0] != '-')
@@ -191,6 +204,18 @@ bool Config::initialize(po::variables_map var_map, int ac, char* av[])
     }
     m_string_flag_value[Revision_script] = rev_script;
 
+    // The gcda stream is read from stdin when given as "-"
+    string gcda_stream;
+    if ( var_map.count(get_flag_name(Gcda_stream)) )
+    {
+        gcda_stream = var_map[get_flag_name(Gcda_stream)].as< string >();
+        if ( gcda_stream != "-" )
+        {
+            gcda_stream = sys_utility->get_abs_path_file(gcda_stream);
+        }
+    }
+    m_string_flag_value[Gcda_stream] = gcda_stream;
+
     string outdir = "."; 
     string outfile;
     if ( var_map.count(get_flag_name(Output)) )
@@ -265,6 +290,18 @@ bool Config::initialize(po::variables_map var_map, int ac, char* av[])
              // store in builddir list
              builddir.push_back( *build_itr );
           }
+          // the path is a coverage bundle, read without extracting it
+          else if ( Tar_archive::is_archive( *build_itr ) &&
+                    fs::is_regular_file( *build_itr ) )
+          {
+             archive_list.push_back( *build_itr );
+          }
+          // the path is a gcov json file
+          else if ( is_gcov_json( *build_itr ) &&
+                    fs::is_regular_file( *build_itr ) )
+          {
+             json_list.push_back( *build_itr );
+          }
           // the path is not a directory
           else
           {
@@ -324,7 +361,29 @@ bool Config::initialize(po::variables_map var_map, int ac, char* av[])
     }
    
     m_bool_flag_value[Secret_gui] = var_map.count(get_flag_name(Secret_gui));  
+    m_bool_flag_value[Spirit_parser] = var_map.count(get_flag_name(Spirit_parser));
+    m_bool_flag_value[Memory_stats] = var_map.count(get_flag_name(Memory_stats));
     m_bool_flag_value[Debug] = var_map.count(get_flag_name(Debug));  
+
+    // Parse serially unless told otherwise, 0 jobs means one per core
+    unsigned int jobs = 1;
+    if ( var_map.count(get_flag_name(Jobs)) )
+    {
+        jobs = var_map[get_flag_name(Jobs)].as<unsigned int>();
+        if ( jobs == 0 )
+        {
+            jobs = std::max( boost::thread::hardware_concurrency(), 1u );
+        }
+    }
+    m_number_flag_value[Jobs] = jobs;
+
+    // Files are read ahead of the parsing, 0 turns the read ahead off
+    m_number_flag_value[Prefetch] = Default_prefetch_window;
+    if ( var_map.count(get_flag_name(Prefetch)) )
+    {
+        m_number_flag_value[Prefetch] = 
+            var_map[get_flag_name(Prefetch)].as<unsigned int>();
+    }
     m_bool_flag_value[Brief] = var_map.count(get_flag_name(Brief));
     m_bool_flag_value[Only_missing] = var_map.count(get_flag_name(Only_missing)); 
     m_bool_flag_value[Signature_match] = var_map.count(get_flag_name(Signature_match));
@@ -431,6 +490,11 @@ string Config::get_flag_value(String_flag flag)
    return m_string_flag_value[flag];
 }
 
+unsigned int Config::get_flag_value(Number_flag flag)
+{
+   return m_number_flag_value[flag];
+}
+
 string Config::get_flag_name(Bool_flag flag)
 {
    return m_bool_flag_name[flag];
@@ -441,6 +505,11 @@ string Config::get_flag_name(String_flag flag)
    return m_string_flag_name[flag];
 }
 
+string Config::get_flag_name(Number_flag flag)
+{
+   return m_number_flag_name[flag];
+}
+
 /// @brief
 /// recursively goes through the file system hierarchy and collect GCNO and GCDA files 
 ///
@@ -496,6 +565,13 @@ void Config::collect_build_files()
              tmp_gcda.push_back(*tmp_itr);
          }
 
+         // file that the iterator is pointing at is a gcov json file
+         else if ( is_gcov_json(*tmp_itr) )
+         {
+             // store in the json list
+             json_list.push_back(*tmp_itr);
+         }
+
          // it is a sub-directory
          else if ( sys_utility->is_dir(*tmp_itr) )
          {
@@ -507,6 +583,9 @@ void Config::collect_build_files()
       }     
    }// end while
 
+   // keep every gcno file for the gcda stream
+   gcno_list = tmp_gcno;
+
    // match tmp_gcno with tmp_gcda
    // create an iterator for tmp_gcno list 
    vector<string>::iterator g_itr = tmp_gcno.begin();
@@ -709,6 +788,33 @@ vector< pair<string, string> > Config::get_build_files()
    return build_list;
 }
 
+/// @brief
+/// getter function for gcno_list
+///
+/// @return const vector< string > &
+const vector<string> & Config::get_gcno_files()
+{
+   return gcno_list;
+}
+
+/// @brief
+/// getter function for archive_list
+///
+/// @return const vector< string > &
+const vector<string> & Config::get_archive_files()
+{
+   return archive_list;
+}
+
+/// @brief
+/// getter function for json_list
+///
+/// @return const vector< string > &
+const vector<string> & Config::get_json_files()
+{
+   return json_list;
+}
+
 /// @brief
 /// getter function for selection
 ///
@@ -755,6 +861,23 @@ const bool Config::is_gcda(string file_name)
    return (file_name == ".gcda");   
 }
 
+/// @brief
+/// Determine whether input is a gcov json file or not
+///
+/// @param file_name file path
+///
+/// @return bool
+const bool Config::is_gcov_json(const string & file_name)
+{
+   const string json = ".gcov.json";
+   const string json_gz = ".gcov.json.gz";
+
+   return ( file_name.size() >= json.size() &&
+            file_name.compare(file_name.size() - json.size(), json.size(), json) == 0 )
+       || ( file_name.size() >= json_gz.size() &&
+            file_name.compare(file_name.size() - json_gz.size(), json_gz.size(), json_gz) == 0 );
+}
+
 const bool Config::is_source_file(const string & file)
 {
    string extension_types[] = 
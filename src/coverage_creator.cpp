@@ -68,14 +68,14 @@ void Coverage_creator::generate_files( Parser & parser )
    cout << setw(3) << fixed << setprecision(0)
         << parser.get_coverage_percentage() * 100 << "% Total" << endl;
    // For each source file
-   for ( map<string, Source_file>::iterator source_iter = 
+   for ( Source_file_map::iterator source_iter = 
             parser.get_source_files().begin();
          source_iter != parser.get_source_files().end();
          source_iter++ )
    {
       // Create shortcut to source file name and records
       const string & source_path = source_iter->second.m_source_path;
-      map<Source_file::Source_key,Record> & records = 
+      Source_file::Record_map & records = 
          source_iter->second.m_records;
       // Create name of coverage file
       const string file_name = ptr_utility->create_file_name( source_path, ".trucov" );
@@ -154,7 +154,7 @@ void Coverage_creator::generate_files( Parser & parser )
               ++i )
          {
             Record & record = *(*i);
-            const string * name = &record.m_name_demangled;
+            const string * name = &record.get_name_demangled();
             if ( config.get_flag_value(Config::Mangle) )
             {
                name = &record.m_name;
@@ -213,7 +213,7 @@ void Coverage_creator::do_func_summary( const Record & rec, const vector<string>
       // Output either 0% or 100%
       double percentage = rec.get_coverage_percentage();
       outfile << setw(3) << fixed << setprecision(0) << percentage * 100 << "% "
-              << rec.m_name_demangled << " no branches\n";
+              << rec.get_name_demangled() << " no branches\n";
    }
    else
    {
@@ -221,20 +221,22 @@ void Coverage_creator::do_func_summary( const Record & rec, const vector<string>
       double num = rec.get_function_arc_taken();
       double percentage = rec.get_coverage_percentage();
       outfile << setw(3) << fixed << setprecision(0) << percentage * 100 << "% "
-              << rec.m_name_demangled << " (" << num << "/" << den << ") branches\n";
+              << rec.get_name_demangled() << " (" << num << "/" << den << ") branches\n";
       
       // If function coverage is not 100%
       Config & config = Config::get_instance();
       if ( !config.get_flag_value(Config::Brief) && num != den )
       {
-         // For each function block
-         for ( unsigned i = 0; i < rec.m_blocks_sorted.size(); ++i )
+         // For each function block, in line order
+         for ( unsigned i = 0; i < rec.m_block_order.size(); ++i )
          {
+            const Block & block = rec.m_blocks[ rec.m_block_order[i] ];
+
             // If block is a branch
-            if ( rec.m_blocks_sorted[i].is_branch() && ! rec.m_blocks_sorted[i].is_fake() )
+            if ( block.is_branch() && ! block.is_fake() )
             {
                // Output branch summary information
-               do_branch_summary( rec, rec.m_blocks_sorted[i], contents, source );
+               do_branch_summary( rec, block, contents, source );
             }
          }
       }
@@ -270,22 +272,22 @@ void Coverage_creator::do_branch_summary( const Record & rec, const Block & bloc
    if ( branch_taken != branch_total )
    {
       // Get block's line information
-      const map<string,Lines_data> & line_data = block.get_lines();
       vector<Line> line_nums;
 
-      for ( map<string,Lines_data>::const_iterator lines_iter = line_data.begin();
-            lines_iter != line_data.end(); ++lines_iter )
+      for ( unsigned k = 0; k < block.get_source_count(); ++k )
       {
-         if ( lines_iter->first == rec.m_source )
+         if ( block.get_source( k ) == rec.m_source )
          {
             // LOOK AT THIS LATER
             // Get non-inlined lines from current source file
-            line_nums = block.get_non_inlined();
+            const Line_list & non_inlined = block.get_non_inlined();
+            line_nums.assign( non_inlined.begin(), non_inlined.end() );
 
             // If no non-inlined lines, get the inlined lines
             if ( line_nums.empty() )
             {
-               line_nums = lines_iter->second.get_lines();
+               const Line_range lines = block.get_lines( k );
+               line_nums.assign( lines.begin(), lines.end() );
             }
             break;
          }
@@ -294,28 +296,22 @@ void Coverage_creator::do_branch_summary( const Record & rec, const Block & bloc
       {
          string source_path;
 
-         for ( map<string,Lines_data>::const_iterator lines_iter = line_data.begin();
-            lines_iter != line_data.end(); ++lines_iter )
+         for ( unsigned k = 0; k < block.get_source_count(); ++k )
          {
             // If lines data is from a source file within the project
-            if ( ptr_utility->is_within_project( config.get_source_files(), lines_iter->first, source_path ) )
+            if ( ptr_utility->is_within_project( config.get_source_files(), block.get_source( k ), source_path ) )
             {
-               line_nums = lines_iter->second.get_lines();
+               const Line_range lines = block.get_lines( k );
+               line_nums.assign( lines.begin(), lines.end() );
                break;
             }
          }
       }
-      if ( line_nums.empty() )
+      if ( line_nums.empty() && block.get_source_count() != 0 )
       {
-         string source_path;
-
-         for ( map<string,Lines_data>::const_iterator lines_iter = line_data.begin();
-            lines_iter != line_data.end(); ++lines_iter )
-         {
-            // Lastly, if lines data is from a source file outside the project
-            line_nums = lines_iter->second.get_lines();
-            break;
-         }
+         // Lastly, if lines data is from a source file outside the project
+         const Line_range lines = block.get_lines( 0 );
+         line_nums.assign( lines.begin(), lines.end() );
       }
 
       unsigned line_no = 0;
@@ -340,7 +336,7 @@ void Coverage_creator::do_branch_summary( const Record & rec, const Block & bloc
       }
 
       // Get block's arcs
-      const vector<Arc> & arcs = block.get_arcs();
+      const Arc_range arcs = block.get_arcs();
 
       // For each arc
       for ( unsigned i = 0; i < arcs.size(); ++i )
@@ -352,22 +348,20 @@ void Coverage_creator::do_branch_summary( const Record & rec, const Block & bloc
             if ( arcs[i].get_count() <= 0 )
             {
                // Output first line of block
-               const map<string,Lines_data> & dest_line_data
-                  = rec.m_blocks[ arcs[i].get_dest() ].get_lines();
+               const Block & dest = rec.m_blocks[ arcs[i].get_dest() ];
                vector<Line> dest_line_nums;
 
-               for ( map<string,Lines_data>::const_iterator lines_iter
-                        = dest_line_data.begin();
-                     lines_iter != dest_line_data.end();
-                     ++lines_iter )
+               for ( unsigned k = 0; k < dest.get_source_count(); ++k )
                {
-                  if ( lines_iter->first == rec.m_source )
+                  if ( dest.get_source( k ) == rec.m_source )
                   {
                      // LOOK AT THIS LATER
-                     dest_line_nums =  rec.m_blocks[ arcs[i].get_dest() ].get_non_inlined();
+                     const Line_list & non_inlined = dest.get_non_inlined();
+                     dest_line_nums.assign( non_inlined.begin(), non_inlined.end() );
                      if ( dest_line_nums.empty() )
                      {
-                        dest_line_nums = lines_iter->second.get_lines();
+                        const Line_range lines = dest.get_lines( k );
+                        dest_line_nums.assign( lines.begin(), lines.end() );
                      }
                      break;
                   }
@@ -376,30 +370,22 @@ void Coverage_creator::do_branch_summary( const Record & rec, const Block & bloc
                {
                   string source_path;
 
-                  for ( map<string,Lines_data>::const_iterator lines_iter
-                           = dest_line_data.begin();
-                        lines_iter != dest_line_data.end();
-                        ++lines_iter )
+                  for ( unsigned k = 0; k < dest.get_source_count(); ++k )
                   {
                      // If lines data is from a source file within the project
-                     if ( ptr_utility->is_within_project( config.get_source_files(), lines_iter->first, source_path ) )
+                     if ( ptr_utility->is_within_project( config.get_source_files(), dest.get_source( k ), source_path ) )
                      {
-                        dest_line_nums = lines_iter->second.get_lines();
+                        const Line_range lines = dest.get_lines( k );
+                        dest_line_nums.assign( lines.begin(), lines.end() );
                         break;
                      }
                   }
                }
-               if ( dest_line_nums.empty() )
+               if ( dest_line_nums.empty() && dest.get_source_count() != 0 )
                {
-                  for ( map<string,Lines_data>::const_iterator lines_iter
-                           = dest_line_data.begin();
-                        lines_iter != dest_line_data.end();
-                        ++lines_iter )
-                  {
-                     // Lastly, if lines data is from a source file outside the project
-                     dest_line_nums = lines_iter->second.get_lines();
-                     break;
-                  }
+                  // Lastly, if lines data is from a source file outside the project
+                  const Line_range lines = dest.get_lines( 0 );
+                  dest_line_nums.assign( lines.begin(), lines.end() );
                }
 
                // Output branch destination data
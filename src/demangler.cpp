@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file demangler.cpp
+///
+///  @brief
+///  Implements the Demangler class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <cstdlib>
+#include <cxxabi.h>
+
+// LOCAL INCLUDES
+
+#include "demangler.h"
+
+// USING STATEMENTS
+
+using std::string;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the single instance shared by the whole process.
+///////////////////////////////////////////////////////////////////////////////
+Demangler & Demangler::get_instance()
+{
+   static Demangler instance;
+   return instance;
+} // End of Demangler::get_instance()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the demangled name of a function.
+///
+/// @param name The mangled name of the function.
+///
+/// @return The demangled name, or the name itself if it is not mangled.
+///////////////////////////////////////////////////////////////////////////////
+const string & Demangler::demangle( const string & name )
+{
+   {
+      boost::mutex::scoped_lock lock( m_mutex );
+      Name_map::const_iterator found = m_names.find( name );
+      if ( found != m_names.end() )
+      {
+         return found->second;
+      }
+   }
+
+   // Demangle without holding the lock, another thread demangling the same
+   // name meanwhile only wastes its work
+   int status;
+   char * buffer = abi::__cxa_demangle( name.c_str(), NULL, NULL, &status );
+   string demangled;
+   if ( buffer != NULL )
+   {
+      demangled.assign( buffer );
+      std::free( buffer );
+   }
+   else
+   {
+      // The name is not mangled, such as the name of a C function
+      demangled = name;
+   }
+
+   boost::mutex::scoped_lock lock( m_mutex );
+   return m_names.insert( std::make_pair( name, demangled ) ).first->second;
+} // End of Demangler::demangle( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the number of names demangled so far.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t Demangler::size() const
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   return m_names.size();
+} // End of Demangler::size()
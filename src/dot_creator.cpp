@@ -85,6 +85,9 @@ Dot_creator::Dot_creator()
    m_bold_block_width = 3.5;
    m_bold_line_width = 2.5;
 
+   // Only render if a render type is set
+   m_render_type = None;
+
 } // End of Dot_creator default constructor
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -137,7 +140,7 @@ void Dot_creator::generate_file( Parser & parser )
               << "   }\n";
 
       // For each source file
-      for ( map<string, Source_file>::const_iterator source_iter = 
+      for ( Source_file_map::const_iterator source_iter = 
                parser.get_source_files().begin();
             source_iter != parser.get_source_files().end();
             ++source_iter )
@@ -148,11 +151,11 @@ void Dot_creator::generate_file( Parser & parser )
                  << ptr_utility->create_file_name( source_path, "" )
                  << "\"{\n";
 
-         const map<Source_file::Source_key,Record> & records
+         const Source_file::Record_map & records
             = source_iter->second.m_records;
 
          // For each record (function)
-         for( map<Source_file::Source_key, Record>::const_iterator it = records.begin();
+         for( Source_file::Record_map::const_iterator it = records.begin();
          it != records.end(); 
          ++it )
          {
@@ -207,7 +210,7 @@ void Dot_creator::generate_files( Parser & parser )
    string output_dir = config.get_flag_value(Config::Output);
 
    // For each source file
-   for ( map<string, Source_file>::iterator source_iter = 
+   for ( Source_file_map::iterator source_iter = 
             parser.get_source_files().begin();
          source_iter != parser.get_source_files().end();
          ++source_iter )
@@ -234,10 +237,10 @@ void Dot_creator::generate_files( Parser & parser )
                     << "<br /> Dashed line = Fake arc / block > color=\"black\" shape=\"box\" ];\n"
                     << "   }\n";
 
-            const map<Source_file::Source_key,Record> & records = 
+            const Source_file::Record_map & records = 
                source_iter->second.m_records;
 
-            for( map<Source_file::Source_key, Record>::const_iterator it = records.begin(); 
+            for( Source_file::Record_map::const_iterator it = records.begin(); 
             it != records.end(); 
             ++it )
             {
@@ -263,16 +266,16 @@ void Dot_creator::generate_files( Parser & parser )
       }
       else // Output per function
       {
-         map<Source_file::Source_key,Record> & records = 
+         Source_file::Record_map & records = 
             source_iter->second.m_records;
 
-         for( map<Source_file::Source_key, Record>::iterator it = records.begin(); 
+         for( Source_file::Record_map::iterator it = records.begin(); 
               it != records.end(); 
               ++it )
          {
             Record & rec = it->second;
 
-            const string * name = &rec.m_name_demangled;
+            const string * name = &rec.get_name_demangled();
             if ( config.get_flag_value(Config::Mangle) )
             {
                name = &rec.m_name;
@@ -448,7 +451,7 @@ void Dot_creator::generate_arcs( const Record & rec )
       if ( ! rec.m_blocks[i].is_fake() || config.get_flag_value(Config::Show_fake) )
       {
          // Get block's arcs
-         const vector<Arc> & arcs = rec.m_blocks[i].get_arcs();
+         const Arc_range arcs = rec.m_blocks[i].get_arcs();
 
          // For each arc in the block
          for ( unsigned j = 0; j < arcs.size(); ++j )
@@ -541,23 +544,23 @@ void Dot_creator::generate_blocks( const Record & rec )
          // except first and last block
          if ( ! block.is_start_block() && ! block.is_end_block() )
          {
-            const map<string,Lines_data> & line_data = block.get_lines();
-
             // Show inlined data if user specifies or if block only has inlined data
             if ( config.get_flag_value(Config::Show_external_inline) 
                || block.is_inlined() )
             {
-               // For each Lines_data entry
-               for ( map<string,Lines_data>::const_iterator lines_iter = line_data.begin();
-                     lines_iter != line_data.end(); ++lines_iter )
+               // For each source file of the block
+               for ( unsigned k = 0; k < block.get_source_count(); ++k )
                {
-                  const vector<Line> & line_nums = lines_iter->second.get_lines();
+                  const Line_range line_nums = block.get_lines( k );
 
                   // Output block's line data
                   if ( ! line_nums.empty() )
                   {
                      // Output source file name that line data is inlined from
-                     outfile << " " << lines_iter->first << ":<br />";
+                     outfile << " " 
+                        << String_table::get_instance().get_string( 
+                           block.get_source( k ) ) 
+                        << ":<br />";
 
                      // If only a single line
                      if ( line_nums.size() == 1 )
@@ -588,13 +591,12 @@ void Dot_creator::generate_blocks( const Record & rec )
             // Show only non-inlined data
             else
             {
-               // For each Lines_data entry
-               for ( map<string,Lines_data>::const_iterator lines_iter = line_data.begin();
-                     lines_iter != line_data.end(); ++lines_iter )
+               // For each source file of the block
+               for ( unsigned k = 0; k < block.get_source_count(); ++k )
                {
-                  if ( lines_iter->first == rec.m_source )
+                  if ( block.get_source( k ) == rec.m_source )
                   {
-                     const vector<Line> & all_line_nums = lines_iter->second.get_lines();
+                     const Line_range all_line_nums = block.get_lines( k );
                      vector<unsigned> line_nums;
 
                      // Fill vector with all non-inlined lines within a block
@@ -664,7 +666,7 @@ void Dot_creator::create_header( const Record & rec )
 
    // Create function header block
    outfile << "      B_Header_" << rec.m_checksum
-           << " [ label=< " << rec.m_source << " <br /> "
+           << " [ label=< " << rec.get_source() << " <br /> "
            << rec.get_HTML_name() << " <br /> "
            << "Exec Count: " << rec.get_execution_count() << " <br /> "
            << "Coverage: " << fixed << setprecision(0) << percentage * 100 << "% "
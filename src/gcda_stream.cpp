@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcda_stream.cpp
+///
+///  @brief
+///  Implements the Gcda_stream class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <cstdlib>
+#include <cerrno>
+
+// LOCAL INCLUDES
+
+#include "gcda_stream.h"
+#include "bounded_read.h"
+
+// USING STATEMENTS
+
+using std::string;
+using std::vector;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads payloads from the given stream.
+///
+/// @param in The stream of framed payloads.
+///////////////////////////////////////////////////////////////////////////////
+Gcda_stream::Gcda_stream( std::istream & in )
+   : m_in( in ),
+     m_failed( false )
+{
+   // void
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the frame line and the bytes of the next payload. The stream may
+/// end before a frame line, but not within a frame.
+///
+/// @return read(true), end of the stream or malformed frame(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcda_stream::next( string & path, vector<char> & payload )
+{
+   if ( m_failed || ! std::getline( m_in, m_line ) )
+   {
+      return false;
+   }
+
+   // The size is followed by a single space and the path
+   const char * first = m_line.c_str();
+   char * size_end;
+   errno = 0;
+   const unsigned long size = std::strtoul( first, &size_end, 10 );
+
+   if ( size_end == first || *size_end != ' ' || errno != 0 
+        || size_end[1] == '\0' )
+   {
+      m_failed = true;
+      return false;
+   }
+   path.assign( size_end + 1 );
+
+   if ( ! read_bounded( m_in, size, payload ) )
+   {
+      m_failed = true;
+      return false;
+   }
+
+   return true;
+} // End of Gcda_stream::next(...)
@@ -0,0 +1,725 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcov_decoder.cpp
+///
+///  @brief
+///  Implements the Gcov_decoder class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// LOCAL INCLUDES
+
+#include "gcov_decoder.h"
+
+// USING STATEMENTS
+
+using std::string;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes the decoder with the builder receiving the parsed data.
+///////////////////////////////////////////////////////////////////////////////
+Gcov_decoder::Gcov_decoder(
+   Parser_builder & parser_builder,
+   const bool is_dump,
+   Trace_writer & trace )
+   : m_gcno_data( parser_builder, is_dump, trace ),
+     m_gcda_data( parser_builder, is_dump, trace ),
+     m_pos( NULL ),
+     m_record_end( NULL ),
+     m_last( NULL ),
+     m_little_endian( true ),
+     m_zero_counters( false )
+{
+   // void
+} // End of Gcov_decoder constructor
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes a whole gcno file: the header followed by any number of records.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::decode_gcno(
+   const char * first,
+   const char * last,
+   const bool little_endian )
+{
+   reset( first, last, little_endian );
+
+   unsigned int magic;
+   if ( ! read_int32( magic ) || magic != Gcno_magic
+        || ! read_int32( m_gcno_data.version )
+        || ! read_int32( m_gcno_data.stamp ) )
+   {
+      return false;
+   }
+
+   switch ( get_layout( m_gcno_data.version ) )
+   {
+      case Layout_3_4:
+         return decode_gcno_records<Gcov_layout_3_4>();
+      case Layout_4_7:
+         return decode_gcno_records<Gcov_layout_4_7>();
+      case Layout_8:
+         return decode_gcno_records<Gcov_layout_8>();
+      case Layout_9:
+         return decode_gcno_records<Gcov_layout_9>();
+      default:
+         return decode_gcno_records<Gcov_layout_12>();
+   }
+} // End of Gcov_decoder::decode_gcno(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the rest of the gcno header and the records of the file.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::decode_gcno_records()
+{
+   unsigned int ignored;
+   string cwd;
+   if ( ( LayoutT::Header_checksum && ! read_int32( ignored ) )
+        || ( LayoutT::Header_cwd && ! read_string<LayoutT>( cwd ) )
+        || ( LayoutT::Unexecuted_flag && ! read_int32( ignored ) ) )
+   {
+      return false;
+   }
+   gcno_action_gcnofile().act( m_gcno_data, m_pos, m_pos );
+
+   while ( m_pos != m_last )
+   {
+      unsigned int tag;
+      unsigned int length;
+      if ( ! read_header<LayoutT>( tag, length ) )
+      {
+         return false;
+      }
+
+      // Records of unknown tags and of unselected functions are skipped by
+      // their length
+      bool decoded = true;
+      switch ( tag )
+      {
+         case Tag_function:
+            decoded = decode_gcno_function<LayoutT>( length );
+            break;
+         case Tag_blocks:
+            if ( wants_function_body() )
+            {
+               decoded = decode_blocks<LayoutT>( length );
+            }
+            break;
+         case Tag_arcs:
+            if ( wants_function_body() )
+            {
+               decoded = decode_arcs( length );
+            }
+            break;
+         case Tag_lines:
+            if ( wants_function_lines() )
+            {
+               decoded = decode_lines<LayoutT>( length );
+            }
+            break;
+      }
+
+      if ( ! decoded )
+      {
+         return false;
+      }
+
+      // Continue after the record, whatever padding it may contain
+      m_pos = m_record_end;
+   }
+
+   return true;
+} // End of Gcov_decoder::decode_gcno_records()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes a whole gcda file: the header followed by any number of records
+/// and an optional zero terminator.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::decode_gcda(
+   const char * first,
+   const char * last,
+   const bool little_endian )
+{
+   reset( first, last, little_endian );
+
+   unsigned int magic;
+   if ( ! read_int32( magic ) || magic != Gcda_magic
+        || ! read_int32( m_gcda_data.version )
+        || ! read_int32( m_gcda_data.stamp ) )
+   {
+      return false;
+   }
+
+   switch ( get_layout( m_gcda_data.version ) )
+   {
+      case Layout_3_4:
+         return decode_gcda_records<Gcov_layout_3_4>();
+      case Layout_4_7:
+         return decode_gcda_records<Gcov_layout_4_7>();
+      case Layout_8:
+         return decode_gcda_records<Gcov_layout_8>();
+      case Layout_9:
+         return decode_gcda_records<Gcov_layout_9>();
+      default:
+         return decode_gcda_records<Gcov_layout_12>();
+   }
+} // End of Gcov_decoder::decode_gcda(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the rest of the gcda header and the records of the file.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::decode_gcda_records()
+{
+   unsigned int ignored;
+   if ( LayoutT::Header_checksum && ! read_int32( ignored ) )
+   {
+      return false;
+   }
+   gcda_action_gcdafile().act( m_gcda_data, m_pos, m_pos );
+
+   while ( m_pos != m_last )
+   {
+      unsigned int tag;
+      unsigned int length;
+      if ( ! read_header<LayoutT>( tag, length ) )
+      {
+         return false;
+      }
+
+      // A zero tag marks the end of the file
+      if ( tag == 0 )
+      {
+         return true;
+      }
+
+      // Records of unknown tags, counters of unselected functions and
+      // summaries that are not dumped are skipped by their length
+      bool decoded = true;
+      switch ( tag )
+      {
+         case Tag_function:
+            decoded = decode_gcda_function<LayoutT>( length );
+            break;
+         case Tag_counter_base:
+            if ( wants_counters() )
+            {
+               decoded = decode_counters( length );
+            }
+            break;
+         case Tag_object_summary:
+            if ( LayoutT::Count_summaries && m_gcda_data.is_dump )
+            {
+               decoded = decode_object_summary( length );
+            }
+            break;
+         case Tag_program_summary:
+            if ( LayoutT::Count_summaries && m_gcda_data.is_dump )
+            {
+               decoded = decode_program_summary( length );
+            }
+            break;
+      }
+
+      if ( ! decoded )
+      {
+         return false;
+      }
+
+      m_pos = m_record_end;
+   }
+
+   return true;
+} // End of Gcov_decoder::decode_gcda_records()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the gcc release that wrote a file, as major * 100 + minor. The
+/// version word holds ASCII digits from its most significant byte, and
+/// majors past 9 are written as a letter followed by a digit: "403*" is
+/// 4.3, "A93*" is 9.3 written the new way and "B22*" is 12.2.
+///////////////////////////////////////////////////////////////////////////////
+unsigned int Gcov_decoder::get_gcc_release( unsigned int version )
+{
+   const unsigned int v0 = ( version >> 24 ) & 0xFF;
+   const unsigned int v1 = ( version >> 16 ) & 0xFF;
+   const unsigned int v2 = ( version >> 8 ) & 0xFF;
+
+   if ( v0 >= 'A' )
+   {
+      return ( ( v0 - 'A' ) * 10 + ( v1 - '0' ) ) * 100 + ( v2 - '0' );
+   }
+
+   return ( v0 - '0' ) * 100 + ( v1 - '0' ) * 10 + ( v2 - '0' );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the layout of the files of a version word.
+///////////////////////////////////////////////////////////////////////////////
+Gcov_decoder::Layout Gcov_decoder::get_layout( unsigned int version )
+{
+   const unsigned int release = get_gcc_release( version );
+
+   if ( release < 407 )
+   {
+      return Layout_3_4;
+   }
+   if ( release < 800 )
+   {
+      return Layout_4_7;
+   }
+   if ( release < 900 )
+   {
+      return Layout_8;
+   }
+   if ( release < 1200 )
+   {
+      return Layout_9;
+   }
+   return Layout_12;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Positions the decoder at the start of a buffer.
+///////////////////////////////////////////////////////////////////////////////
+void Gcov_decoder::reset(
+   const char * first,
+   const char * last,
+   const bool little_endian )
+{
+   m_pos = first;
+   m_record_end = last;
+   m_last = last;
+   m_little_endian = little_endian;
+   m_zero_counters = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads an int32 if one is left in the current record.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::read_int32( unsigned int & value )
+{
+   if ( words_left() < 1 )
+   {
+      return false;
+   }
+
+   value = next_int32();
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads an int64 if one is left in the current record.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::read_int64( uint64_t & value )
+{
+   if ( words_left() < 2 )
+   {
+      return false;
+   }
+
+   value = next_int64();
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads a string stored as its length followed by the null terminated
+/// characters and, before gcc 12, their padding.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::read_string( string & value )
+{
+   unsigned int length;
+
+   return read_int32( length ) && read_string_data<LayoutT>( length, value );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the characters of a string whose length, in int32 words or in
+/// bytes, has already been read, dropping the null terminator and padding.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::read_string_data( unsigned int length, string & value )
+{
+   const std::size_t size = LayoutT::Byte_lengths ? length 
+      : std::size_t( length ) * int32_size;
+
+   if ( std::size_t( m_record_end - m_pos ) < size )
+   {
+      return false;
+   }
+
+   value.assign( m_pos, strnlen( m_pos, size ) );
+   m_pos += size;
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the tag and length of the next record and bounds the record so no
+/// field can be read past its end. A zero tag has no length. From gcc 12 the
+/// length counts bytes, and a negative counter length stands for a run of
+/// zero counters that are not written out.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::read_header( unsigned int & tag, unsigned int & length )
+{
+   m_record_end = m_last;
+   m_zero_counters = false;
+   length = 0;
+
+   if ( ! read_int32( tag ) )
+   {
+      return false;
+   }
+
+   if ( tag == 0 )
+   {
+      m_record_end = m_pos;
+      return true;
+   }
+
+   if ( ! read_int32( length ) )
+   {
+      return false;
+   }
+
+   if ( LayoutT::Zero_counters && tag == Tag_counter_base 
+        && static_cast<int>( length ) < 0 )
+   {
+      m_zero_counters = true;
+      length = ( 0 - length ) / int32_size;
+      m_record_end = m_pos;
+      return true;
+   }
+
+   const std::size_t size = LayoutT::Byte_lengths ? length 
+      : std::size_t( length ) * int32_size;
+
+   if ( std::size_t( m_last - m_pos ) < size )
+   {
+      return false;
+   }
+
+   m_record_end = m_pos + size;
+   if ( LayoutT::Byte_lengths )
+   {
+      length /= int32_size;
+   }
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the ident, checksum, name, source and line of a gcno function.
+/// The cfg checksum, artificial flag and the end of the function, when the
+/// layout has them, are read past.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::decode_gcno_function( unsigned int length )
+{
+   m_gcno_data.rLength = length;
+
+   unsigned int ignored;
+   if ( ! read_int32( m_gcno_data.rIdent )
+        || ! read_int32( m_gcno_data.rChecksum )
+        || ( LayoutT::Cfg_checksum && ! read_int32( ignored ) )
+        || ! read_string<LayoutT>( m_gcno_data.rName )
+        || ( LayoutT::Function_extents && ! read_int32( ignored ) )
+        || ! read_string<LayoutT>( m_gcno_data.rSource )
+        || ! read_int32( m_gcno_data.rLineno ) )
+   {
+      return false;
+   }
+
+   gcno_action_AnnounceFunction().act( m_gcno_data, m_pos, m_pos );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the flags of every basic block of the current function. From
+/// gcc 8 only the number of blocks is written, and their flags are clear.
+///
+/// @return success(true), failure or implausible block count(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::decode_blocks( unsigned int length )
+{
+   unsigned int blocks = length;
+   if ( LayoutT::Block_count && ! read_int32( blocks ) )
+   {
+      return false;
+   }
+
+   // GCC always writes an entry and an exit block
+   if ( blocks < 2 || blocks > Max_blocks
+        || ( ! LayoutT::Block_count && words_left() < blocks ) )
+   {
+      return false;
+   }
+
+   m_gcno_data.bLength = blocks;
+   m_gcno_data.blocks = blocks - 1;
+   gcno_action_BasicBlocks().act( m_gcno_data, m_pos, m_pos );
+
+   gcno_action_bFlags store_flags;
+   for ( m_gcno_data.bIteration = 0;
+         m_gcno_data.bIteration < blocks;
+         ++m_gcno_data.bIteration )
+   {
+      m_gcno_data.bFlags = LayoutT::Block_count ? 0 : next_int32();
+      store_flags.act( m_gcno_data, m_pos, m_pos );
+   }
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the source block and the destination / flag pairs of its arcs.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::decode_arcs( unsigned int length )
+{
+   m_gcno_data.aLength = length / 2;
+
+   if ( ! read_int32( m_gcno_data.aBlockno )
+        || words_left() < m_gcno_data.aLength * 2 )
+   {
+      return false;
+   }
+   gcno_action_Arcs().act( m_gcno_data, m_pos, m_pos );
+
+   gcno_action_Arc store_arc;
+   for ( unsigned int i = 0; i < m_gcno_data.aLength; ++i )
+   {
+      m_gcno_data.aDestBlock = next_int32();
+      m_gcno_data.aFlags = next_int32();
+      store_arc.act( m_gcno_data, m_pos, m_pos );
+   }
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the line numbers of a block. A zero word introduces a file name,
+/// and a zero word followed by an empty name ends the list.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::decode_lines( unsigned int length )
+{
+   m_gcno_data.lLength = length;
+
+   if ( ! read_int32( m_gcno_data.lBlockno ) )
+   {
+      return false;
+   }
+   gcno_action_Lines().act( m_gcno_data, m_pos, m_pos );
+
+   gcno_action_lLineno store_line;
+   unsigned int word;
+   while ( read_int32( word ) )
+   {
+      if ( word != 0 )
+      {
+         m_gcno_data.lLineno = word;
+         store_line.act( m_gcno_data, m_pos, m_pos );
+      }
+      else
+      {
+         // A file name of zero length ends the line list
+         unsigned int name_length;
+         if ( ! read_int32( name_length ) )
+         {
+            return false;
+         }
+         if ( name_length == 0 )
+         {
+            return true;
+         }
+
+         if ( ! read_string_data<LayoutT>( name_length, m_gcno_data.lName ) )
+         {
+            return false;
+         }
+         gcno_action_lName().act( m_gcno_data, m_pos, m_pos );
+      }
+   }
+
+   // The line list must be terminated
+   return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the ident and checksum of a gcda function. An empty record stands
+/// for a function that was not emitted, whose counters must not be stored.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+template <typename LayoutT>
+bool Gcov_decoder::decode_gcda_function( unsigned int length )
+{
+   m_gcda_data.rLength = length;
+
+   if ( length == 0 )
+   {
+      m_gcda_data.rIdent = 0;
+      m_gcda_data.rChecksum = 0;
+      return true;
+   }
+
+   unsigned int ignored;
+   if ( ! read_int32( m_gcda_data.rIdent )
+        || ! read_int32( m_gcda_data.rChecksum )
+        || ( LayoutT::Cfg_checksum && ! read_int32( ignored ) ) )
+   {
+      return false;
+   }
+
+   gcda_action_AnnounceFunction().act( m_gcda_data, m_pos, m_pos );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the int64 arc counters of the current function.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::decode_counters( unsigned int length )
+{
+   m_gcda_data.aLength = length / 2;
+   gcda_action_aLength().act( m_gcda_data, m_pos, m_pos );
+
+   // Stores the counters as one run rather than one call per counter
+   std::vector<uint64_t> & counts = m_gcda_data.counts;
+   if ( m_zero_counters )
+   {
+      counts.assign( m_gcda_data.aLength, 0 );
+   }
+   else
+   {
+      counts.resize( m_gcda_data.aLength );
+      if ( ! counts.empty() )
+      {
+         decode_int64_run( m_pos, counts.size(), m_little_endian, &counts[0] );
+         m_pos += counts.size() * 2 * int32_size;
+      }
+   }
+   gcda_action_Counts().act( m_gcda_data, m_pos, m_pos );
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the object summary.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::decode_object_summary( unsigned int length )
+{
+   // checksum, counts, runs and three int64 values
+   if ( words_left() < 9 )
+   {
+      return false;
+   }
+
+   m_gcda_data.oLength   = length;
+   m_gcda_data.oChecksum = next_int32();
+   m_gcda_data.oCounts   = next_int32();
+   m_gcda_data.oRuns     = next_int32();
+   m_gcda_data.oSumall   = next_int64();
+   m_gcda_data.oRunmax   = next_int64();
+   m_gcda_data.oSummax   = next_int64();
+
+   gcda_action_ObjectSummary().act( m_gcda_data, m_pos, m_pos );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes a program summary.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_decoder::decode_program_summary( unsigned int length )
+{
+   // checksum, counts, runs and three int64 values
+   if ( words_left() < 9 )
+   {
+      return false;
+   }
+
+   m_gcda_data.pLength   = length;
+   m_gcda_data.pChecksum = next_int32();
+   m_gcda_data.pCounts   = next_int32();
+   m_gcda_data.pRuns     = next_int32();
+   m_gcda_data.pSumall   = next_int64();
+   m_gcda_data.pRunmax   = next_int64();
+   m_gcda_data.pSummax   = next_int64();
+
+   gcda_action_ProgramSummary().act( m_gcda_data, m_pos, m_pos );
+   return true;
+}
@@ -0,0 +1,613 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcov_json_decoder.cpp
+///
+///  @brief
+///  Implements the Gcov_json_decoder class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <cstdlib>
+
+#include <boost/functional/hash.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+
+// LOCAL INCLUDES
+
+#include "gcov_json_decoder.h"
+
+// USING STATEMENTS
+
+using std::string;
+using std::vector;
+using std::map;
+
+namespace io = boost::iostreams;
+
+// CONSTANTS
+
+namespace
+{
+   /// The flag of a fake arc.
+   const unsigned int Fake_arc = 2;
+   /// The flag of a fallthrough arc.
+   const unsigned int Fallthrough_arc = 4;
+
+   /// @brief
+   /// Returns if a string ends with the given suffix.
+   bool ends_with( const string & text, const string & suffix )
+   {
+      return text.size() >= suffix.size() &&
+         text.compare( text.size() - suffix.size(), suffix.size(), 
+            suffix ) == 0;
+   }
+
+   /// @brief
+   /// Orders lines by number.
+   template <typename LineT>
+   bool line_before( const LineT & lhs, const LineT & rhs )
+   {
+      return lhs.m_line_number < rhs.m_line_number;
+   }
+}
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes the decoder with the builder receiving the parsed data.
+///
+/// @param parser_builder The builder of the data structure.
+///////////////////////////////////////////////////////////////////////////////
+Gcov_json_decoder::Gcov_json_decoder( Parser_builder & parser_builder )
+   : m_parser_builder( parser_builder )
+{
+   // void
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes a whole JSON text.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::decode( std::istream & in )
+{
+   m_contexts.clear();
+   m_functions.clear();
+   m_lines.clear();
+
+   Json_reader reader( in );
+   return reader.read( *this );
+} // End of Gcov_json_decoder::decode(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes a gcov JSON file, decompressing it while it is read if its name
+/// ends with ".gz".
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::decode_file( const string & path )
+{
+   std::ifstream file( path.c_str(), std::ios::in | std::ios::binary );
+   if ( ! file )
+   {
+      return false;
+   }
+
+   if ( ! ends_with( path, ".gz" ) )
+   {
+      return decode( file );
+   }
+
+   io::filtering_istream in;
+   in.push( io::gzip_decompressor() );
+   in.push( file );
+
+   try
+   {
+      return decode( in );
+   }
+   catch ( const io::gzip_error & )
+   {
+      return false;
+   }
+} // End of Gcov_json_decoder::decode_file(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Enters a container. Only the files, functions, lines and branches are
+/// followed; any other container is ignored with all it holds.
+///////////////////////////////////////////////////////////////////////////////
+void Gcov_json_decoder::enter( bool is_object )
+{
+   Context context = Ignored;
+
+   if ( m_contexts.empty() )
+   {
+      context = is_object ? Root : Ignored;
+   }
+   else
+   {
+      switch ( m_contexts.back() )
+      {
+         case Root:
+            if ( ! is_object && m_key == "files" )
+            {
+               context = Files;
+            }
+            break;
+
+         case Files:
+            if ( is_object )
+            {
+               context = File;
+               m_file.clear();
+               m_functions.clear();
+               m_lines.clear();
+            }
+            break;
+
+         case File:
+            if ( ! is_object && m_key == "functions" )
+            {
+               context = Functions;
+            }
+            else if ( ! is_object && m_key == "lines" )
+            {
+               context = Lines;
+            }
+            break;
+
+         case Functions:
+            if ( is_object )
+            {
+               context = Function;
+               m_functions.push_back( Json_function() );
+               m_functions.back().m_start_line = 0;
+               m_functions.back().m_end_line = 0;
+               m_functions.back().m_execution_count = 0;
+            }
+            break;
+
+         case Lines:
+            if ( is_object )
+            {
+               context = Line;
+               m_lines.push_back( Json_line() );
+               m_lines.back().m_line_number = 0;
+               m_lines.back().m_count = 0;
+            }
+            break;
+
+         case Line:
+            if ( ! is_object && m_key == "branches" )
+            {
+               context = Branches;
+            }
+            break;
+
+         case Branches:
+            if ( is_object )
+            {
+               context = Branch;
+               Json_branch branch = { 0, false };
+               m_lines.back().m_branches.push_back( branch );
+            }
+            break;
+
+         default:
+            break;
+      }
+   }
+
+   m_contexts.push_back( context );
+} // End of Gcov_json_decoder::enter(...)
+
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::start_object()
+{
+   enter( true );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Leaves an object, storing the source file it held if any.
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::end_object()
+{
+   const Context context = m_contexts.back();
+   m_contexts.pop_back();
+
+   if ( context == File )
+   {
+      store_file();
+   }
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::start_array()
+{
+   enter( false );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::end_array()
+{
+   m_contexts.pop_back();
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::key( const string & name )
+{
+   m_key = name;
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Stores the source file name, the function names and the function of
+/// each line.
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::string_value( const string & value )
+{
+   if ( m_contexts.empty() )
+   {
+      return true;
+   }
+
+   switch ( m_contexts.back() )
+   {
+      case File:
+         if ( m_key == "file" )
+         {
+            m_file = value;
+         }
+         break;
+
+      case Function:
+         if ( m_key == "name" )
+         {
+            m_functions.back().m_name = value;
+         }
+         break;
+
+      case Line:
+         if ( m_key == "function_name" )
+         {
+            m_lines.back().m_function_name = value;
+         }
+         break;
+
+      default:
+         break;
+   }
+   return true;
+} // End of Gcov_json_decoder::string_value(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Stores the line numbers and the counts.
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::number_value( const string & text )
+{
+   if ( m_contexts.empty() )
+   {
+      return true;
+   }
+
+   switch ( m_contexts.back() )
+   {
+      case Function:
+         if ( m_key == "start_line" )
+         {
+            m_functions.back().m_start_line = to_count( text );
+         }
+         else if ( m_key == "end_line" )
+         {
+            m_functions.back().m_end_line = to_count( text );
+         }
+         else if ( m_key == "execution_count" )
+         {
+            m_functions.back().m_execution_count = to_count( text );
+         }
+         break;
+
+      case Line:
+         if ( m_key == "line_number" )
+         {
+            m_lines.back().m_line_number = to_count( text );
+         }
+         else if ( m_key == "count" )
+         {
+            m_lines.back().m_count = to_count( text );
+         }
+         break;
+
+      case Branch:
+         if ( m_key == "count" )
+         {
+            m_lines.back().m_branches.back().m_count = to_count( text );
+         }
+         break;
+
+      default:
+         break;
+   }
+   return true;
+} // End of Gcov_json_decoder::number_value(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Stores the kind of each branch.
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::bool_value( bool value )
+{
+   if ( ! m_contexts.empty() && m_contexts.back() == Branch )
+   {
+      if ( m_key == "fallthrough" )
+      {
+         m_lines.back().m_branches.back().m_fallthrough = value;
+      }
+   }
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool Gcov_json_decoder::null_value()
+{
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Stores the functions of the source file just read. Each line belongs to
+/// the function it names, or, when gcov does not name it, to the first
+/// function whose lines hold it.
+///////////////////////////////////////////////////////////////////////////////
+void Gcov_json_decoder::store_file()
+{
+   std::stable_sort( m_lines.begin(), m_lines.end(), 
+      line_before<Json_line> );
+
+   map<string, size_t> by_name;
+   for ( size_t i = 0; i < m_functions.size(); ++i )
+   {
+      by_name.insert( std::make_pair( m_functions[i].m_name, i ) );
+   }
+
+   vector< vector<const Json_line *> > function_lines( m_functions.size() );
+   for ( size_t i = 0; i < m_lines.size(); ++i )
+   {
+      const Json_line & line = m_lines[i];
+
+      if ( ! line.m_function_name.empty() )
+      {
+         map<string, size_t>::const_iterator found = 
+            by_name.find( line.m_function_name );
+         if ( found != by_name.end() )
+         {
+            function_lines[ found->second ].push_back( &line );
+         }
+         continue;
+      }
+
+      for ( size_t j = 0; j < m_functions.size(); ++j )
+      {
+         if ( m_functions[j].m_start_line <= line.m_line_number &&
+              line.m_line_number <= m_functions[j].m_end_line )
+         {
+            function_lines[j].push_back( &line );
+            break;
+         }
+      }
+   }
+
+   for ( size_t i = 0; i < m_functions.size(); ++i )
+   {
+      store_function( m_functions[i], function_lines[i] );
+   }
+
+   m_functions.clear();
+   m_lines.clear();
+} // End of Gcov_json_decoder::store_file()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Builds the graph of a function from its lines and stores it into the
+/// builder, with one count for each arc in block order.
+///////////////////////////////////////////////////////////////////////////////
+void Gcov_json_decoder::store_function( 
+   const Json_function & function,
+   const vector<const Json_line *> & lines )
+{
+   const size_t line_count = lines.size();
+
+   // Number the blocks: the entry, each line followed by its branch
+   // targets, the fake block making up the line counts and the exit
+   vector<unsigned int> line_block( line_count );
+   vector<unsigned int> target_count( line_count, 0 );
+   unsigned int block_count = 1;
+   std::size_t checksum = 0;
+   boost::hash_combine( checksum, function.m_name );
+
+   for ( size_t i = 0; i < line_count; ++i )
+   {
+      const vector<Json_branch> & branches = lines[i]->m_branches;
+
+      boost::hash_combine( checksum, lines[i]->m_line_number );
+      boost::hash_combine( checksum, branches.size() );
+      for ( size_t j = 0; j < branches.size(); ++j )
+      {
+         boost::hash_combine( checksum, branches[j].m_fallthrough );
+      }
+
+      line_block[i] = block_count++;
+      if ( branches.size() >= 2 )
+      {
+         target_count[i] = branches.size();
+         block_count += branches.size();
+      }
+   }
+
+   const unsigned int fake_block = line_count != 0 ? block_count++ : 0;
+   const unsigned int exit_block = block_count++;
+
+   vector< vector<Graph_arc> > arcs( block_count );
+   // The count reaching each line through the arcs that are not fake
+   vector<uint64_t> reached( line_count, 0 );
+
+   if ( line_count == 0 )
+   {
+      Graph_arc arc = { exit_block, 0, function.m_execution_count };
+      arcs[0].push_back( arc );
+   }
+   else
+   {
+      // The fake arc only keeps the fake block from being a start block
+      Graph_arc arc = { line_block[0], 0, function.m_execution_count };
+      Graph_arc fake = { fake_block, Fake_arc, 0 };
+      arcs[0].push_back( arc );
+      arcs[0].push_back( fake );
+      reached[0] = function.m_execution_count;
+   }
+
+   for ( size_t i = 0; i < line_count; ++i )
+   {
+      const Json_line & line = *lines[i];
+      const unsigned int next = 
+         i + 1 == line_count ? exit_block : line_block[i + 1];
+      uint64_t passed = 0;
+
+      if ( target_count[i] == 0 )
+      {
+         // A single branch is the arc to the next line
+         const bool fallthrough = ! line.m_branches.empty() && 
+            line.m_branches[0].m_fallthrough;
+         Graph_arc arc = { next, fallthrough ? Fallthrough_arc : 0,
+            line.m_count };
+         arcs[ line_block[i] ].push_back( arc );
+         passed = line.m_count;
+      }
+
+      for ( unsigned int j = 0; j < target_count[i]; ++j )
+      {
+         const Json_branch & branch = line.m_branches[j];
+         const unsigned int target = line_block[i] + 1 + j;
+
+         Graph_arc arc = { target, 
+            branch.m_fallthrough ? Fallthrough_arc : 0, branch.m_count };
+         Graph_arc pass = { next, 0, branch.m_count };
+         arcs[ line_block[i] ].push_back( arc );
+         arcs[target].push_back( pass );
+         passed += branch.m_count;
+      }
+
+      if ( i + 1 != line_count )
+      {
+         reached[i + 1] = passed;
+      }
+   }
+
+   // The difference may be negative, stored as its two's complement as
+   // the counts are read back as signed
+   for ( size_t i = 0; i < line_count; ++i )
+   {
+      Graph_arc arc = { line_block[i], Fake_arc, 
+         lines[i]->m_count - reached[i] };
+      arcs[fake_block].push_back( arc );
+   }
+
+   // Store the graph as the gcno and gcda records would
+   const unsigned int rChecksum = static_cast<unsigned int>( checksum );
+   m_parser_builder.store_record( 0, rChecksum, m_file, function.m_name,
+      function.m_start_line );
+   if ( ! m_parser_builder.is_last_record_selected() )
+   {
+      return;
+   }
+
+   if ( m_parser_builder.wants_last_structure() )
+   {
+      for ( unsigned int block = 0; block < block_count; ++block )
+      {
+         m_parser_builder.store_blocks( 0, 0, block );
+      }
+      for ( unsigned int block = 0; block < block_count; ++block )
+      {
+         for ( size_t j = 0; j < arcs[block].size(); ++j )
+         {
+            m_parser_builder.store_arcs( block, arcs[block][j].m_dest,
+               arcs[block][j].m_flags );
+         }
+      }
+   }
+
+   if ( m_parser_builder.wants_last_lines() )
+   {
+      for ( size_t i = 0; i < line_count; ++i )
+      {
+         for ( unsigned int block = line_block[i]; 
+               block <= line_block[i] + target_count[i]; ++block )
+         {
+            m_parser_builder.store_line_number( block, 
+               lines[i]->m_line_number, m_file );
+         }
+      }
+   }
+
+   vector<uint64_t> counts;
+   for ( unsigned int block = 0; block < block_count; ++block )
+   {
+      for ( size_t j = 0; j < arcs[block].size(); ++j )
+      {
+         counts.push_back( arcs[block][j].m_count );
+      }
+   }
+   m_parser_builder.store_counts( 0, rChecksum, &counts[0], counts.size() );
+} // End of Gcov_json_decoder::store_function(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Converts the text of a number to an unsigned count.
+///////////////////////////////////////////////////////////////////////////////
+uint64_t Gcov_json_decoder::to_count( const string & text )
+{
+   if ( text.empty() || text[0] == '-' )
+   {
+      return 0;
+   }
+   return std::strtoull( text.c_str(), NULL, 10 );
+} // End of Gcov_json_decoder::to_count(...)
@@ -0,0 +1,429 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file json_reader.cpp
+///
+///  @brief
+///  Implements the Json_reader class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// LOCAL INCLUDES
+
+#include "json_reader.h"
+
+// USING STATEMENTS
+
+using std::string;
+
+// CONSTANTS
+
+namespace
+{
+   /// The size of the chunks read from the stream.
+   const std::size_t Chunk_size = 64 * 1024;
+
+   /// @brief
+   /// Appends a code point to a string as UTF-8.
+   void append_utf8( string & text, unsigned int code )
+   {
+      if ( code < 0x80 )
+      {
+         text += static_cast<char>( code );
+      }
+      else if ( code < 0x800 )
+      {
+         text += static_cast<char>( 0xC0 | ( code >> 6 ) );
+         text += static_cast<char>( 0x80 | ( code & 0x3F ) );
+      }
+      else if ( code < 0x10000 )
+      {
+         text += static_cast<char>( 0xE0 | ( code >> 12 ) );
+         text += static_cast<char>( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+         text += static_cast<char>( 0x80 | ( code & 0x3F ) );
+      }
+      else
+      {
+         text += static_cast<char>( 0xF0 | ( code >> 18 ) );
+         text += static_cast<char>( 0x80 | ( ( code >> 12 ) & 0x3F ) );
+         text += static_cast<char>( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+         text += static_cast<char>( 0x80 | ( code & 0x3F ) );
+      }
+   }
+}
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the text of the given stream.
+///
+/// @param in The stream of the JSON text.
+///////////////////////////////////////////////////////////////////////////////
+Json_reader::Json_reader( std::istream & in )
+   : m_in( in ),
+     m_buffer( Chunk_size ),
+     m_pos( NULL ),
+     m_end( NULL ),
+     m_offset( 0 ),
+     m_expect( Value )
+{
+   // void
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the whole text into the handler. The containers are tracked on a
+/// stack rather than by recursion, so deep nesting cannot overflow.
+///
+/// @return success(true), malformed text or stopped by the handler(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::read( Json_handler & handler )
+{
+   char c;
+
+   while ( next_token( c ) )
+   {
+      switch ( m_expect )
+      {
+         case First_value:
+            if ( c == ']' )
+            {
+               m_containers.pop_back();
+               m_expect = after_value();
+               if ( ! handler.end_array() )
+               {
+                  return false;
+               }
+               break;
+            }
+            // Not empty, so read the first value
+            // fall through
+         case Value:
+            if ( ! read_value( c, handler ) )
+            {
+               return false;
+            }
+            break;
+
+         case First_key:
+            if ( c == '}' )
+            {
+               m_containers.pop_back();
+               m_expect = after_value();
+               if ( ! handler.end_object() )
+               {
+                  return false;
+               }
+               break;
+            }
+            // Not empty, so read the first key
+            // fall through
+         case Key:
+            if ( c != '"' || ! read_string() || ! handler.key( m_text ) )
+            {
+               return false;
+            }
+            m_expect = Colon;
+            break;
+
+         case Colon:
+            if ( c != ':' )
+            {
+               return false;
+            }
+            m_expect = Value;
+            break;
+
+         case Separator:
+            if ( c == ',' )
+            {
+               m_expect = m_containers.back() == '{' ? Key : Value;
+            }
+            else if ( c == '}' && m_containers.back() == '{' )
+            {
+               m_containers.pop_back();
+               m_expect = after_value();
+               if ( ! handler.end_object() )
+               {
+                  return false;
+               }
+            }
+            else if ( c == ']' && m_containers.back() == '[' )
+            {
+               m_containers.pop_back();
+               m_expect = after_value();
+               if ( ! handler.end_array() )
+               {
+                  return false;
+               }
+            }
+            else
+            {
+               return false;
+            }
+            break;
+
+         case Done:
+            // Only white space may follow the value of the text
+            return false;
+      }
+   }
+
+   return m_expect == Done && ! m_in.bad();
+} // End of Json_reader::read(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the value starting with the given character and reports it.
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::read_value( char c, Json_handler & handler )
+{
+   switch ( c )
+   {
+      case '{':
+         m_containers.push_back( c );
+         m_expect = First_key;
+         return handler.start_object();
+
+      case '[':
+         m_containers.push_back( c );
+         m_expect = First_value;
+         return handler.start_array();
+
+      case '"':
+         m_expect = after_value();
+         return read_string() && handler.string_value( m_text );
+
+      case 't':
+         m_expect = after_value();
+         return read_literal( "rue" ) && handler.bool_value( true );
+
+      case 'f':
+         m_expect = after_value();
+         return read_literal( "alse" ) && handler.bool_value( false );
+
+      case 'n':
+         m_expect = after_value();
+         return read_literal( "ull" ) && handler.null_value();
+
+      default:
+         m_expect = after_value();
+         return read_number( c ) && handler.number_value( m_text );
+   }
+} // End of Json_reader::read_value(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the next chunk of the stream into the buffer.
+///
+/// @return read(true), end of the stream(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::fill()
+{
+   m_in.read( &m_buffer[0], static_cast<std::streamsize>( m_buffer.size() ) );
+   const std::size_t size = static_cast<std::size_t>( m_in.gcount() );
+
+   m_pos = &m_buffer[0];
+   m_end = m_pos + size;
+   return size != 0;
+} // End of Json_reader::fill()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the next character that is not white space.
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::next_token( char & c )
+{
+   while ( next( c ) )
+   {
+      if ( c != ' ' && c != '\n' && c != '\r' && c != '\t' )
+      {
+         return true;
+      }
+   }
+   return false;
+} // End of Json_reader::next_token(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads a string whose opening quote was read, unescaping it into m_text.
+/// Escaped UTF-16 surrogate pairs are joined into a single code point.
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::read_string()
+{
+   m_text.clear();
+   char c;
+
+   while ( next( c ) )
+   {
+      if ( c == '"' )
+      {
+         return true;
+      }
+      if ( static_cast<unsigned char>( c ) < 0x20 )
+      {
+         return false;
+      }
+      if ( c != '\\' )
+      {
+         m_text += c;
+         continue;
+      }
+
+      if ( ! next( c ) )
+      {
+         return false;
+      }
+      switch ( c )
+      {
+         case '"':
+         case '\\':
+         case '/':
+            m_text += c;
+            break;
+         case 'b':
+            m_text += '\b';
+            break;
+         case 'f':
+            m_text += '\f';
+            break;
+         case 'n':
+            m_text += '\n';
+            break;
+         case 'r':
+            m_text += '\r';
+            break;
+         case 't':
+            m_text += '\t';
+            break;
+         case 'u':
+         {
+            unsigned int code;
+            if ( ! read_hex( code ) )
+            {
+               return false;
+            }
+            if ( code >= 0xD800 && code < 0xDC00 )
+            {
+               unsigned int low;
+               char backslash;
+               char u;
+               if ( ! next( backslash ) || backslash != '\\' ||
+                    ! next( u ) || u != 'u' || ! read_hex( low ) ||
+                    low < 0xDC00 || low >= 0xE000 )
+               {
+                  return false;
+               }
+               code = 0x10000 + ( ( code - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+            }
+            append_utf8( m_text, code );
+            break;
+         }
+         default:
+            return false;
+      }
+   }
+
+   return false;
+} // End of Json_reader::read_string()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the four hex digits of a \u escape.
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::read_hex( unsigned int & value )
+{
+   value = 0;
+   for ( int i = 0; i < 4; ++i )
+   {
+      char c;
+      if ( ! next( c ) )
+      {
+         return false;
+      }
+
+      value <<= 4;
+      if ( c >= '0' && c <= '9' )
+      {
+         value |= c - '0';
+      }
+      else if ( c >= 'a' && c <= 'f' )
+      {
+         value |= c - 'a' + 10;
+      }
+      else if ( c >= 'A' && c <= 'F' )
+      {
+         value |= c - 'A' + 10;
+      }
+      else
+      {
+         return false;
+      }
+   }
+   return true;
+} // End of Json_reader::read_hex(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads a number whose first character was read into m_text. The
+/// characters are only checked to be those of a number; the handler
+/// converts the text.
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::read_number( char first )
+{
+   if ( first != '-' && ( first < '0' || first > '9' ) )
+   {
+      return false;
+   }
+
+   m_text.assign( 1, first );
+   for ( char c = peek(); 
+         ( c >= '0' && c <= '9' ) || c == '.' || c == 'e' || c == 'E' ||
+            c == '+' || c == '-';
+         c = peek() )
+   {
+      next( c );
+      m_text += c;
+   }
+
+   const char last = m_text[ m_text.size() - 1 ];
+   return last >= '0' && last <= '9';
+} // End of Json_reader::read_number(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the rest of the literal whose first character was read.
+///////////////////////////////////////////////////////////////////////////////
+bool Json_reader::read_literal( const char * rest )
+{
+   for ( ; *rest != '\0'; ++rest )
+   {
+      char c;
+      if ( ! next( c ) || c != *rest )
+      {
+         return false;
+      }
+   }
+   return true;
+} // End of Json_reader::read_literal(...)
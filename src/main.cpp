@@ -105,6 +105,10 @@ int boost_cmd_handler(int ac, char* av[])
         ((config.get_flag_name(Config::Debug) + ",d").c_str(), 
             "printout debug and testing information.\n")
         (config.get_flag_name(Config::Secret_gui).c_str(), "advanced use only.\n")
+        (config.get_flag_name(Config::Spirit_parser).c_str(), 
+            "parses with the Spirit grammars instead of the record decoder; advanced use only.\n")
+        (config.get_flag_name(Config::Memory_stats).c_str(), 
+            "prints the peak memory use and the allocations of the parsed coverage data.\n")
         (config.get_flag_name(Config::Brief).c_str(), 
             "only prints function summaries in coverage reports.\n")
         (config.get_flag_name(Config::Only_missing).c_str(), 
@@ -114,7 +118,7 @@ int boost_cmd_handler(int ac, char* av[])
         (config.get_flag_name(Config::Hide_fake).c_str(), 
             "hides coverage information on fake arcs and fake blocks.\n")
         (config.get_flag_name(Config::Mangle).c_str(), 
-            "outputs the mangled names of functions.\n")
+            "outputs the mangled names of functions, which the selection is matched against.\n")
         (config.get_flag_name(Config::Demangle).c_str(), 
             "outputs the demangled names of functions.\n")
         (config.get_flag_name(Config::Partial_match).c_str(), 
@@ -149,6 +153,12 @@ int boost_cmd_handler(int ac, char* av[])
             "specify the script to be used to get revision information for the source files.\n")
         (config.get_flag_name(Config::Render_format).c_str(), po::value<string>(),
             "specifiy the output format of graph files for the render commands.\n")
+       ((config.get_flag_name(Config::Jobs) + ",j").c_str(), PO::value<unsigned int>(),
+            "specify the number of threads used to parse, 0 uses one per core.\n")
+       (config.get_flag_name(Config::Gcda_stream).c_str(), PO::value<string>(),
+            "read the gcda data from a stream of framed payloads, - reads stdin.\n")
+       (config.get_flag_name(Config::Prefetch).c_str(), PO::value<unsigned int>(),
+            "specify the number of file pairs read ahead of the parsing, 0 disables it.\n")
        (config.get_flag_name(Config::Per_source).c_str(), "creates output files per source.\n")
        (config.get_flag_name(Config::Per_function).c_str(), "creates output files per function.\n")
        (config.get_flag_name(Config::Sort_line).c_str(), "sorts functions by line number.\n")
@@ -270,7 +280,9 @@ graph           Outputs a single graph file. The graph file shows the control\n\
                 flow of all functions from all sources.\n\n\
 graph_report    Creates or overwrites a graph file for each source file in\n\
                 the output directory.\n\n\
-all_report      Peforms report and render_report commands.\n\n"; 
+all_report      Peforms report and render_report commands.\n\n\
+dump_trace      Prints the parse traces given as the selection, written by\n\
+                --debug, as the text of the debug dump.\n\n"; 
 
     cout << command_help << flush;
 }
@@ -286,13 +298,16 @@ void cmd_help()
  --selection       specify the function(s) in all source files.\n\n\
  -v [ --version ]  prints out the working version number of Trucov.\n\n\
  -d [ --debug ]    printout debug and testing information.\n\n\
+ --memory-stats    prints the peak memory use and the allocations of the\n\
+                   parsed coverage data to stderr.\n\n\
  --brief           only prints function summaries in coverage reports.\n\n\
  --only-missing    only outputs coverage information on functions with less\n\
                    than 100% coverage.\n\n\
  --show-fake       outputs coverage information on fake arcs and fake blocks.\n\n\
  --hide-fake       hides coverage information on fake arcs and fake blocks.\n\
                    [ default ]\n\n\
- --mangle          outputs the mangled names of functions.\n\n\
+ --mangle          outputs the mangled names of functions, which the\n\
+                   selection is matched against.\n\n\
  --demangle        outputs the demangled names of functions.[ default ]\n\n\
  --partial-match   specify selection will be matched partially.[ default ]\n\n\
  --full-match      specify selection will be matched fully.\n\n\
@@ -313,7 +328,10 @@ void config_help()
 void cmd_config_help()
 {
   cout << "Command Line + Config Options:\n\n"
-       << " -b [ --builddir ]    specify the root directorie(s) of the GCNO and GCDA files.\n\n"
+       << " -b [ --builddir ]    specify the root directorie(s) of the GCNO and GCDA files.\n"
+       << "                      Tar archives (.tar, .tar.gz, .tgz, .tar.zst) of them\n"
+       << "                      are read without being extracted. Gcov json files\n"
+       << "                      (.gcov.json, .gcov.json.gz) found there are read too.\n\n"
        << " -s [ --srcdir ]      specify the directorie(s) of the source files.\n\n"
        << " --per-source         report commands create coverage report files per source\n\n"
        << " --per-function       report commands create coverage report files per function\n\n" 
@@ -322,7 +340,16 @@ void cmd_config_help()
        << " --revision-script    specify the script to be used to get revision information \n"
        << "                      for the source files.\n\n"
        << " --render-format      specifiy the output format of graph files for the render\n"
-       << "                      commands. Value may be 'pdf' or 'svg', without quotes.\n" << endl;
+       << "                      commands. Value may be 'pdf' or 'svg', without quotes.\n\n"
+       << " -j [ --jobs ]        specify the number of threads used to parse the GCNO and\n"
+       << "                      GCDA files, 0 uses one per core.\n\n"
+       << " --gcda-stream        read the GCDA data from a file, a FIFO or stdin when '-',\n"
+       << "                      instead of the GCDA files of the build directories.\n"
+       << "                      Each payload is a line '<size> <gcda path>' followed\n"
+       << "                      by the <size> bytes of the GCDA data. The payloads of\n"
+       << "                      an object are matched to its GCNO file and added up.\n\n"
+       << " --prefetch           specify the number of GCNO and GCDA file pairs read\n"
+       << "                      ahead of the parsing, 0 disables it. Defaults to 4.\n" << endl;
 }
 
 // MAIN FUNCTION
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file mapped_file.cpp
+///
+///  @brief
+///  Implements the Mapped_file class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// LOCAL INCLUDES
+
+#include "mapped_file.h"
+
+// USING STATEMENTS
+
+using std::string;
+using std::size_t;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Maps the file for a single sequential pass, or reads it if it cannot be
+/// mapped.
+///
+/// @param path The path of the file.
+///////////////////////////////////////////////////////////////////////////////
+Mapped_file::Mapped_file( const string & path )
+   : m_data( NULL ),
+     m_size( 0 ),
+     m_open( false ),
+     m_mapped( false )
+{
+   const int fd = open( path.c_str(), O_RDONLY );
+   if ( fd < 0 )
+   {
+      return;
+   }
+
+   struct stat status;
+   if ( fstat( fd, &status ) == 0 && S_ISREG( status.st_mode ) &&
+        status.st_size > 0 )
+   {
+      void * mapping = mmap( NULL, status.st_size, PROT_READ, MAP_PRIVATE,
+         fd, 0 );
+
+      if ( mapping != MAP_FAILED )
+      {
+         // The parsers read each file once from front to back
+         madvise( mapping, status.st_size, MADV_SEQUENTIAL );
+
+         m_data = static_cast<const char *>( mapping );
+         m_size = status.st_size;
+         m_mapped = true;
+         m_open = true;
+      }
+   }
+
+   if ( ! m_mapped )
+   {
+      m_open = read_all( fd );
+   }
+
+   close( fd );
+} // End of Mapped_file constructor
+
+///////////////////////////////////////////////////////////////////////////////
+Mapped_file::~Mapped_file()
+{
+   if ( m_mapped )
+   {
+      munmap( const_cast<char *>( m_data ), m_size );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Starts reading a whole file into the page cache. Nothing is done where
+/// posix_fadvise is not available or the file cannot be opened.
+///
+/// @param path The path of the file.
+///////////////////////////////////////////////////////////////////////////////
+void Mapped_file::prefetch( const string & path )
+{
+#ifdef POSIX_FADV_WILLNEED
+   const int fd = open( path.c_str(), O_RDONLY );
+   if ( fd < 0 )
+   {
+      return;
+   }
+
+   // The read ahead outlives the descriptor
+   posix_fadvise( fd, 0, 0, POSIX_FADV_WILLNEED );
+   close( fd );
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the file into m_buffer until its end.
+///
+/// @param fd The open file.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Mapped_file::read_all( int fd )
+{
+   const size_t chunk_size = 64 * 1024;
+   size_t size = 0;
+
+   for ( ;; )
+   {
+      m_buffer.resize( size + chunk_size );
+      const ssize_t count = read( fd, &m_buffer[size], chunk_size );
+
+      if ( count < 0 )
+      {
+         if ( errno == EINTR )
+         {
+            continue;
+         }
+         m_buffer.clear();
+         return false;
+      }
+
+      if ( count == 0 )
+      {
+         break;
+      }
+      size += count;
+   }
+
+   m_buffer.resize( size );
+   m_size = size;
+   m_data = m_buffer.empty() ? NULL : &m_buffer[0];
+
+   return true;
+} // End of Mapped_file::read_all(...)
@@ -35,18 +35,31 @@
 
 #include "parser.h"
 
+// SYSTEM INCLUDES
+
+#include <sstream>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// LOCAL INCLUDES
+
+#include "gcda_stream.h"
+#include "gcov_json_decoder.h"
+#include "mapped_file.h"
+#include "tar_archive.h"
+#include "selector.h"
+#include "work_pool.h"
+
 //  STATIC FIELD INITIALIZATION
 
 // Null value means the object has not been instantiated yet.
 Parser * Parser::ptr_instance = NULL;
 
-// Tells the spirit parser if the current file is big endian or little endian.
-bool global_little_endian = false;
-
-unsigned int global_parsed_int32 = 0;
-uint64_t global_parsed_int64 = 0;
-std::string global_parsed_string = "";
-
 //  USING STATMENTS
 
 using std::map;
@@ -60,6 +73,7 @@ using std::cerr;
 using std::endl;
 using std::ios;
 using std::flush;
+using std::size_t;
 
 #if BOOST_VERSION < NEW_SPIRIT_VERSION
    namespace SP = boost::spirit;
@@ -67,59 +81,448 @@ using std::flush;
    namespace SP = boost::spirit::classic;
 #endif
 
-//  METHOD DEFINITIONS
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the magic of a gcno or gcda file in host byte order.
+///
+/// @param first The beginning of the contents of the file.
+/// @param last The end of the contents of the file.
+///
+/// @return The magic, or 0 if the file is too short to have one.
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int read_magic( const char * first, const char * last )
+{
+   unsigned int magic = 0;
+   if ( static_cast<size_t>( last - first ) >= int32_size )
+   {
+      std::memcpy( &magic, first, int32_size );
+   }
+   return magic;
+}
 
-bool Parser::parse_all()
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns if the contents of a file start with the given magic, in either
+/// byte order.
+///
+/// @param first The beginning of the contents of the file.
+/// @param last The end of the contents of the file.
+/// @param magic The magic of the file type, in host byte order.
+/// @param little_endian Set if the file does not need its bytes reversed.
+///
+/// @return matched(true), not matched(false)
+///////////////////////////////////////////////////////////////////////////////
+static bool check_magic( const char * first, const char * last,
+   unsigned int magic, bool & little_endian )
 {
-   Tru_utility* sys_utility = Tru_utility::get_instance();
-   vector< pair<string, string> > build_list;
-   vector< pair<string, string> >::iterator itr;
-   pair<string, string> tmp_pair;
+   const unsigned int found = read_magic( first, last );
+   little_endian = found == magic;
 
-   Config & config = Config::get_instance();
-   build_list = config.get_build_files();
-   itr = build_list.begin();
+   return little_endian || found == swap_int32( magic );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Parses the pairs of the build list and stages the source files parsed
+/// from each pair until the main thread merges them, in build order.
+///
+/// @remarks
+/// Each pair is parsed into its own source file map by its own
+/// Parser_builder, so the pairs can be parsed on the work pool while the
+/// output stays the same as parsing them one at a time.
+///////////////////////////////////////////////////////////////////////////////
+class Parser::Parse_batch : boost::noncopyable
+{
+public:
 
-   string dump_file;
-   int result = 0;
+   /// The staged outcome of parsing one pair.
+   struct Result
+   {
+      Result() : m_status( 1 ), m_done( false ) {}
+
+      /// The source files parsed from the pair.
+      Source_file_map m_source_files;
+      /// The error messages of the pair.
+      string m_log;
+      /// success(0), or failure(1)
+      int m_status;
+      /// Set once the pair has been parsed.
+      bool m_done;
+   };
+
+   Parse_batch( const vector< pair<string, string> > & build_list,
+      const vector<string> & dump_files,
+      const Parse_settings & settings )
+      : m_build_list( build_list ),
+        m_dump_files( dump_files ),
+        m_settings( settings ),
+        m_results( build_list.size() ),
+        m_window( 0 ),
+        m_read_ahead( 0 )
+   {
+      m_settings.m_known_structures = &m_known_structures;
+   }
 
-   cerr << "Parsing gcno and gcda files ." << flush;
+   /// @brief
+   /// Returns the structures decoded by the pairs of the batch.
+   const Known_structures & get_known_structures() const
+   {
+      return m_known_structures;
+   }
 
-   // Iterates through all pairs of gcno and gcda files and
-   // parse each
-   bool some_failed = false;
-   for(itr = build_list.begin(); itr != build_list.end(); itr++)
+   /// @brief
+   /// Adds the pairs of an archive, which are parsed from its members
+   /// rather than from files. The archive must outlive the batch.
+   ///
+   /// @param archive The archive.
+   /// @param build_list The build list, to which the pairs are appended
+   /// before the batch is created.
+   static void add_archive_pairs( const Tar_archive & archive,
+      vector< pair<string, string> > & build_list )
    {
+      const vector< pair<string, string> > & pairs = archive.get_pairs();
+      for ( size_t i = 0; i < pairs.size(); ++i )
+      {
+         build_list.push_back( std::make_pair( 
+            get_member_path( archive, pairs[i].first ), 
+            get_member_path( archive, pairs[i].second ) ) );
+      }
+   }
 
-      // If dumping parser data
-#ifdef DEBUGFLAG 
-      if (config.get_flag_value(Config::Debug))
+   /// @brief
+   /// Lets the batch find the members of an archive by their paths.
+   void add_archive( const Tar_archive & archive )
+   {
+      const vector< pair<string, string> > & pairs = archive.get_pairs();
+      for ( size_t i = 0; i < pairs.size(); ++i )
       {
-         // Generate dump file
-         dump_file = "selcov_dump_" +
-         sys_utility->genSelcovFileName(itr->first, ".dump");
-         dump_file = config.get_flag_value(Config::Output) + dump_file;
+         m_members[ get_member_path( archive, pairs[i].first ) ] = 
+            archive.find_member( pairs[i].first );
+         m_members[ get_member_path( archive, pairs[i].second ) ] = 
+            archive.find_member( pairs[i].second );
+      }
+   }
 
-         result = parse( itr->first, itr->second, dump_file );
+   /// @brief
+   /// Returns the pair indices, largest pair first, so a large pair is
+   /// not left to run alone at the end of the batch.
+   vector<size_t> get_schedule() const
+   {
+      vector< pair<boost::uintmax_t, size_t> > sizes;
+      for ( size_t i = 0; i < m_build_list.size(); ++i )
+      {
+         sizes.push_back( std::make_pair( 
+            input_size( m_build_list[i].first ) + 
+            input_size( m_build_list[i].second ), i ) );
       }
-      else // No dump file
-#endif 
+      std::stable_sort( sizes.begin(), sizes.end(), compare_sizes );
+
+      vector<size_t> schedule;
+      for ( size_t i = 0; i < sizes.size(); ++i )
       {
-         result = parse( itr->first, itr->second );
+         schedule.push_back( sizes[i].second );
       }
-   
-      if (!result)
-      {   
-         cerr << "." << flush;
+      return schedule;
+   }
+
+   /// @brief
+   /// Sets the order the pairs will be parsed in and how many pairs past
+   /// the one being parsed are read ahead, so their reads overlap the
+   /// parsing. A window of 0 reads nothing ahead.
+   void set_read_ahead( const vector<size_t> & order, size_t window )
+   {
+      m_order = order;
+      m_positions.assign( order.size(), 0 );
+      for ( size_t i = 0; i < order.size(); ++i )
+      {
+         m_positions[order[i]] = i;
+      }
+      m_window = window;
+      m_read_ahead = 0;
+   }
+
+   /// @brief
+   /// Parses a pair of the build list into its staged result.
+   void parse( size_t index )
+   {
+      read_ahead( index );
+
+      Result & result = m_results[index];
+      std::ostringstream log;
+
+      const string & gcno = m_build_list[index].first;
+      const string & gcda = m_build_list[index].second;
+      Member_map::const_iterator gcno_member = m_members.find( gcno );
+      Member_map::const_iterator gcda_member = m_members.find( gcda );
+      if ( gcno_member != m_members.end() && gcda_member != m_members.end() )
+      {
+         const vector<char> & gcno_data = *gcno_member->second;
+         const vector<char> & gcda_data = *gcda_member->second;
+         result.m_status = parse_buffers( 
+            gcno, begin_of( gcno_data ), begin_of( gcno_data ) + gcno_data.size(),
+            gcda, begin_of( gcda_data ), begin_of( gcda_data ) + gcda_data.size(),
+            m_dump_files[index], m_settings, result.m_source_files, log );
       }
       else
       {
-         some_failed = true;
+         result.m_status = parse_pair( gcno, gcda, m_dump_files[index], 
+            m_settings, result.m_source_files, log );
+      }
+      result.m_log = log.str();
+
+      boost::mutex::scoped_lock lock( m_mutex );
+      result.m_done = true;
+      m_parsed.notify_all();
+   }
+
+   /// @brief
+   /// Waits for a pair to be parsed and returns its staged result.
+   Result & wait( size_t index )
+   {
+      boost::mutex::scoped_lock lock( m_mutex );
+      while ( ! m_results[index].m_done )
+      {
+         m_parsed.wait( lock );
+      }
+      return m_results[index];
+   }
+
+private:
+
+   /// Maps the paths of archive members to their contents.
+   typedef map< string, const vector<char> * > Member_map;
+
+   /// Returns the path an archive member is known by.
+   static string get_member_path( const Tar_archive & archive,
+      const string & member )
+   {
+      return archive.get_path() + "/" + member;
+   }
+
+   /// Returns the first byte of a buffer, or NULL if it is empty.
+   static const char * begin_of( const vector<char> & data )
+   {
+      return data.empty() ? NULL : &data[0];
+   }
+
+   /// Returns the size of a member or a file, or 0 if it cannot be read.
+   boost::uintmax_t input_size( const string & path ) const
+   {
+      Member_map::const_iterator member = m_members.find( path );
+      if ( member != m_members.end() )
+      {
+         return member->second->size();
+      }
+      return file_size( path );
+   }
+
+   /// @brief
+   /// Starts reading the pairs up to the window past a pair about to be
+   /// parsed that no other call has started yet.
+   void read_ahead( size_t index )
+   {
+      if ( m_window == 0 || index >= m_positions.size() )
+      {
+         return;
+      }
+
+      size_t first, last;
+      {
+         boost::mutex::scoped_lock lock( m_mutex );
+         first = m_read_ahead;
+         last = std::min( m_positions[index] + 1 + m_window, m_order.size() );
+         if ( first >= last )
+         {
+            return;
+         }
+         m_read_ahead = last;
+      }
+
+      // Archive members are already in memory
+      for ( size_t i = first; i < last; ++i )
+      {
+         if ( m_members.count( m_build_list[ m_order[i] ].first ) )
+         {
+            continue;
+         }
+         Mapped_file::prefetch( m_build_list[ m_order[i] ].first );
+         Mapped_file::prefetch( m_build_list[ m_order[i] ].second );
       }
    }
-   cout << endl;
 
-   if (some_failed)
+   /// Returns the size of a file, or 0 if it cannot be read.
+   static boost::uintmax_t file_size( const string & path )
+   {
+      boost::system::error_code error;
+      boost::uintmax_t size = fs::file_size( path, error );
+      return error ? 0 : size;
+   }
+
+   /// Orders the pairs by decreasing size.
+   static bool compare_sizes( const pair<boost::uintmax_t, size_t> & lhs,
+      const pair<boost::uintmax_t, size_t> & rhs )
+   {
+      return lhs.first > rhs.first;
+   }
+
+   const vector< pair<string, string> > & m_build_list;
+   const vector<string> & m_dump_files;
+   Parse_settings m_settings;
+
+   vector<Result> m_results;
+
+   /// The contents of the archive members of the build list.
+   Member_map m_members;
+
+   /// The structures decoded so far, owned by the results.
+   Known_structures m_known_structures;
+
+   /// The pair indices in the order they are parsed.
+   vector<size_t> m_order;
+   /// The position of each pair in m_order.
+   vector<size_t> m_positions;
+   /// The number of pairs read ahead of the one being parsed.
+   size_t m_window;
+   /// The position in m_order of the first pair not read ahead yet.
+   size_t m_read_ahead;
+
+   /// Guards the done flags of the results and m_read_ahead.
+   boost::mutex m_mutex;
+   /// Signaled each time a pair has been parsed.
+   boost::condition_variable m_parsed;
+
+}; // End of class Parser::Parse_batch
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes the gcno file of an object, then each gcda payload streamed for
+/// the object into the same builder, which adds up their counts.
+///////////////////////////////////////////////////////////////////////////////
+class Parser::Stream_object : boost::noncopyable
+{
+public:
+
+   explicit Stream_object( const Parse_settings & settings )
+      : m_builder( m_source_files, *settings.m_project ),
+        m_decoder( m_builder, false, m_dump_file ),
+        m_valid( false )
+   {
+      m_builder.set_with_lines( settings.m_with_lines );
+   }
+
+   /// @brief
+   /// Decodes the gcno file of the object.
+   ///
+   /// @return success(true), failure(false)
+   bool decode_gcno( const string & gcno_path, std::ostream & log )
+   {
+      Mapped_file gcno_file( gcno_path );
+      const string gcno_name = 
+         Tru_utility::get_instance()->get_filename( gcno_path );
+      bool little_endian;
+
+      if ( ! gcno_file.is_open() )
+      {
+         log << "\nERROR: Cannot open gcno file " << gcno_path << flush;
+      }
+      else if ( ! check_magic( gcno_file.begin(), gcno_file.end(),
+                   Gcov_decoder::Gcno_magic, little_endian ) )
+      {
+         log << "\nERROR: Invalid Gcno file " << gcno_name << flush;
+      }
+      else if ( ! m_decoder.decode_gcno( gcno_file.begin(), gcno_file.end(),
+                   little_endian ) )
+      {
+         log << "\nERROR: Failed to parse Gcno file " << gcno_name << flush;
+      }
+      else
+      {
+         m_valid = true;
+      }
+
+      return m_valid;
+   }
+
+   /// @brief
+   /// Adds the counts of a gcda payload of the object.
+   ///
+   /// @return success(true), failure(false)
+   bool decode_gcda( const vector<char> & payload )
+   {
+      const char * first = payload.empty() ? NULL : &payload[0];
+      const char * last = first + payload.size();
+      bool little_endian;
+
+      if ( ! check_magic( first, last, Gcov_decoder::Gcda_magic, 
+              little_endian ) )
+      {
+         return false;
+      }
+
+      m_builder.begin_gcda();
+      return m_decoder.decode_gcda( first, last, little_endian );
+   }
+
+   /// @brief
+   /// Returns if the gcno file of the object was decoded.
+   bool is_valid() const
+   {
+      return m_valid;
+   }
+
+   /// @brief
+   /// Returns the source files decoded for the object.
+   Source_file_map & get_source_files()
+   {
+      return m_source_files;
+   }
+
+private:
+
+   Source_file_map m_source_files;
+   /// Never opened, as streamed objects are not dumped.
+   Trace_writer m_dump_file;
+   Parser_builder m_builder;
+   Gcov_decoder m_decoder;
+
+   /// Set once the gcno file has been decoded.
+   bool m_valid;
+
+}; // End of class Parser::Stream_object
+
+//  METHOD DEFINITIONS
+
+bool Parser::parse_all( bool with_lines )
+{
+   Config & config = Config::get_instance();
+
+   // The parsing threads only read the settings and the singletons, so
+   // they are all set up before the threads start.
+   Parse_settings settings = get_parse_settings();
+   settings.m_with_lines = with_lines;
+   Selector::get_instance();
+
+   // The gcda data comes from the stream instead of the gcda files
+   const string stream_path = config.get_flag_value(Config::Gcda_stream);
+   const bool json_only = stream_path.empty() && 
+      ! config.get_json_files().empty() &&
+      config.get_build_files().empty() && config.get_archive_files().empty();
+   bool parsed = true;
+   if ( ! json_only )
+   {
+      parsed = stream_path.empty() ? parse_pairs( settings )
+         : parse_gcda_stream( stream_path, settings );
+      cout << endl;
+   }
+
+   // The gcov json files add their functions to those of the pairs
+   if ( ! config.get_json_files().empty() )
+   {
+      parsed = parse_gcov_json( settings ) && parsed;
+      cout << endl;
+   }
+
+   if (!parsed)
    {
       cerr << "Some parsing failures occured, try:\n" 
            << " (1) Compiling source code again.\n"
@@ -128,29 +531,35 @@ bool Parser::parse_all()
       return false;
    }
 
+   // Group the arcs of each function by block, and index
+   // the arcs entering each block
+   assign_entry_arcs();
+
    // For each arc with data from the GCDA data file, assign
    // that arc's traversal count
    assign_arc_counts();
 
-   // For each block, populate a vector with pointers to
-   // the arcs entering that block
-   assign_entry_arcs();
-
    // Calculate and assign the traversal count for all arcs
    // not assigned a count from the GCDA data file
    normalize_arcs();
 
    // Assign the last line of the parent block to any blocks
    // that have no line number assigned
-   normalize_lines();
+   if ( with_lines )
+   {
+      normalize_lines();
+   }
 
    // For each functions block, determine whether the block
    // is fake
    normalize_fake_blocks();
 
-   // Populate m_blocks_sorted with Blocks sorted by line #
+   // Populate m_block_order with the blocks sorted by line #
    // for use later by Coverage creator class
-   sort_blocks();
+   if ( with_lines )
+   {
+      sort_blocks();
+   }
 
    // Calculate total.
    calculate_total_coverage();
@@ -161,7 +570,7 @@ bool Parser::parse_all()
 
 ////////////////////////////////////////////////////////////////////////////////
 ///  @brief
-///  Sets up GCNO and GCDA files for parsing, calls parse function, closes files
+///  Parses a GCNO and GCDA file pair into the source files.
 ///
 ///  INPUTS:
 ///  @param gcnoFile The string path of the gcno file
@@ -173,48 +582,21 @@ int Parser::parse(
     const string & gcnoFile, 
     const string & gcdaFile )
 {
-    mGcnoFile.open(gcnoFile.c_str());
-    mGcdaFile.open(gcdaFile.c_str());
-
-    if ( mGcnoFile.fail() )
-    {
-        cerr << "\nERROR: Cannot open gcno file " << gcnoFile << flush;
-        mGcnoFile.close();
-        mGcdaFile.close();
-        return 1;
-    }
-    else if ( mGcdaFile.fail() )
-    {
-        cerr << "\nERROR: Cannot open gcda file " << gcdaFile << flush;
-        mGcnoFile.close();
-        mGcdaFile.close();
-        return 1; 
-    }
-
-    mIsDump = false;
-    Tru_utility * utility = Tru_utility::get_instance();
-
-    m_gcno_name = utility->get_filename(gcnoFile);
-    m_gcda_name = utility->get_filename(gcdaFile);
-    int r = parse();
-
-    mGcnoFile.close();
-    mGcdaFile.close();
-
-    return r;
+    return parse_pair( gcnoFile, gcdaFile, "", get_parse_settings(),
+        m_source_files, cerr );
 
 } // end of Parser::parse(const string &, const string &)
 
 #ifdef DEBUGFLAG 
 ////////////////////////////////////////////////////////////////////////////////
 ///  @brief
-///  Sets up GCNO and GCDA files for parsing, calls parse function, closes files
-///  Dumps output to dump file
+///  Parses a GCNO and GCDA file pair into the source files.
+///  Traces the parse to the dump file
 ///
 ///  INPUTS:
 ///  @param gcnoFile The string path of the gcno file
 ///  @param gcdaFile The string path of the gcda file
-///  @param dumpFile The string path of the dump file
+///  @param dumpFile The string path of the parse trace
 ///
 ///  @return int success(0), or failure(1)
 ////////////////////////////////////////////////////////////////////////////////
@@ -223,74 +605,386 @@ int Parser::parse(
     const string & gcdaFile,
     const string & dumpFile )
 {
-    // Open files
-    mGcnoFile.open(gcnoFile.c_str());
-    mGcdaFile.open(gcdaFile.c_str());
-    mDumpFile.open(dumpFile.c_str());
-    if ( mGcnoFile.fail() )
+    return parse_pair( gcnoFile, gcdaFile, dumpFile, get_parse_settings(),
+        m_source_files, cerr );
+
+} // end of Parser::parse(const string &, const string &, const string &)
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the configuration used while parsing.
+///
+/// @return The parse settings.
+///////////////////////////////////////////////////////////////////////////
+Parser::Parse_settings Parser::get_parse_settings()
+{
+    Config & config = Config::get_instance();
+
+    Parse_settings settings;
+
+    // The source files are indexed and their revisions resolved once, for
+    // every builder of the parse
+    settings.m_project.reset( new Project_context( config.get_source_files(),
+        config.get_flag_value(Config::Revision_script) ) );
+    Tru_utility::get_instance()->set_project_context( settings.m_project );
+
+    // The Spirit grammars are kept to cross-check the record decoder
+    settings.m_use_grammar = config.get_flag_value(Config::Spirit_parser);
+
+    // Only a parse batch shares the structures it decodes
+    settings.m_known_structures = NULL;
+    settings.m_with_lines = true;
+
+    return settings;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Parses the gcno and gcda pairs of the build list on the work pool and
+/// merges them into the source files in build order.
+///
+/// @param settings The configuration used while parsing.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////
+bool Parser::parse_pairs( const Parse_settings & settings )
+{
+   Tru_utility* sys_utility = Tru_utility::get_instance();
+   Config & config = Config::get_instance();
+   vector< pair<string, string> > build_list = config.get_build_files();
+   bool some_failed = false;
+
+   // The pairs of the archives follow those of the build directories
+   const vector<string> & archive_files = config.get_archive_files();
+   vector< boost::shared_ptr<Tar_archive> > archives;
+   std::ostringstream archive_log;
+   for ( size_t i = 0; i < archive_files.size(); ++i )
+   {
+      boost::shared_ptr<Tar_archive> archive( new Tar_archive );
+      if ( ! archive->open( archive_files[i] ) )
+      {
+         archive_log << "\nERROR: Cannot read archive " << archive_files[i];
+         some_failed = true;
+         continue;
+      }
+      Parse_batch::add_archive_pairs( *archive, build_list );
+      archives.push_back( archive );
+   }
+
+   vector<string> dump_files( build_list.size() );
+
+   // If dumping parser data
+#ifdef DEBUGFLAG 
+   if (config.get_flag_value(Config::Debug))
+   {
+      for ( size_t i = 0; i < build_list.size(); ++i )
+      {
+         // Generate dump file
+         dump_files[i] = "selcov_dump_" +
+         sys_utility->genSelcovFileName(build_list[i].first, ".trace");
+         dump_files[i] = config.get_flag_value(Config::Output) + dump_files[i];
+      }
+   }
+#endif 
+
+   // Pairs may share a dump file, so dumping parses one pair at a time.
+   size_t jobs = config.get_flag_value(Config::Jobs);
+   if ( !dump_files.empty() && !dump_files[0].empty() )
+   {
+      jobs = 1;
+   }
+   jobs = std::min( jobs, build_list.size() );
+
+   // The pool is declared after the batch so it is joined first.
+   Parse_batch batch( build_list, dump_files, settings );
+   for ( size_t i = 0; i < archives.size(); ++i )
+   {
+      batch.add_archive( *archives[i] );
+   }
+   Work_pool pool( jobs );
+
+   vector<size_t> order;
+   if ( jobs > 1 )
+   {
+      order = batch.get_schedule();
+   }
+   else
+   {
+      for ( size_t i = 0; i < build_list.size(); ++i )
+      {
+         order.push_back( i );
+      }
+   }
+   batch.set_read_ahead( order, config.get_flag_value(Config::Prefetch) );
+
+   if ( jobs > 1 )
+   {
+      pool.start( order, boost::bind( &Parse_batch::parse, &batch, _1 ) );
+   }
+
+   cerr << "Parsing gcno and gcda files ." << archive_log.str() << flush;
+
+   // Merges the pairs in build order, so the results and the messages
+   // do not depend on the number of jobs.
+   for ( size_t i = 0; i < build_list.size(); ++i )
+   {
+      if ( jobs <= 1 )
+      {
+         batch.parse( i );
+      }
+
+      Parse_batch::Result & result = batch.wait( i );
+      cerr << result.m_log;
+   
+      if (!result.m_status)
+      {   
+         merge_source_files( result.m_source_files );
+         cerr << "." << flush;
+      }
+      else
+      {
+         // Kept, as later pairs may have skipped the structures it owns
+         some_failed = true;
+         continue;
+      }
+      result.m_source_files.clear();
+   }
+   pool.join();
+   fill_known_structures( batch.get_known_structures() );
+
+   return !some_failed;
+} // End of Parser::parse_pairs(...)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Parses the gcda payloads of a stream, adding up the payloads of each
+/// object, and merges the objects into the source files in build order.
+///
+/// @param stream_path The path of the stream, or "-" for stdin.
+/// @param settings The configuration used while parsing.
+///
+/// @return success(true), failure(false)
+///
+/// @remarks
+/// The gcno file of an object is decoded when its first payload arrives,
+/// and every payload is then decoded into the same builder, so neither the
+/// payloads nor temporary gcda files are kept.
+///////////////////////////////////////////////////////////////////////////
+bool Parser::parse_gcda_stream( const string & stream_path,
+   const Parse_settings & settings )
+{
+   Tru_utility * utility = Tru_utility::get_instance();
+   const vector<string> & gcno_files = 
+      Config::get_instance().get_gcno_files();
+
+   // The gcno files, by the absolute path of the gcda file of their object
+   map<string, size_t> objects;
+   for ( size_t i = 0; i < gcno_files.size(); ++i )
+   {
+      const string & gcno = gcno_files[i];
+      objects[ utility->get_abs_path( 
+         gcno.substr( 0, gcno.size() - 4 ) + "gcda" ) ] = i;
+   }
+
+   std::ifstream file;
+   std::istream * in = &std::cin;
+   if ( stream_path != "-" )
+   {
+      file.open( stream_path.c_str(), ios::in | ios::binary );
+      if ( ! file )
+      {
+         cerr << "\nERROR: Cannot open gcda stream " << stream_path << flush;
+         return false;
+      }
+      in = &file;
+   }
+
+   cerr << "Parsing gcno files and gcda stream ." << flush;
+
+   vector< boost::shared_ptr<Stream_object> > streamed( gcno_files.size() );
+   Gcda_stream stream( *in );
+   string object;
+   vector<char> payload;
+   bool some_failed = false;
+   while ( stream.next( object, payload ) )
+   {
+      map<string, size_t>::const_iterator found = 
+         objects.find( utility->get_abs_path( object ) );
+      if ( found == objects.end() )
+      {
+         cerr << "\nWarning: No gcno file for streamed gcda " << object 
+              << flush;
+         continue;
+      }
+
+      boost::shared_ptr<Stream_object> & target = streamed[found->second];
+      if ( ! target )
+      {
+         target.reset( new Stream_object( settings ) );
+         if ( ! target->decode_gcno( gcno_files[found->second], cerr ) )
+         {
+            some_failed = true;
+         }
+      }
+
+      if ( target->is_valid() && ! target->decode_gcda( payload ) )
+      {
+         cerr << "\nERROR: Failed to parse streamed gcda " << object << flush;
+         some_failed = true;
+      }
+   }
+
+   if ( stream.is_failed() )
+   {
+      cerr << "\nERROR: Malformed gcda stream " << stream_path << flush;
+      some_failed = true;
+   }
+
+   for ( size_t i = 0; i < streamed.size(); ++i )
+   {
+      if ( streamed[i] && streamed[i]->is_valid() )
+      {
+         merge_source_files( streamed[i]->get_source_files() );
+         cerr << "." << flush;
+      }
+   }
+
+   return !some_failed;
+} // End of Parser::parse_gcda_stream(...)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Parses the gcov json files of the build list, in build order.
+///
+/// @param settings The configuration used while parsing.
+///
+/// @return success(true), failure(false)
+///
+/// @remarks
+/// The files are decoded straight into m_source_files by a single builder,
+/// so a function found in several files, or already parsed from a pair,
+/// has its counts added up.
+///////////////////////////////////////////////////////////////////////////
+bool Parser::parse_gcov_json( const Parse_settings & settings )
+{
+   const vector<string> & json_files = Config::get_instance().get_json_files();
+   Parser_builder builder( m_source_files, *settings.m_project );
+   builder.set_with_lines( settings.m_with_lines );
+   Gcov_json_decoder decoder( builder );
+   bool some_failed = false;
+
+   cerr << "Parsing gcov json files ." << flush;
+
+   for ( size_t i = 0; i < json_files.size(); ++i )
+   {
+      if ( ! decoder.decode_file( json_files[i] ) )
+      {
+         cerr << "\nERROR: Failed to parse gcov json file " << json_files[i] 
+              << flush;
+         some_failed = true;
+         continue;
+      }
+      cerr << "." << flush;
+   }
+
+   return !some_failed;
+} // End of Parser::parse_gcov_json(...)
+
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Parses a gcno and gcda file pair into the given source files.
+///
+/// @param gcnoFile The string path of the gcno file
+/// @param gcdaFile The string path of the gcda file
+/// @param dumpFile The string path of the dump file, empty to not dump.
+/// @param settings The configuration used while parsing.
+/// @param source_files The source files the pair is parsed into.
+/// @param log The stream the error messages are written to.
+///
+/// @return success(0), or failure(1)
+///
+/// @remarks
+/// Touches no state of the Parser, so pairs parsed into different source
+/// files may be parsed on different threads.
+///////////////////////////////////////////////////////////////////////////
+int Parser::parse_pair(
+    const string & gcnoFile, 
+    const string & gcdaFile,
+    const string & dumpFile,
+    const Parse_settings & settings,
+    Source_file_map & source_files,
+    std::ostream & log )
+{
+    // Map files
+    Mapped_file gcno_file( gcnoFile );
+    Mapped_file gcda_file( gcdaFile );
+
+    if ( ! gcno_file.is_open() )
     {
-        cerr << "\nERROR: Cannot open gcno file " << gcnoFile << flush;
-        mGcnoFile.close();
-        mGcdaFile.close();
+        log << "\nERROR: Cannot open gcno file " << gcnoFile << flush;
         return 1;
     }
-    else if ( mGcdaFile.fail() )
+    else if ( ! gcda_file.is_open() )
     {
-        cerr << "\nERROR: Cannot open gcda file " << gcdaFile << flush;
-        mGcnoFile.close();
-        mGcdaFile.close();
+        log << "\nERROR: Cannot open gcda file " << gcdaFile << flush;
         return 1; 
     }
 
-    // Used with
-    mIsDump = true;
-    mDumpFile << "**************************************************\n"
-              << "GCNO FILE: " << gcnoFile << "\n"
-              << "GCDA FILE: " << gcdaFile << "\n";
+    return parse_buffers( gcnoFile, gcno_file.begin(), gcno_file.end(),
+        gcdaFile, gcda_file.begin(), gcda_file.end(), dumpFile, settings,
+        source_files, log );
 
-    Tru_utility * utility = Tru_utility::get_instance();
-    m_gcno_name = utility->get_filename(gcnoFile);
-    m_gcda_name = utility->get_filename(gcdaFile);
-    
-    int r = parse();
-
-    // Close files
-    mGcnoFile.close();
-    mGcdaFile.close();
-    if (mIsDump)
-    {    
-        mDumpFile.close();
-    }
-    return r;
-
-} // end of Parser::parse(const string &, const string &, const string &)
-#endif
+} // end of Parser::parse_pair(...)
 
 ///////////////////////////////////////////////////////////////////////////
 /// @brief
-/// Parses the current gcno and gcda files pair and merges the coverage
-/// data into the data structure.
+/// Parses the contents of a gcno and gcda pair into the given source
+/// files, wherever the contents were read from.
 ///
-/// @return success(true), failure(false)
+/// @param gcnoFile The string path of the gcno file
+/// @param gcno_first The beginning of the gcno contents.
+/// @param gcno_last The end of the gcno contents.
+/// @param gcdaFile The string path of the gcda file
+/// @param gcda_first The beginning of the gcda contents.
+/// @param gcda_last The end of the gcda contents.
+/// @param dumpFile The string path of the dump file, empty to not dump.
+/// @param settings The configuration used while parsing.
+/// @param source_files The source files the pair is parsed into.
+/// @param log The stream the error messages are written to.
+///
+/// @return success(0), or failure(1)
 ///////////////////////////////////////////////////////////////////////////
-int Parser::parse()
+int Parser::parse_buffers(
+    const string & gcnoFile, 
+    const char * gcno_first,
+    const char * gcno_last,
+    const string & gcdaFile,
+    const char * gcda_first,
+    const char * gcda_last,
+    const string & dumpFile,
+    const Parse_settings & settings,
+    Source_file_map & source_files,
+    std::ostream & log )
 {
-    try
+    Trace_writer dump_file;
+    const bool is_dump = !dumpFile.empty();
+    if ( is_dump )
     {
-        char buf[4];
- 
-        // Get gcno magic
-        mGcnoFile.read(buf, 4);
-        unsigned int gcnoMagic = *( reinterpret_cast<unsigned int *>(buf) );
+        dump_file.open( dumpFile );
+        dump_file.event( Trace_event::Pair, NULL )
+            .text( gcnoFile ).text( gcdaFile );
+    }
 
-       // Get gcno file length
-        mGcnoFile.seekg(0, ios::end);
-        unsigned int gcnoLength = mGcnoFile.tellg();
-        mGcnoFile.seekg(0, ios::beg);
+    Tru_utility * utility = Tru_utility::get_instance();
+    const string gcno_name = utility->get_filename(gcnoFile);
+    const string gcda_name = utility->get_filename(gcdaFile);
 
-        // Read in gcno file
-        vector<char> gcno_buf(gcnoLength);
-        mGcnoFile.read(&gcno_buf[0], gcnoLength);
+    try
+    {
+        // Get gcno magic
+        unsigned int gcnoMagic = read_magic( gcno_first, gcno_last );
 
         // Check for valid gcno magic
         bool gcno_little_endian = true;
@@ -301,87 +995,189 @@ int Parser::parse()
         }
         else if (gcnoMagic != 0x67636E6F)
         {
-            cerr << "\nERROR: Invalid Gcno file " << m_gcno_name << flush;
+            log << "\nERROR: Invalid Gcno file " << gcno_name << flush;
             return 1;
         }
 
-        Config & config = Config::get_instance();
-        Parser_builder parser_builder( m_source_files,
-            config.get_flag_value(Config::Revision_script),
-            config.get_source_files() );
+        Parser_builder parser_builder( source_files,
+            *settings.m_project,
+            settings.m_known_structures );
+        parser_builder.set_with_lines( settings.m_with_lines );
        
-        // Parse the gcno file
-        Gcno_grammar gcnoGrammar( parser_builder, mIsDump, mDumpFile );
-        global_little_endian = gcno_little_endian;
-        const char * first = &gcno_buf[0];
-        const char * last = &gcno_buf[0] + gcnoLength;
-        SP::parse_info<> info = raw_parse(first, last, gcnoGrammar);
-
-        if (!info.full)
+        Gcov_decoder decoder( parser_builder, is_dump, dump_file );
+
+        // Parse the gcno file in place
+        dump_file.set_base( gcno_first );
+        const char * first = gcno_first;
+        const char * last = gcno_last;
+        bool parsed;
+        if ( settings.m_use_grammar )
+        {
+            Gcno_grammar gcnoGrammar( parser_builder, is_dump, dump_file );
+            parsed = raw_parse(first, last, gcnoGrammar, gcno_little_endian).full;
+        }
+        else
+        {
+            parsed = decoder.decode_gcno(first, last, gcno_little_endian);
+        }
+
+        if (!parsed)
         {
-            cerr << "\nERROR: Failed to parse Gcno file " << m_gcno_name << flush;
+            log << "\nERROR: Failed to parse Gcno file " << gcno_name << flush;
             return 1;
         }
 
-        if ( !mGcdaFile.fail() )
+        // Let the pairs parsed after this one skip the structures decoded
+        if ( settings.m_known_structures != NULL )
+        {
+            settings.m_known_structures->publish( source_files );
+        }
+
+        // Get gcda magic
+        unsigned int gcdaMagic = read_magic( gcda_first, gcda_last );
+ 
+        // Check for valid gcda magic
+        bool gcda_little_endian = true;
+        if (gcdaMagic == 0x61646367)
+        {
+            // Set little endian
+            gcda_little_endian = false;
+        }
+        else if (gcdaMagic != 0x67636461)
+        {
+            log << "\nERROR: Invalid Gcda file " << gcda_name << flush;
+        }
+        
+        // Parse the gcda file in place
+        dump_file.set_base( gcda_first );
+        first = gcda_first;
+        last = gcda_last;
+        if ( settings.m_use_grammar )
+        {
+            Gcda_grammar gcdaGrammar( parser_builder, is_dump, dump_file );
+            parsed = raw_parse( first, last, gcdaGrammar, gcda_little_endian ).full;
+        }
+        else
+        {
+            parsed = decoder.decode_gcda( first, last, gcda_little_endian );
+        }
+
+        if (!parsed)
+        {
+            log << "\nERROR: Failed to parse Gcda file " << gcda_name << flush;
+            return 1;
+        }
+    }
+    catch (exception e)
+    {
+        return 1;
+    }
+
+    return 0;
+
+} // end of Parser::parse_buffers(...)
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Merges the source files parsed from one gcno and gcda pair into the
+/// source files of the project.
+///
+/// @param parsed The source files of the pair, left in an unspecified
+///               state.
+///
+/// @remarks
+/// A record already parsed from an earlier pair keeps its graph and adds
+/// up the counts, the same as Parser_builder merging a repeated record.
+/// A record parsed without its graph, because another pair decoded it,
+/// takes the graph of the first record of the function that has one.
+///////////////////////////////////////////////////////////////////////////
+void Parser::merge_source_files( Source_file_map & parsed )
+{
+    for ( Source_file_map::iterator src = parsed.begin();
+          src != parsed.end();
+          ++src )
+    {
+        Source_file & source = m_source_files[src->first];
+        source.m_source_path = src->second.m_source_path;
+        if ( ! src->second.m_revision_number.empty() )
         {
+            source.m_revision_number = src->second.m_revision_number;
+        }
 
-            // Get gcda magic
-            mGcdaFile.read(buf, 4);
-            unsigned int gcdaMagic = *( reinterpret_cast<unsigned int *>(buf) );
-
-            // Get gcda file length
-            mGcdaFile.seekg(0, ios::end);
-            unsigned int gcdaLength = mGcdaFile.tellg();
-            mGcdaFile.seekg(0, ios::beg);
-
-            // Read in gcda file
-            vector<char> gcda_buf(gcdaLength);
-            mGcdaFile.read(&gcda_buf[0], gcdaLength);
-     
-            // Check for valid gcda magic
-            bool gcda_little_endian = true;
-            if (gcdaMagic == 0x61646367)
+        Source_file::Record_map & records = 
+            src->second.m_records;
+        for ( Source_file::Record_map::iterator rec = 
+                 records.begin();
+              rec != records.end();
+              ++rec )
+        {
+            Record & merged = source.m_records[rec->first];
+            if ( merged.m_blocks.empty() && 
+                 ( ! rec->second.m_blocks.empty() || merged.m_counts.empty() ) )
             {
-                // Set little endian
-                gcda_little_endian = false;
+                // Keep the structure, and any counts parsed without it
+                merged.swap( rec->second );
             }
-            else if (gcdaMagic != 0x67636461)
+            else
             {
-                cerr << "\nERROR: Invalid Gcda file " << m_gcda_name << flush;
+                merged.m_ident = rec->second.m_ident;
             }
-            
-            // Parse the gcda file
-            Gcda_grammar gcdaGrammar( parser_builder, mIsDump, mDumpFile );
-            global_little_endian = gcda_little_endian;
-            first = &gcda_buf[0];
-            last = &gcda_buf[0] + gcdaLength;
-            info = raw_parse( first, last, gcdaGrammar );
-
-            if (!info.full)
+
+            // Merge counts
+            const size_t count = 
+                std::min( merged.m_counts.size(), rec->second.m_counts.size() );
+            for ( size_t i = 0; i < count; ++i )
             {
-                cerr << "\nERROR: Failed to parse Gcda file " << m_gcda_name << flush;
-                return 1;
+                merged.m_counts[i] += rec->second.m_counts[i];
             }
         }
     }
-    catch (exception e)
-    {
-        return 1;
-    }
+} // end of Parser::merge_source_files(...)
 
-    return 0;
+///////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Gives the records still without a graph the graph decoded by another
+/// pair. This only happens when the pair owning the graph failed after
+/// decoding its gcno file, so it was not merged.
+///
+/// @param known The structures decoded by the pairs of the batch.
+///////////////////////////////////////////////////////////////////////////
+void Parser::fill_known_structures( const Known_structures & known )
+{
+    for ( Source_file_map::iterator src = m_source_files.begin();
+          src != m_source_files.end();
+          ++src )
+    {
+        Source_file::Record_map & records = 
+            src->second.m_records;
+        for ( Source_file::Record_map::iterator rec = 
+                 records.begin();
+              rec != records.end();
+              ++rec )
+        {
+            if ( ! rec->second.m_blocks.empty() )
+            {
+                continue;
+            }
 
-} // end of void Parse()
+            Record * owner = known.find_structure( src->first, rec->first );
+            if ( owner != NULL )
+            {
+                rec->second.swap_graph( *owner );
+            }
+        }
+    }
+} // end of Parser::fill_known_structures(...)
 
-map<string, Source_file> & Parser::get_source_files()
+Source_file_map & Parser::get_source_files()
 {
     return m_source_files;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 ///  @brief
-///  Assigns each block's fromArc vector pointers to any entry arcs
+///  Builds the flow graph of each record, which groups the arcs by the
+///  block they leave and indexes the arcs entering each block
 ///
 ///  @remarks
 ///  Pre conditions: map of records is initialized, arc list is populated.
@@ -389,33 +1185,20 @@ map<string, Source_file> & Parser::get_source_files()
 void Parser::assign_entry_arcs()
 {
    // For all source files
-   for ( map<string, Source_file>::iterator source_iter = 
+   for ( Source_file_map::iterator source_iter = 
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    { 
-      map<Source_file::Source_key, Record> & records = 
+      Source_file::Record_map & records = 
       source_iter->second.m_records;
  
       // For each record (function)
-      for( map<Source_file::Source_key, Record>::iterator i = records.begin(); 
+      for( Source_file::Record_map::iterator i = records.begin(); 
            i != records.end(); 
            ++i )
       {
-         unsigned source = 0;
-
-         // For each block within function
-         for( unsigned j = 0; j < i->second.m_blocks.size(); ++j )
-         {
-            // For each arc
-            for ( unsigned k = 0; k < i->second.m_blocks[j].m_arcs.size(); ++k )
-            {
-               // Assign destination block a pointer to the arc entering it
-               unsigned dest = i->second.m_blocks[j].m_arcs[k].m_dest_block;
-               i->second.m_blocks[dest].m_from_arcs.push_back( &(i->second.m_blocks[j].m_arcs[k]) );
-            }
-            ++source;
-         }
+         i->second.build();
       }
    }
 }
@@ -433,40 +1216,37 @@ void Parser::assign_entry_arcs()
 void Parser::assign_arc_counts()
 {
    // For all source files
-   for ( map<string, Source_file>::iterator source_iter =
+   for ( Source_file_map::iterator source_iter =
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    {
-      map<Source_file::Source_key, Record> & records = 
+      Source_file::Record_map & records = 
          source_iter->second.m_records;
 
       // For each record (function)
-      for ( map<Source_file::Source_key, Record>::iterator i = 
+      for ( Source_file::Record_map::iterator i = 
                records.begin(); 
             i != records.end(); 
             ++i )
       {
          unsigned pos = 0;
+         vector<Arc> & arcs = i->second.m_graph.m_arcs;
 
-         // For each block
-         for ( unsigned j = 0; j < i->second.m_blocks.size(); ++j )
+         // For each arc, in the order of the blocks they leave
+         for ( unsigned k = 0; k < arcs.size(); ++k )
          {
-            // For each arc
-            for ( unsigned k = 0; k < i->second.m_blocks[j].m_arcs.size(); ++k )
+            // Test if lowest bit is not set and if so then assign arc count
+            if ( ! ( arcs[k].m_flag & 1 ) )
             {
-               // Test if lowest bit is not set and if so then assign arc count
-               if ( ! ( i->second.m_blocks[j].m_arcs[k].m_flag & 1 ) )
-               {
-                  i->second.m_blocks[j].m_arcs[k].m_count =
-                     static_cast<int64_t>( i->second.m_counts.at( pos ) );
-                  pos++;
-               }
-               else
-               {
-                  // Arcs without GCDA data are assigned -1 before they are normalized
-                  i->second.m_blocks[j].m_arcs[k].m_count = -1;
-               }
+               arcs[k].m_count =
+                  static_cast<int64_t>( i->second.m_counts.at( pos ) );
+               pos++;
+            }
+            else
+            {
+               // Arcs without GCDA data are assigned -1 before they are normalized
+               arcs[k].m_count = -1;
             }
          }
       }
@@ -488,19 +1268,21 @@ void Parser::normalize_arcs()
    bool normalized;
 
    // For all source files
-   for ( map<string, Source_file>::iterator source_iter =
+   for ( Source_file_map::iterator source_iter =
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    {
-      map<Source_file::Source_key, Record> & records = 
+      Source_file::Record_map & records = 
          source_iter->second.m_records;
 
       // For each record (function)
-      for ( map<Source_file::Source_key, Record>::iterator i = records.begin(); 
+      for ( Source_file::Record_map::iterator i = records.begin(); 
             i != records.end(); 
             ++i )
       {
+         Flow_graph & graph = i->second.m_graph;
+
          do {
             // Initialize normalized to false
             normalized = false;
@@ -518,10 +1300,12 @@ void Parser::normalize_arcs()
                   unsigned fromArcCountTotal = 0;
 
                   // For each arc in block
-                  for ( unsigned k = 0; k < i->second.m_blocks[j].m_arcs.size(); ++k )
+                  for ( unsigned k = 0; k < graph.get_arc_count( j ); ++k )
                   {
-                     // If arc hasn't been normalized
-                     if ( i->second.m_blocks[j].m_arcs[k].m_count == -1 )
+                     // If arc hasn't been normalized. Only the arcs without
+                     // GCDA data are, as a counted arc may hold -1.
+                     if ( ( graph.get_arc( j, k ).m_flag & 1 )
+                          && graph.get_arc( j, k ).m_count == -1 )
                      {
                         // Increment count and store arc number
                         ++count;
@@ -530,15 +1314,16 @@ void Parser::normalize_arcs()
                      else
                      {
                         // Add arc's count to arc count total
-                        arcCountTotal += i->second.m_blocks[j].m_arcs[k].m_count;
+                        arcCountTotal += graph.get_arc( j, k ).m_count;
                      }
                   }
 
                   // For each arc entering the block
-                  for ( unsigned k = 0; k < i->second.m_blocks[j].m_from_arcs.size(); ++k )
+                  for ( unsigned k = 0; k < graph.get_from_arc_count( j ); ++k )
                   {
                      // If arc hasn't been normalized
-                     if ( i->second.m_blocks[j].m_from_arcs[k]->m_count == -1 )
+                     if ( ( graph.get_from_arc( j, k ).m_flag & 1 )
+                          && graph.get_from_arc( j, k ).m_count == -1 )
                      {
                         // Increment count and store arc number
                         ++count;
@@ -547,7 +1332,7 @@ void Parser::normalize_arcs()
                      else
                      {
                         // Add entering arc's count to entering arc count total
-                        fromArcCountTotal += i->second.m_blocks[j].m_from_arcs[k]->m_count;
+                        fromArcCountTotal += graph.get_from_arc( j, k ).m_count;
                      }
                   }
 
@@ -573,22 +1358,23 @@ void Parser::normalize_arcs()
                      }
 
                      // If number of exiting arcs is >= arc location
-                     if ( i->second.m_blocks[j].m_arcs.size() >= loc + 1)
+                     if ( graph.get_arc_count( j ) >= loc + 1)
                      {
                         // Assign count to non-normalized arc
-                        if ( i->second.m_blocks[j].m_arcs[loc].m_count == -1 )
+                        if ( ( graph.get_arc( j, loc ).m_flag & 1 )
+                             && graph.get_arc( j, loc ).m_count == -1 )
                         {
-                           i->second.m_blocks[j].m_arcs[loc].m_count = diff;
+                           graph.get_arc( j, loc ).m_count = diff;
                         }
                         else
                         {
-                           i->second.m_blocks[j].m_from_arcs[loc]->m_count = diff;
+                           graph.get_from_arc( j, loc ).m_count = diff;
                         }
                      }
                      // Assign count to entering arc
                      else
                      {
-                        i->second.m_blocks[j].m_from_arcs[loc]->m_count = diff;
+                        graph.get_from_arc( j, loc ).m_count = diff;
                      }
 
                      // Mark block as normalized
@@ -633,12 +1419,12 @@ void Parser::normalize_lines()
    Tru_utility * ptr_utility = Tru_utility::get_instance();
 
    // For all source files
-   for ( map<string, Source_file>::iterator source_iter =
+   for ( Source_file_map::iterator source_iter =
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    {
-      map<Source_file::Source_key, Record> & records = 
+      Source_file::Record_map & records = 
          source_iter->second.m_records;
       vector<unsigned> first_line;
 
@@ -646,30 +1432,30 @@ void Parser::normalize_lines()
       order_by_line( first_line, records );
 
       // For each Record (function)
-      for ( map<Source_file::Source_key, Record>::iterator i = records.begin();
+      for ( Source_file::Record_map::iterator i = records.begin();
             i != records.end(); ++i )
       {
          Record & rec = i->second;
          int last_line = find_last_line( first_line, rec );
 
+         Line_table & table = rec.m_line_table;
+
          // For each block
          for ( unsigned j = 0; j < rec.m_blocks.size(); ++j )
          {
             rec.m_blocks[j].m_inlined = false;
 
-            // For each Lines_data object
-            for ( map<string, Lines_data>::iterator lines_iter = 
-                  rec.m_blocks[j].m_lines.begin();
-                  lines_iter != rec.m_blocks[j].m_lines.end();
-                  ++lines_iter )
+            // For each source file of the block
+            for ( unsigned k = 0; k < table.get_source_count( j ); ++k )
             {
-               Lines_data & line_data = lines_iter->second;
                // Mark appropriate Line structs as inlined
-               assign_inline_status( line_data, lines_iter->first, rec, last_line );
+               assign_inline_status( table.get_first_line( j, k ),
+                  table.get_lines( j, k ).size(), table.get_source( j, k ),
+                  rec, last_line );
             }
 
             // If a block has no lines and the block is not a start or end block
-            if ( rec.m_blocks[j].m_lines.empty()
+            if ( table.get_source_count( j ) == 0
                  && ! rec.m_blocks[j].is_start_block()
                  && ! rec.m_blocks[j].is_end_block() )
             {
@@ -677,27 +1463,23 @@ void Parser::normalize_lines()
 
                // If a block's parent block has line numbers and parent block
                // is not the start block
-               unsigned origin_block = rec.m_blocks[j].m_from_arcs.front()->m_origin_block;
-               if ( rec.m_blocks[ origin_block ].m_lines.find( rec.m_source )
-                    != rec.m_blocks[ origin_block ].m_lines.end()
+               unsigned origin_block = rec.m_graph.get_from_arc( j, 0 ).m_origin_block;
+               if ( table.find_source( origin_block, rec.m_source )
+                    != table.get_source_count( origin_block )
                     && ! rec.m_blocks[ origin_block ].is_start_block() )
                {
-                  // For each Lines_data
-                  for ( map<string, Lines_data>::iterator lines_iter =
-                        rec.m_blocks[ origin_block ].m_lines.begin();
-                        lines_iter != rec.m_blocks[ origin_block ].m_lines.end();
-                        ++lines_iter )
+                  // For each source file of the parent block
+                  for ( unsigned k = 0; k < table.get_source_count( origin_block ); ++k )
                   {
-                     Lines_data & line_data = lines_iter->second;
                      // Assign the line data of a parent block from the current
                      // source file
-                     assign_line_current( line_data, rec, j );
+                     assign_line_current( table.get_lines( origin_block, k ), rec, j );
                   }
                }
                else
                {
                   // Assign the line data of a parent block with inlined data
-                  assign_line_inlined( rec.m_blocks[ origin_block ].m_lines, rec, j );
+                  assign_line_inlined( origin_block, rec, j );
                }
             }
 
@@ -705,23 +1487,19 @@ void Parser::normalize_lines()
             if ( ! rec.m_blocks[j].is_start_block()
                  && ! rec.m_blocks[j].is_end_block() )
             {
-               // For each Lines_data
-               for ( map<string, Lines_data>::iterator lines_iter = 
-                     i->second.m_blocks[j].m_lines.begin();
-                     lines_iter != i->second.m_blocks[j].m_lines.end();
-                     ++lines_iter )
+               // For each source file of the block
+               for ( unsigned k = 0; k < table.get_source_count( j ); ++k )
                {
-                  Lines_data & line_data = lines_iter->second;
-
-                  // If Lines_data is for current source file
-                  if ( rec.m_source == lines_iter->first )
+                  // If the lines are from the current source file
+                  if ( rec.m_source == table.get_source( j, k ) )
                   {
                      // Create a vector of current block's non-inlined lines
-                     for ( unsigned k = 0; k < line_data.m_lines.size(); ++k )
+                     Line_range lines = table.get_lines( j, k );
+                     for ( unsigned l = 0; l < lines.size(); ++l )
                      {
-                        if ( line_data.m_lines[k].m_inlined == false )
+                        if ( lines[l].m_inlined == false )
                         {
-                           rec.m_blocks[j].m_non_inlined.push_back( line_data.m_lines[k] );
+                           rec.m_blocks[j].m_non_inlined.push_back( lines[l] );
                         }
                      }
                   }
@@ -730,7 +1508,7 @@ void Parser::normalize_lines()
 
             // If no parent blocks have associated line numbers then
             // mark block as such with a -1 line number
-            if ( rec.m_blocks[j].m_lines.empty()
+            if ( table.get_source_count( j ) == 0
                  && ! rec.m_blocks[j].is_start_block()
                  && ! rec.m_blocks[j].is_end_block() )
             {
@@ -738,7 +1516,7 @@ void Parser::normalize_lines()
                l.m_line_num = -1;
                l.m_inlined = false;
 
-               rec.m_blocks[j].m_lines[ rec.m_source ].m_lines.push_back( l );
+               table.push_line( j, rec.m_source, l );
             }
          }
       }
@@ -757,16 +1535,16 @@ void Parser::normalize_lines()
 void Parser::normalize_fake_blocks()
 {
    // For all source files
-   for ( map<string, Source_file>::iterator source_iter =
+   for ( Source_file_map::iterator source_iter =
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    {
-      map<Source_file::Source_key, Record> & records = 
+      Source_file::Record_map & records = 
          source_iter->second.m_records;
 
       // For each Record (function)
-      for ( map<Source_file::Source_key, Record>::iterator i = records.begin();
+      for ( Source_file::Record_map::iterator i = records.begin();
             i != records.end(); ++i )
       {
          bool done;
@@ -788,11 +1566,11 @@ void Parser::normalize_fake_blocks()
                   // First case: Check if all incoming arcs to a block are fake
                   bool found_real = false;
                   
-                  for ( unsigned k = 0; k < block_ref.m_from_arcs.size(); ++k )
+                  for ( unsigned k = 0; k < block_ref.get_from_arc_count(); ++k )
                   {
                      // If a non-fake entry arc is found, set found flag and
                      // exit loop
-                     if ( ! block_ref.m_from_arcs[k]->is_fake() )
+                     if ( ! block_ref.get_from_arc( k ).is_fake() )
                      {
                         found_real = true;
                         break;
@@ -811,11 +1589,11 @@ void Parser::normalize_fake_blocks()
                   // fake
                   found_real = false;
 
-                  for ( unsigned k = 0; k < block_ref.m_from_arcs.size(); ++k )
+                  for ( unsigned k = 0; k < block_ref.get_from_arc_count(); ++k )
                   {
                      // If a non-fake parent block is found, set found flag
                      // and exit loop
-                     if ( ! i->second.m_blocks[ block_ref.m_from_arcs[k]->m_origin_block ].is_fake() )
+                     if ( ! i->second.m_blocks[ block_ref.get_from_arc( k ).m_origin_block ].is_fake() )
                      {
                         found_real = true;
                         break;
@@ -843,16 +1621,16 @@ void Parser::calculate_total_coverage()
 {
    m_coverage_percentage = 0;
    
-   for ( map<string, Source_file>::iterator source_iter =
+   for ( Source_file_map::iterator source_iter =
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    {
-      const map<Source_file::Source_key, Record> & records =
+      const Source_file::Record_map & records =
          source_iter->second.m_records;
 
       source_iter->second.m_coverage_percentage = 0;
-      for ( map<Source_file::Source_key, Record>::const_iterator rec_iter = records.begin();
+      for ( Source_file::Record_map::const_iterator rec_iter = records.begin();
             rec_iter != records.end();
             ++rec_iter )
       {
@@ -882,10 +1660,10 @@ void Parser::calculate_total_coverage()
 ///  @return void
 ///////////////////////////////////////////////////////////////////////////
 void Parser::order_by_line( vector<unsigned> & first_line,
-   const map<Source_file::Source_key, Record> & records )
+   const Source_file::Record_map & records )
 {
    // For each Record (function)
-   for ( map<Source_file::Source_key, Record>::const_iterator i = records.begin();
+   for ( Source_file::Record_map::const_iterator i = records.begin();
          i != records.end(); ++i )
    {
       // Store the first line number of each function into a vector
@@ -929,52 +1707,52 @@ int Parser::find_last_line( const std::vector<unsigned> & first_line,
 ///
 ///  @return void
 ///////////////////////////////////////////////////////////////////////////
-void Parser::assign_inline_status( Lines_data & line_data, const string & source,
-   Record & rec, const unsigned last_line )
+void Parser::assign_inline_status( Line * lines, unsigned size,
+   String_id source, Record & rec, const unsigned last_line )
 {
    // Get instances of Config and Tru_utility classes
    Config & config = Config::get_instance();
    Tru_utility * ptr_utility = Tru_utility::get_instance();
 
+   // The lines are already sorted by the line table
    string source_path;
-   std::sort( line_data.m_lines.begin(), line_data.m_lines.end(), compare_lines);
 
    // If line data comes from a source file not within project,
    // mark lines as inlined
    if ( ! ptr_utility->is_within_project( config.get_source_files(), source, source_path ) )
    {
-      for ( unsigned k = 0; k < line_data.m_lines.size(); ++k )
+      for ( unsigned k = 0; k < size; ++k )
       {
-         line_data.m_lines[k].m_inlined = true;
+         lines[k].m_inlined = true;
       }
    }
    // If line data comes from a source file other than the current
    // source file, mark lines as inlined
    else if ( source != rec.m_source )
    {
-      for ( unsigned k = 0; k < line_data.m_lines.size(); ++k )
+      for ( unsigned k = 0; k < size; ++k )
       {
-         line_data.m_lines[k].m_inlined = true;
+         lines[k].m_inlined = true;
       }
    }
    else
    {
       // For each line within the current record and current source file
-      for ( unsigned k = 0; k < line_data.m_lines.size(); ++k )
+      for ( unsigned k = 0; k < size; ++k )
       {
          // Mark line as inlined if line number is less than the first
          // line number of the function
-         if ( line_data.m_lines[k].m_line_num < rec.m_line_num )
+         if ( lines[k].m_line_num < rec.m_line_num )
          {
-            line_data.m_lines[k].m_inlined = true;
+            lines[k].m_inlined = true;
          }
          // Mark line as inlined if line number is greater than last line
          // number of the function, except if function is the last function
          // of the source file
          else if ( last_line != -1
-                   && line_data.m_lines[k].m_line_num > last_line )
+                   && lines[k].m_line_num > last_line )
          {
-            line_data.m_lines[k].m_inlined = true;
+            lines[k].m_inlined = true;
          }
       }
    }
@@ -987,29 +1765,24 @@ void Parser::assign_inline_status( Lines_data & line_data, const string & source
 ///
 ///  @return void
 ///////////////////////////////////////////////////////////////////////////
-void Parser::assign_line_current( Lines_data & line_data, Record & rec,
+void Parser::assign_line_current( Line_range lines, Record & rec,
    unsigned block_no )
 {
-   Line line;
+   // If no non-inlined source lines, store first inlined line
+   // into current block
+   Line line = lines[0];
 
    // For each source line
-   for ( unsigned k = 0; k < line_data.m_lines.size(); ++k )
+   for ( unsigned k = 0; k < lines.size(); ++k )
    {
       // If source line is not inlined, store Line into current block
-      if ( line_data.m_lines[k].m_inlined == false )
+      if ( lines[k].m_inlined == false )
       {
-         line = line_data.m_lines[k];
+         line = lines[k];
       }
    }
 
-   rec.m_blocks[block_no].m_lines[ rec.m_source ].m_lines.push_back( line );
-
-   // If no non-inlined source lines, store first inlined line
-   // into current block
-   if ( rec.m_blocks[block_no].m_lines.empty() )
-   {
-      rec.m_blocks[block_no].m_lines[ rec.m_source ].m_lines.push_back( line_data.m_lines.front() );
-   }
+   rec.m_line_table.push_line( block_no, rec.m_source, line );
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -1019,73 +1792,103 @@ void Parser::assign_line_current( Lines_data & line_data, Record & rec,
 ///
 ///  @return void
 ///////////////////////////////////////////////////////////////////////////
-void Parser::assign_line_inlined( map<string, Lines_data> & lines, Record & rec, unsigned block_no )
+void Parser::assign_line_inlined( unsigned origin_block, Record & rec,
+   unsigned block_no )
 {
    // Get instances of Config and Tru_utility classes
    Config & config = Config::get_instance();
    Tru_utility * ptr_utility = Tru_utility::get_instance();
+   Line_table & table = rec.m_line_table;
 
    // Look for lines from a project source file
 
-   // For each Lines_data
-   for ( map<string, Lines_data>::iterator lines_iter = lines.begin();
-         lines_iter != lines.end(); ++lines_iter )
+   // For each source file of the parent block
+   for ( unsigned k = 0; k < table.get_source_count( origin_block ); ++k )
    {
-      Lines_data & line_data = lines_iter->second;
-
       // If source line is from an inlined file within the project
       // store first line into current block
       string source_path;
-      if ( ! ptr_utility->is_within_project( config.get_source_files(), lines_iter->first, source_path ) )
+      if ( ! ptr_utility->is_within_project( config.get_source_files(), 
+                table.get_source( origin_block, k ), source_path ) )
       {
-         rec.m_blocks[block_no].m_lines[ lines_iter->first ].m_lines.push_back( line_data.m_lines.front() );
+         const Line line = table.get_lines( origin_block, k )[0];
+         table.push_line( block_no, table.get_source( origin_block, k ), line );
          break;
       }
    }
 
    // Else, look for lines from an outside source file
-   if ( rec.m_blocks[block_no].m_lines.empty() )
+   if ( table.get_source_count( block_no ) == 0
+        && table.get_source_count( origin_block ) != 0 )
    {
-      // For each Lines_data
-      for ( map<string, Lines_data>::iterator lines_iter = lines.begin();
-            lines_iter != lines.end(); ++lines_iter )
-      {
-         Lines_data & line_data = lines_iter->second;
-
-         // Store source line from outside source file into current block
-         rec.m_blocks[block_no].m_lines[ lines_iter->first ].m_lines.push_back( line_data.m_lines.front() );
-         break;
-      }                  
+      // Store source line from outside source file into current block
+      const Line line = table.get_lines( origin_block, 0 )[0];
+      table.push_line( block_no, table.get_source( origin_block, 0 ), line );
    }
 }
 
 /////////////////////////////////////////////////////////////////////////
 ///  @brief
-///  Populate m_blocks_sorted with Blocks sorted by line #
+///  Orders block numbers by the last line numbers of their blocks
+///////////////////////////////////////////////////////////////////////////
+class Block_order_less
+{
+public:
+
+   explicit Block_order_less( const vector<Block> & blocks )
+      : m_blocks( blocks )
+   {
+      // void
+   }
+
+   bool operator()( unsigned lhs, unsigned rhs ) const
+   {
+      return compare_line_nums( m_blocks[lhs], m_blocks[rhs] );
+   }
+
+private:
+
+   /// The blocks of the record.
+   const vector<Block> & m_blocks;
+};
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Populate m_block_order with the block numbers sorted by line #
 ///
 ///  @return void
 ///
-///  @pre m_blocks_sorted is empty
-///  @post m_blocks_sorted contains a vector of Blocks sorted by line #
+///  @post m_block_order holds the number of every block, the start and
+///  end blocks first and last, and the others sorted by line #
 ///////////////////////////////////////////////////////////////////////////
 void Parser::sort_blocks()
 {
    // For all source files
-   for ( map<string, Source_file>::iterator source_iter =
+   for ( Source_file_map::iterator source_iter =
             m_source_files.begin();
          source_iter != m_source_files.end();
          source_iter++ )
    {
-      map<Source_file::Source_key, Record> & records = 
+      Source_file::Record_map & records = 
          source_iter->second.m_records;
 
       // For each Record (function)
-      for ( map<Source_file::Source_key, Record>::iterator i = records.begin();
+      for ( Source_file::Record_map::iterator i = records.begin();
             i != records.end(); ++i )
       {
-         i->second.m_blocks_sorted = i->second.m_blocks;
-         std::sort( i->second.m_blocks_sorted.begin() + 1, 
-                    i->second.m_blocks_sorted.end() - 1, compare_line_nums);
+         Record & rec = i->second;
+         rec.m_block_order.resize( rec.m_blocks.size() );
+         for ( unsigned j = 0; j < rec.m_block_order.size(); ++j )
+         {
+            rec.m_block_order[j] = j;
+         }
+
+         if ( rec.m_block_order.size() > 2 )
+         {
+            std::sort( rec.m_block_order.begin() + 1, 
+                       rec.m_block_order.end() - 1, 
+                       Block_order_less( rec.m_blocks ) );
+         }
       }
    }
 }
@@ -1099,8 +1902,8 @@ void Parser::sort_blocks()
 ///////////////////////////////////////////////////////////////////////////
 const bool compare_line_nums( const Block & lhs, const Block & rhs )
 {
-   const vector<Line> & lines_lhs = lhs.get_non_inlined();
-   const vector<Line> & lines_rhs = rhs.get_non_inlined();
+   const Line_list & lines_lhs = lhs.get_non_inlined();
+   const Line_list & lines_rhs = rhs.get_non_inlined();
 
    if ( ! lines_lhs.empty() && ! lines_rhs.empty() )
    {
@@ -1114,15 +1917,3 @@ const bool compare_line_nums( const Block & lhs, const Block & rhs )
       return ! lines_lhs.empty();
    }
 }
-
-/////////////////////////////////////////////////////////////////////////
-///
-///  @brief
-///  Returns true if left Line number < right Line number
-///
-///  @return bool
-///////////////////////////////////////////////////////////////////////////
-const bool compare_lines( const Line & lhs, const Line & rhs )
-{
-   return lhs.m_line_num < rhs.m_line_num;
-}
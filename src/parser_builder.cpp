@@ -30,7 +30,7 @@
 
 // LOCAL INCLUDES
 
-#include <cxxabi.h>
+#include <algorithm>
 
 #include "parser_builder.h"
 
@@ -48,22 +48,43 @@ using std::vector;
 /// data of the Parser class.
 ///////////////////////////////////////////////////////////////////////////////
 Parser_builder::Parser_builder( 
-   map<string, Source_file> & source_files,
-   const string & revision_script_path,
-   vector<string> found_source_files )
-   : m_source_files( source_files ),
-     m_revision_script_manager( revision_script_path ),
-     m_demangle_size(64),
-     m_demangle_buffer(reinterpret_cast<char*>(std::malloc(m_demangle_size)))
+   Source_file_map & source_files,
+   const Project_context & project,
+   const Known_structures * known_structures )
+   : m_last_record_stored( NULL ),
+     m_source_files( source_files ),
+     m_project( project ),
+     m_known_structures( known_structures ),
+     m_last_record_selected( false ),
+     m_merging( false ),
+     m_with_lines( true ),
+     m_line_source_id( String_table::Empty )
 {
-   m_found_source_files = found_source_files;
+   // void
 } // End of Parser_builder constructor
 
 ///////////////////////////////////////////////////////////////////////////////
-Parser_builder::~Parser_builder( )
+/// @brief
+/// Initializes the Parser_builder with a project context of its own.
+///////////////////////////////////////////////////////////////////////////////
+Parser_builder::Parser_builder( 
+   Source_file_map & source_files,
+   const string & revision_script_path,
+   const vector<string> & found_source_files,
+   const Known_structures * known_structures )
+   : m_last_record_stored( NULL ),
+     m_source_files( source_files ),
+     m_own_project( 
+        new Project_context( found_source_files, revision_script_path ) ),
+     m_project( *m_own_project ),
+     m_known_structures( known_structures ),
+     m_last_record_selected( false ),
+     m_merging( false ),
+     m_with_lines( true ),
+     m_line_source_id( String_table::Empty )
 {
-	std::free( m_demangle_buffer );
-}
+   // void
+} // End of Parser_builder constructor
 
 //////////////////////////////////////////////////////////////////////////////
 /// @brief 
@@ -74,7 +95,7 @@ Parser_builder::~Parser_builder( )
 /// @param rChecksum The record unique checksum.
 /// @param rSource The record source file name.
 /// @param rName The record source name.
-/// @param m_name_demangled The demangled name of the record source name. 
+/// @param rLineno The first line of the record.
 //////////////////////////////////////////////////////////////////////////////
 void Parser_builder::store_record( 
    unsigned int rIdent, 
@@ -86,87 +107,76 @@ void Parser_builder::store_record(
    // New record, so set merging mode to false
    m_merging = false;
 
-   int status;
-   char* buffer = abi::__cxa_demangle( rName.c_str(), m_demangle_buffer, &m_demangle_size, &status );
-   string rec_name;
-   if( buffer )
-   {
-      // Demangling was successful.
-      assert( status == 0 );
+   // Get instance of Selector class
+   Selector & selector = Selector::get_instance();
 
-      m_demangle_buffer = buffer;
-      rec_name.assign(buffer);
-   }
-   else
+   // Functions of sources outside the project, such as system headers, are
+   // dropped before their name is matched. The decoder then skips the
+   // rest of their records.
+   const Project_source * project_source = m_project.find_source( rSource );
+   if ( project_source == NULL )
    {
-      // Demangling should never fail other than when the name wasn't demangleable.
-      assert( status == -2 );
-
-      rec_name = rName;
+      m_last_record_selected = false;
+      return;
    }
-   assert(m_demangle_size != 0 );
-
-   // Get instances of Selector and Tru_utility classes
-   Selector & selector = Selector::get_instance();
-   Tru_utility * ptr_utility = Tru_utility::get_instance();
-   
-   string source_path;
 
-   // If source file and fuction are both within project and selected
-   if ( ptr_utility->is_within_project( m_found_source_files, rSource, 
-      source_path ) && selector.is_selected( rSource, rec_name ) )
+   // If fuction is selected. The selector demangles the name only when it
+   // matches it against the selection.
+   if ( selector.is_selected( rSource, rName ) )
    {
       // Get source file 
-      m_source_files[rSource].m_source_path = source_path;
+      Source_file & source_file = m_source_files[rSource];
+      source_file.m_source_path = project_source->m_path;
  
-      // Get revision number if revision script is supplied
-      string revision_number = m_revision_script_manager.get_revision_number(
-         ptr_utility->get_abs_path( source_path ) );  
-      if ( revision_number.size() != 0 )
+      // Set the revision number resolved for the project
+      if ( ! project_source->m_revision_number.empty() )
       {
-         m_source_files[rSource].m_revision_number = revision_number; 
+         source_file.m_revision_number = project_source->m_revision_number; 
       }
 
       // Remember this record was selected.
       m_last_record_selected = true;      
-      map<Source_file::Source_key, Record> & records_data = 
-        m_source_files[rSource].m_records; 
+      const Source_file::Source_key key( rChecksum, rName );
+      Source_file::Record_map & records_data = 
+        source_file.m_records; 
+      const bool seen = records_data.count( key ) != 0;
 
-      // Assign record ident
-      records_data[rChecksum].m_ident    = rIdent;
       // Mark current record as the last record stored
-      set_last_record( records_data, rChecksum );
+      set_last_record( records_data[key] );
+      // Assign record ident
+      get_last_record().m_ident = rIdent;
 
       // Check record's block size to determine if record already has data
       if ( ! get_last_record().m_blocks.empty() )
       {
          // If record already has data, trigger merge mode
          m_merging = true;
-         bool found = false;
-         // Check if record is flagged for merging yet
-         for ( unsigned i = 0; i < m_to_merge.size(); ++i )
-         {
-            if ( m_to_merge[i] == rChecksum )
-            {
-               found = true;
-               break;
-            }
-         }
-         // If not flagged yet, add to list of records to be merged
-         if ( ! found )
-         {
-            m_to_merge.push_back( rChecksum );
-         }
       }
       // New record, so fill data members
       else
       {
          get_last_record().m_checksum = rChecksum;
          get_last_record().m_name     = rName;
-         get_last_record().m_source   = rSource;
-         get_last_record().m_name_demangled = rec_name;
+         get_last_record().m_source   = 
+            String_table::get_instance().intern( rSource );
          get_last_record().m_line_num = rLineno;
+
+         // Another builder already decoded the structure, so only the
+         // counts are stored, as when merging
+         if ( m_known_structures != NULL &&
+              m_known_structures->is_known( rSource, key ) )
+         {
+            m_merging = true;
+         }
       }
+
+      // Index the record for its gcda counts, which are added to those of
+      // a record already seen
+      Count_target & target = 
+         m_record_index[ std::make_pair( rIdent, rChecksum ) ];
+      target.record = &get_last_record();
+      target.merging = seen;
+      target.merged = 0;
    }
    else // Remember this record was not selected.
    {
@@ -218,9 +228,8 @@ void Parser_builder::store_arcs(
    {
       if ( m_last_record_selected )
       {
-         // Construct arc and add it to current block
-         Arc arc( aDestBlock, aBlockno, aFlags );
-         get_last_record().m_blocks[aBlockno].m_arcs.push_back( arc );
+         // Add the arc to the flow graph of the current record
+         get_last_record().add_arc( aBlockno, aDestBlock, aFlags );
       }
    }
 } // End of Parser_builder::store_arcs(...)
@@ -237,42 +246,43 @@ void Parser_builder::store_line_number(
    unsigned int lLineno,
    const string & lName )
 {
-   // Only add lines data to block if not in merging mode
-   if ( ! m_merging )
+   // Only add lines data to block if not in merging mode and wanted
+   if ( ! m_merging && m_with_lines )
    {
       if ( m_last_record_selected )
       {
-         // Add source file line into associated Lines_data entry
-         bool found = false;
-         vector<Line> & lines = get_last_record().m_blocks[lBlockno].m_lines[lName].m_lines;
-         unsigned count = lines.size();
-
-         // Check if line number already exists
-         for ( unsigned i = 0; i < count; ++i )
-         {
-            if ( lines[i].m_line_num == lLineno )
-            {
-               found = true;
-            }
-         }
-
-         // If line number is new, push onto vector
-         if ( ! found )
-         {
-            Line l;
-            l.m_line_num = lLineno;
-            l.m_inlined = false;
-
-            lines.push_back( l );
-         }
+         // Add the line to the record's line table, which drops the
+         // repeated line numbers when it is built
+         get_last_record().add_line( lBlockno, intern_line_source( lName ),
+            lLineno );
       }
    }
 } // End of Parser_builder::store_line_number(...)
 
 //////////////////////////////////////////////////////////////////////////////
 /// @brief
-/// Stores the arc count in the last record added.
+/// Returns the id of the source file of a line. The lines of a function
+/// mostly come from one source file, so its id is kept to skip interning
+/// it again.
 ///
+/// @param lName The source file of the line.
+//////////////////////////////////////////////////////////////////////////////
+String_id Parser_builder::intern_line_source( const string & lName )
+{
+   if ( lName != m_line_source )
+   {
+      m_line_source_id = String_table::get_instance().intern( lName );
+      m_line_source = lName;
+   }
+   return m_line_source_id;
+} // End of Parser_builder::intern_line_source
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Stores the next arc count of a function.
+///
+/// @param rIdent The function unique indentifier.
+/// @param rChecksum The function checksum.
 /// @param aCount The arc count.
 //////////////////////////////////////////////////////////////////////////////
 void Parser_builder::store_count( 
@@ -280,46 +290,135 @@ void Parser_builder::store_count(
    unsigned int rChecksum,
    uint64_t aCount )
 {
-   // Search through all source objects
-   for ( map<string, Source_file>::iterator it = m_source_files.begin();
-         it != m_source_files.end();
-         it++ )
+   store_counts( rIdent, rChecksum, &aCount, 1 );
+} // End of Parser_builder::store_count
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Stores the next run of arc counts of a function. The counts of a new
+/// record are appended, and those of a merged record are added to the
+/// counts already stored.
+///
+/// @param rIdent The function unique indentifier.
+/// @param rChecksum The function checksum.
+/// @param counts The first arc count of the run.
+/// @param size The number of arc counts in the run.
+//////////////////////////////////////////////////////////////////////////////
+void Parser_builder::store_counts( 
+   unsigned int rIdent,
+   unsigned int rChecksum,
+   const uint64_t * counts,
+   std::size_t size )
+{
+   Record_index::iterator found = 
+      m_record_index.find( std::make_pair( rIdent, rChecksum ) );
+
+   // Function was not selected
+   if ( found == m_record_index.end() )
+   {
+      return;
+   }
+
+   Count_target & target = found->second;
+   vector<uint64_t> & record_counts = target.record->m_counts;
+
+   if ( ! target.merging )
+   {
+      record_counts.insert( record_counts.end(), counts, counts + size );
+      return;
+   }
+
+   // Add to the counts already stored, ignoring any past their end
+   const std::size_t first = target.merged;
+   const std::size_t last = 
+      std::min( first + size, static_cast<std::size_t>( record_counts.size() ) );
+   for ( std::size_t i = first; i < last; ++i )
+   {
+      record_counts[i] += counts[i - first];
+   }
+   target.merged += size;
+} // End of Parser_builder::store_counts
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Prepares for another gcda file of the functions already stored. The
+/// functions that have counts add the new counts to them.
+//////////////////////////////////////////////////////////////////////////////
+void Parser_builder::begin_gcda()
+{
+   for ( Record_index::iterator target = m_record_index.begin();
+         target != m_record_index.end(); ++target )
    {
-      map<Source_file::Source_key, Record> & records = 
-         it->second.m_records;   
-      
-      // If record in this source file, then store it
-      if ( records.find( rChecksum ) != records.end() )
+      target->second.merging = target->second.merging ||
+         ! target->second.record->m_counts.empty();
+      target->second.merged = 0;
+   }
+} // End of Parser_builder::begin_gcda
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns if the structure of a function was already published.
+//////////////////////////////////////////////////////////////////////////////
+bool Known_structures::is_known( 
+   const string & source,
+   const Source_file::Source_key & key ) const
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   return m_owners.find( std::make_pair( source, key ) ) != m_owners.end();
+} // End of Known_structures::is_known
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Publishes the functions decoded with their structure. Functions already
+/// published keep their first owner.
+//////////////////////////////////////////////////////////////////////////////
+void Known_structures::publish( Source_file_map & source_files )
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   for ( Source_file_map::iterator src = source_files.begin();
+         src != source_files.end(); ++src )
+   {
+      Source_file::Record_map & records = src->second.m_records;
+      for ( Source_file::Record_map::iterator rec = 
+               records.begin();
+            rec != records.end(); ++rec )
       {
-         bool found = false;
-         // Check if function is flagged for count merging
-         for ( unsigned i = 0; i < m_to_merge.size(); ++i )
-         {
-            if ( m_to_merge[i] == rChecksum )
-            {
-               found = true;
-               break;
-            }
-         }
-         // If not flagged to be merged, push back count data
-         if ( ! found )
+         if ( ! rec->second.m_blocks.empty() )
          {
-            records[rChecksum].m_counts.push_back( aCount );
-            break;
-         }
-         // If flagged to be merged
-         else
-         {
-            // If record has changed, reset index last checksum merged
-            if ( rChecksum != m_last_merge )
-            {
-               m_last_merge = rChecksum;
-               m_index = 0;
-            }
-            // Add new count information to total and increment index
-            records[rChecksum].m_counts[m_index] += aCount;
-            ++m_index;
+            m_owners.insert( std::make_pair( 
+               std::make_pair( src->first, rec->first ), &source_files ) );
          }
       }
-   }   
-} // End of Parser_builder::store_count
+   }
+} // End of Known_structures::publish
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the record holding the published structure of a function.
+//////////////////////////////////////////////////////////////////////////////
+Record * Known_structures::find_structure( 
+   const string & source,
+   const Source_file::Source_key & key ) const
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   Owner_map::const_iterator owner = 
+      m_owners.find( std::make_pair( source, key ) );
+   if ( owner == m_owners.end() )
+   {
+      return NULL;
+   }
+
+   Source_file_map::iterator src = owner->second->find( source );
+   if ( src == owner->second->end() )
+   {
+      return NULL;
+   }
+
+   Source_file::Record_map::iterator rec = 
+      src->second.m_records.find( key );
+   if ( rec == src->second.m_records.end() || rec->second.m_blocks.empty() )
+   {
+      return NULL;
+   }
+   return &rec->second;
+} // End of Known_structures::find_structure
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file project_context.cpp
+///
+///  @brief
+///  Implements the Project_context class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// LOCAL INCLUDES
+
+#include "project_context.h"
+#include "revision_script_manager.h"
+#include "tru_utility.h"
+
+// USING STATEMENTS
+
+using std::string;
+using std::vector;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Indexes the source files and resolves their revision numbers.
+///
+/// @param source_files The source files found in the project directories.
+/// @param revision_script_path The revision script, or empty for none.
+///////////////////////////////////////////////////////////////////////////////
+Project_context::Project_context( 
+   const vector<string> & source_files,
+   const string & revision_script_path )
+   : m_source_files( source_files )
+{
+   Tru_utility * ptr_utility = Tru_utility::get_instance();
+   Revision_script_manager revision_script_manager( revision_script_path );
+
+   m_sources.reserve( m_source_files.size() );
+   for ( size_t i = 0; i < m_source_files.size(); ++i )
+   {
+      const string & path = m_source_files[i];
+
+      // Only the first source of a file name is ever matched
+      if ( ! m_by_name.insert( 
+         std::make_pair( ptr_utility->get_filename( path ), 
+            m_sources.size() ) ).second )
+      {
+         continue;
+      }
+
+      Project_source source;
+      source.m_path = path;
+      if ( revision_script_manager.is_valid() )
+      {
+         source.m_revision_number = 
+            revision_script_manager.get_revision_number( 
+               ptr_utility->get_abs_path( path ) );
+      }
+      m_sources.push_back( source );
+   }
+} // End of Project_context constructor
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the project source file a gcno source file name refers to.
+///
+/// @param source_name The source file name found in a gcno file.
+///
+/// @return The project source, or NULL if the source is not within the
+/// project.
+///////////////////////////////////////////////////////////////////////////////
+const Project_source * Project_context::find_source( 
+   const string & source_name ) const
+{
+   Name_index::const_iterator found = 
+      m_by_name.find( Tru_utility::get_instance()->get_filename( source_name ) );
+
+   if ( found == m_by_name.end() )
+   {
+      return NULL;
+   }
+
+   return &m_sources[found->second];
+} // End of Project_context::find_source( ... )
@@ -35,6 +35,14 @@
 
 #include "record.h"
 
+// SYSTEM INCLUDES
+
+#include <algorithm>
+
+// LOCAL INCLUDES
+
+#include "demangler.h"
+
 using std::vector;
 using std::string;
 using std::map;
@@ -44,18 +52,6 @@ using std::ios;
 using std::cout;
 using std::endl;
 
-/////////////////////////////////////////////////////////////////////////
-///  @brief
-///  Returns the associated source file's line numbers and inline status
-///  for the lines that make up a block
-///
-///  @return const vector<Line> &
-///////////////////////////////////////////////////////////////////////////
-const vector<Line> & Lines_data::get_lines() const
-{
-   return m_lines;
-}
-
 /////////////////////////////////////////////////////////////////////////
 ///  @brief
 ///  Returns whether or not an Arc object is fake depending on its flags
@@ -114,6 +110,357 @@ const unsigned Arc::get_flag() const
    return m_flag;
 }
 
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Adds an arc to the end of the flow graph's arcs
+///
+///  @param origin The arc's origin block number
+///  @param dest The arc's destination block number
+///  @param flag The arc's flag value
+///////////////////////////////////////////////////////////////////////////
+void Flow_graph::add_arc( unsigned origin, unsigned dest, unsigned flag )
+{
+   m_arcs.push_back( Arc( dest, origin, flag ) );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Sorts the arcs by origin block, keeping the order of the arcs of a
+///  block, and indexes the arcs entering each block
+///
+///  @param block_count The number of blocks of the function
+///
+///  @remarks
+///  Both indexes are counting sorts over the block numbers, so building
+///  the graph is linear in its number of blocks and arcs.
+///////////////////////////////////////////////////////////////////////////
+void Flow_graph::build( unsigned block_count )
+{
+   // Make room for any block referenced by an arc
+   for ( unsigned i = 0; i < m_arcs.size(); ++i )
+   {
+      block_count = std::max( block_count, m_arcs[i].m_origin_block + 1 );
+      block_count = std::max( block_count, m_arcs[i].m_dest_block + 1 );
+   }
+
+   // Count the arcs leaving and entering each block
+   m_arc_begin.assign( block_count + 1, 0 );
+   m_from_begin.assign( block_count + 1, 0 );
+   for ( unsigned i = 0; i < m_arcs.size(); ++i )
+   {
+      ++m_arc_begin[ m_arcs[i].m_origin_block + 1 ];
+      ++m_from_begin[ m_arcs[i].m_dest_block + 1 ];
+   }
+
+   for ( unsigned b = 0; b < block_count; ++b )
+   {
+      m_arc_begin[b + 1] += m_arc_begin[b];
+      m_from_begin[b + 1] += m_from_begin[b];
+   }
+
+   // Place each arc after the arcs of its block placed before it
+   vector<unsigned> next( m_arc_begin.begin(), m_arc_begin.end() - 1 );
+   vector<Arc> arcs( m_arcs.size(), Arc( 0, 0, 0 ) );
+   for ( unsigned i = 0; i < m_arcs.size(); ++i )
+   {
+      arcs[ next[ m_arcs[i].m_origin_block ]++ ] = m_arcs[i];
+   }
+   m_arcs.swap( arcs );
+
+   // Index the entering arcs in the order of their origin blocks
+   next.assign( m_from_begin.begin(), m_from_begin.end() - 1 );
+   m_from_arcs.resize( m_arcs.size() );
+   for ( unsigned i = 0; i < m_arcs.size(); ++i )
+   {
+      m_from_arcs[ next[ m_arcs[i].m_dest_block ]++ ] = i;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Exchanges the arrays with another flow graph
+///////////////////////////////////////////////////////////////////////////
+void Flow_graph::swap( Flow_graph & other )
+{
+   m_arcs.swap( other.m_arcs );
+   m_arc_begin.swap( other.m_arc_begin );
+   m_from_arcs.swap( other.m_from_arcs );
+   m_from_begin.swap( other.m_from_begin );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the arcs leaving a block
+///
+///  @return An empty range if the graph was not built with the block
+///////////////////////////////////////////////////////////////////////////
+Arc_range Flow_graph::get_arcs( unsigned block ) const
+{
+   const unsigned count = get_arc_count( block );
+   if ( count == 0 )
+   {
+      return Arc_range();
+   }
+
+   return Arc_range( &m_arcs[ m_arc_begin[block] ], count );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the number of arcs leaving a block
+///
+///  @return 0 if the graph was not built with the block
+///////////////////////////////////////////////////////////////////////////
+unsigned Flow_graph::get_arc_count( unsigned block ) const
+{
+   if ( block + 1 >= m_arc_begin.size() )
+   {
+      return 0;
+   }
+
+   return m_arc_begin[block + 1] - m_arc_begin[block];
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the number of arcs entering a block
+///
+///  @return 0 if the graph was not built with the block
+///////////////////////////////////////////////////////////////////////////
+unsigned Flow_graph::get_from_arc_count( unsigned block ) const
+{
+   if ( block + 1 >= m_from_begin.size() )
+   {
+      return 0;
+   }
+
+   return m_from_begin[block + 1] - m_from_begin[block];
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Adds a line, which is not seen by the blocks before the next build
+///////////////////////////////////////////////////////////////////////////
+void Line_table::add_line( unsigned block, String_id source,
+   unsigned line_num )
+{
+   Added_line added;
+   added.m_block = block;
+   added.m_source = source;
+   added.m_line.m_line_num = line_num;
+   added.m_line.m_inlined = false;
+
+   m_added.push_back( added );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Orders the added lines by block, then by source file name, then by
+///  line number
+///////////////////////////////////////////////////////////////////////////
+bool Line_table::Added_line_less::operator()( const Added_line & lhs,
+   const Added_line & rhs ) const
+{
+   if ( lhs.m_block != rhs.m_block )
+   {
+      return lhs.m_block < rhs.m_block;
+   }
+   if ( lhs.m_source != rhs.m_source )
+   {
+      return String_table::Less()( lhs.m_source, rhs.m_source );
+   }
+
+   return lhs.m_line.m_line_num < rhs.m_line.m_line_num;
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Groups the lines added so far, and the lines of the table, into runs
+///  by block and source file. The lines of a run are sorted by line
+///  number, and a line number is only kept once per run. Lines of
+///  blocks past block_count are dropped.
+///////////////////////////////////////////////////////////////////////////
+void Line_table::build( unsigned block_count )
+{
+   // Lines already in the table come first, so a rebuild keeps them
+   vector<Added_line> added;
+   added.reserve( m_lines.size() + m_added.size() );
+   for ( unsigned b = 0; b < m_block_runs.size(); ++b )
+   {
+      for ( unsigned k = 0; k < m_block_runs[b].m_size; ++k )
+      {
+         const Line_run & run = m_runs[ m_block_runs[b].m_first + k ];
+         for ( unsigned i = 0; i < run.m_size; ++i )
+         {
+            Added_line line;
+            line.m_block = b;
+            line.m_source = run.m_source;
+            line.m_line = m_lines[ run.m_first + i ];
+            added.push_back( line );
+         }
+      }
+   }
+   added.insert( added.end(), m_added.begin(), m_added.end() );
+   vector<Added_line>().swap( m_added );
+
+   std::stable_sort( added.begin(), added.end(), Added_line_less() );
+
+   m_lines.clear();
+   m_lines.reserve( added.size() );
+   m_runs.clear();
+   Run_span empty = { 0, 0 };
+   m_block_runs.assign( block_count, empty );
+
+   for ( unsigned i = 0; i < added.size(); ++i )
+   {
+      const Added_line & line = added[i];
+      if ( line.m_block >= block_count )
+      {
+         break;
+      }
+
+      Run_span & span = m_block_runs[ line.m_block ];
+      if ( span.m_size == 0 || m_runs.back().m_source != line.m_source )
+      {
+         if ( span.m_size == 0 )
+         {
+            span.m_first = m_runs.size();
+         }
+
+         Line_run run = { line.m_source, unsigned( m_lines.size() ), 0 };
+         m_runs.push_back( run );
+         ++span.m_size;
+      }
+
+      // Keep a line number once per run, as the first one sorted
+      Line_run & run = m_runs.back();
+      if ( run.m_size == 0 
+           || m_lines.back().m_line_num != line.m_line.m_line_num )
+      {
+         m_lines.push_back( line.m_line );
+         ++run.m_size;
+      }
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Appends a line to the run of a block from a source file. The runs of
+///  the block, or the lines of the run, are moved to the end of the table
+///  first unless they already are there, so they can grow in place.
+///////////////////////////////////////////////////////////////////////////
+void Line_table::push_line( unsigned block, String_id source,
+   const Line & line )
+{
+   unsigned k = find_source( block, source );
+   Run_span & span = m_block_runs[block];
+
+   if ( k == span.m_size )
+   {
+      if ( span.m_first + span.m_size != m_runs.size() )
+      {
+         const unsigned first = m_runs.size();
+         for ( unsigned i = 0; i < span.m_size; ++i )
+         {
+            const Line_run moved = m_runs[ span.m_first + i ];
+            m_runs.push_back( moved );
+         }
+         span.m_first = first;
+      }
+
+      // Keep the runs of the block in source file name order
+      String_table::Less less;
+      k = 0;
+      while ( k < span.m_size && less( m_runs[ span.m_first + k ].m_source, 
+                                       source ) )
+      {
+         ++k;
+      }
+
+      Line_run run = { source, unsigned( m_lines.size() ), 0 };
+      m_runs.insert( m_runs.begin() + span.m_first + k, run );
+      ++span.m_size;
+   }
+
+   Line_run & run = m_runs[ span.m_first + k ];
+   if ( run.m_first + run.m_size != m_lines.size() )
+   {
+      const unsigned first = m_lines.size();
+      for ( unsigned i = 0; i < run.m_size; ++i )
+      {
+         const Line moved = m_lines[ run.m_first + i ];
+         m_lines.push_back( moved );
+      }
+      run.m_first = first;
+   }
+
+   m_lines.push_back( line );
+   ++run.m_size;
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Exchanges the table with another line table
+///////////////////////////////////////////////////////////////////////////
+void Line_table::swap( Line_table & other )
+{
+   m_added.swap( other.m_added );
+   m_lines.swap( other.m_lines );
+   m_runs.swap( other.m_runs );
+   m_block_runs.swap( other.m_block_runs );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the number of source files a block has lines from
+///
+///  @return 0 if the table was not built with the block
+///////////////////////////////////////////////////////////////////////////
+unsigned Line_table::get_source_count( unsigned block ) const
+{
+   if ( block >= m_block_runs.size() )
+   {
+      return 0;
+   }
+
+   return m_block_runs[block].m_size;
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the lines of a block from its k-th source file
+///////////////////////////////////////////////////////////////////////////
+Line_range Line_table::get_lines( unsigned block, unsigned k ) const
+{
+   const Line_run & run = m_runs[ m_block_runs[block].m_first + k ];
+   if ( run.m_size == 0 )
+   {
+      return Line_range();
+   }
+
+   return Line_range( &m_lines[ run.m_first ], run.m_size );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the index of a block's source file
+///
+///  @return get_source_count( block ) if the block has no lines from it
+///////////////////////////////////////////////////////////////////////////
+unsigned Line_table::find_source( unsigned block, String_id source ) const
+{
+   const unsigned count = get_source_count( block );
+   for ( unsigned k = 0; k < count; ++k )
+   {
+      if ( get_source( block, k ) == source )
+      {
+         return k;
+      }
+   }
+
+   return count;
+}
+
 /////////////////////////////////////////////////////////////////////////
 ///  @brief
 ///  Returns whether or not a function block is an end block
@@ -122,7 +469,7 @@ const unsigned Arc::get_flag() const
 ///////////////////////////////////////////////////////////////////////////
 const bool Block::is_end_block() const
 {
-   return ( m_arcs.empty() );
+   return ( get_arcs().empty() );
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -133,7 +480,7 @@ const bool Block::is_end_block() const
 ///////////////////////////////////////////////////////////////////////////
 const bool Block::is_start_block() const
 {
-   return ( m_from_arcs.empty() );
+   return ( get_from_arc_count() == 0 );
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -144,13 +491,14 @@ const bool Block::is_start_block() const
 ///////////////////////////////////////////////////////////////////////////
 const bool Block::is_branch() const
 {
+   const Arc_range arcs = get_arcs();
    unsigned count = 0;
 
    // For each outgoing arc in the block
-   for ( unsigned i = 0; i < m_arcs.size(); ++i )
+   for ( unsigned i = 0; i < arcs.size(); ++i )
    {
       // Increment the count if the arc is not fake
-      if ( ! m_arcs[i].is_fake() )
+      if ( ! arcs[i].is_fake() )
       {
          ++count;
       }
@@ -203,6 +551,7 @@ const bool Block::is_normalized() const
 ///////////////////////////////////////////////////////////////////////////
 const bool Block::has_full_coverage() const
 {
+   const Arc_range arcs = get_arcs();
    // If block has outgoing arcs
    if ( ! is_end_block() )
    {
@@ -210,9 +559,9 @@ const bool Block::has_full_coverage() const
       if ( is_fake() )
       {
          // Return false if any outgoing arc has not been taken
-         for ( unsigned i = 0; i < m_arcs.size(); ++i )
+         for ( unsigned i = 0; i < arcs.size(); ++i )
          {
-            if ( ! m_arcs[i].is_taken() )
+            if ( ! arcs[i].is_taken() )
             {
                return false;
             }
@@ -226,9 +575,9 @@ const bool Block::has_full_coverage() const
 
          // Check if block has any normal outgoing arcs
          bool m_normal = false;
-         for ( unsigned i = 0; i < m_arcs.size(); ++i )
+         for ( unsigned i = 0; i < arcs.size(); ++i )
          {
-            if ( ! m_arcs[i].is_fake() )
+            if ( ! arcs[i].is_fake() )
             {
                m_normal = true;
                break;
@@ -241,9 +590,9 @@ const bool Block::has_full_coverage() const
             // Case 1: normal block only has fake outgoing arcs
             // (i.e. a throw)
             // Return false if any outgoing arc has not been taken
-            for ( unsigned i = 0; i < m_arcs.size(); ++i )
+            for ( unsigned i = 0; i < arcs.size(); ++i )
             {
-               if ( ! m_arcs[i].is_taken() )
+               if ( ! arcs[i].is_taken() )
                {
                   return false;
                }
@@ -255,9 +604,9 @@ const bool Block::has_full_coverage() const
          {
             // Case 2: Normal block has at least one normal outgoing arc
             // Return false if any incoming non-fake arc has not been taken
-            for ( unsigned i = 0; i < m_arcs.size(); ++i )
+            for ( unsigned i = 0; i < arcs.size(); ++i )
             {
-               if ( ! m_arcs[i].is_taken() && ! m_arcs[i].is_fake() )
+               if ( ! arcs[i].is_taken() && ! arcs[i].is_fake() )
                {
                   return false;
                }
@@ -279,6 +628,7 @@ const bool Block::has_full_coverage() const
 ///////////////////////////////////////////////////////////////////////////
 const bool Block::has_partial_coverage() const
 {
+   const Arc_range arcs = get_arcs();
    if ( ! is_end_block() )
    {
       // If block is fake
@@ -286,9 +636,9 @@ const bool Block::has_partial_coverage() const
       {
          // Return true if any arc has been taken
          {
-            for ( unsigned i = 0; i < m_arcs.size(); ++i )
+            for ( unsigned i = 0; i < arcs.size(); ++i )
             {
-               if ( m_arcs[i].is_taken() )
+               if ( arcs[i].is_taken() )
                {
                   return true;
                }
@@ -301,9 +651,9 @@ const bool Block::has_partial_coverage() const
       else
       {
          // Return true if any non-fake arc has been taken
-         for ( unsigned i = 0; i < m_arcs.size(); ++i )
+         for ( unsigned i = 0; i < arcs.size(); ++i )
          {
-            if ( m_arcs[i].is_taken() && ! m_arcs[i].is_fake() )
+            if ( arcs[i].is_taken() && ! arcs[i].is_fake() )
             {
                return true;
             }
@@ -333,22 +683,82 @@ const unsigned Block::get_block_no() const
 ///
 ///  @pre A function block has outgoing arcs
 ///////////////////////////////////////////////////////////////////////////
-const vector<Arc> & Block::get_arcs() const
+Arc_range Block::get_arcs() const
 {
-   return m_arcs;
+   if ( m_graph == NULL )
+   {
+      return Arc_range();
+   }
+
+   return m_graph->get_arcs( m_block_no );
 }
 
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the number of arcs entering a function block
+///
+///  @return 0 if the block is not bound to a built flow graph
+///////////////////////////////////////////////////////////////////////////
+unsigned Block::get_from_arc_count() const
+{
+   if ( m_graph == NULL )
+   {
+      return 0;
+   }
+
+   return m_graph->get_from_arc_count( m_block_no );
+}
 
 /////////////////////////////////////////////////////////////////////////
 ///  @brief
-///  Returns a map of the line data from each source file that makes up
-///  the block
+///  Returns an arc entering a function block
 ///
-///  @return const unsigned
+///  @param k The index of the arc among the arcs entering the block
+///
+///  @pre k < get_from_arc_count()
 ///////////////////////////////////////////////////////////////////////////
-const std::map<std::string,Lines_data> & Block::get_lines() const
+const Arc & Block::get_from_arc( unsigned k ) const
 {
-   return m_lines;
+   return m_graph->get_from_arc( m_block_no, k );
+}
+
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the number of source files the block has lines from
+///
+///  @return 0 if the block is not bound to a line table
+///////////////////////////////////////////////////////////////////////////
+unsigned Block::get_source_count() const
+{
+   if ( m_line_table == NULL )
+   {
+      return 0;
+   }
+
+   return m_line_table->get_source_count( m_block_no );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the id of the k-th source file the block has lines from
+///
+///  @pre k < get_source_count()
+///////////////////////////////////////////////////////////////////////////
+String_id Block::get_source( unsigned k ) const
+{
+   return m_line_table->get_source( m_block_no, k );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the line numbers of the block from its k-th source file
+///
+///  @pre k < get_source_count()
+///////////////////////////////////////////////////////////////////////////
+Line_range Block::get_lines( unsigned k ) const
+{
+   return m_line_table->get_lines( m_block_no, k );
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -359,15 +769,16 @@ const std::map<std::string,Lines_data> & Block::get_lines() const
 ///////////////////////////////////////////////////////////////////////////
 const unsigned Block::get_branch_arc_taken() const
 {
+   const Arc_range arcs = get_arcs();
    unsigned total = 0;
 
    if ( is_branch() )
    {
       // For every arc in the branch
-      for ( unsigned i = 0; i < m_arcs.size(); ++i )
+      for ( unsigned i = 0; i < arcs.size(); ++i )
       {
          // If the branch isn't fake and has a count, increment total
-         if ( ! m_arcs[i].is_fake() && m_arcs[i].get_count() > 0 )
+         if ( ! arcs[i].is_fake() && arcs[i].get_count() > 0 )
          {
             ++total;
          }
@@ -385,15 +796,16 @@ const unsigned Block::get_branch_arc_taken() const
 ///////////////////////////////////////////////////////////////////////////
 const unsigned Block::get_branch_arc_total() const
 {
+   const Arc_range arcs = get_arcs();
    unsigned total = 0;
 
    if ( is_branch() )
    {
       // For every arc in the branch
-      for ( unsigned i = 0; i < m_arcs.size(); ++i )
+      for ( unsigned i = 0; i < arcs.size(); ++i )
       {
          // If the branch isn't fake, increment total
-         if ( ! m_arcs[i].is_fake() )
+         if ( ! arcs[i].is_fake() )
          {
             ++total;
          }
@@ -417,10 +829,10 @@ const int64_t Block::get_count() const
    if ( ! is_start_block() && ! is_end_block() )
    {
       // For every incoming arc
-      for ( unsigned i = 0; i < m_from_arcs.size(); ++i )
+      for ( unsigned i = 0; i < get_from_arc_count(); ++i )
       {
          // Increment total count by incoming arc count
-         count += m_from_arcs[i]->get_count();
+         count += get_from_arc( i ).get_count();
       }
    }
 
@@ -431,13 +843,146 @@ const int64_t Block::get_count() const
 ///  @brief
 ///  Returns the block's associated source file's non-inlined line numbers
 ///
-///  @return const vector<Line> &
+///  @return const Line_list &
 ///////////////////////////////////////////////////////////////////////////
-const vector<Line> & Block::get_non_inlined() const
+const Line_list & Block::get_non_inlined() const
 {
    return m_non_inlined;
 }
 
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Copies a record. The copied blocks view the copied flow graph.
+///////////////////////////////////////////////////////////////////////////
+Record::Record( const Record & other )
+   : m_ident( other.m_ident ),
+     m_checksum( other.m_checksum ),
+     m_name( other.m_name ),
+     m_name_demangled( other.m_name_demangled ),
+     m_source( other.m_source ),
+     m_line_num( other.m_line_num ),
+     m_blocks( other.m_blocks ),
+     m_graph( other.m_graph ),
+     m_line_table( other.m_line_table ),
+     m_counts( other.m_counts ),
+     m_block_order( other.m_block_order )
+#ifdef DEBUGFLAG
+     , m_graph_path( other.m_graph_path ),
+     m_report_path( other.m_report_path )
+#endif
+{
+   bind_blocks();
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Assigns a record. The assigned blocks view the assigned flow graph.
+///////////////////////////////////////////////////////////////////////////
+Record & Record::operator=( const Record & other )
+{
+   if ( this != &other )
+   {
+      m_ident = other.m_ident;
+      m_checksum = other.m_checksum;
+      m_name = other.m_name;
+      m_name_demangled = other.m_name_demangled;
+      m_source = other.m_source;
+      m_line_num = other.m_line_num;
+      m_blocks = other.m_blocks;
+      m_graph = other.m_graph;
+      m_line_table = other.m_line_table;
+      m_counts = other.m_counts;
+      m_block_order = other.m_block_order;
+#ifdef DEBUGFLAG
+      m_graph_path = other.m_graph_path;
+      m_report_path = other.m_report_path;
+#endif
+      bind_blocks();
+   }
+
+   return *this;
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Builds the flow graph from the arcs added so far and the line table
+///  from the lines added so far, and binds the blocks to them
+///////////////////////////////////////////////////////////////////////////
+void Record::build()
+{
+   m_graph.build( m_blocks.size() );
+   m_line_table.build( m_blocks.size() );
+   bind_blocks();
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Exchanges the whole record with another record
+///////////////////////////////////////////////////////////////////////////
+void Record::swap( Record & other )
+{
+   std::swap( m_ident, other.m_ident );
+   std::swap( m_checksum, other.m_checksum );
+   m_name.swap( other.m_name );
+   m_name_demangled.swap( other.m_name_demangled );
+   std::swap( m_source, other.m_source );
+   std::swap( m_line_num, other.m_line_num );
+   m_counts.swap( other.m_counts );
+   m_block_order.swap( other.m_block_order );
+#ifdef DEBUGFLAG
+   m_graph_path.swap( other.m_graph_path );
+   m_report_path.swap( other.m_report_path );
+#endif
+   swap_graph( other );
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Exchanges the blocks, the flow graph and the line table with another
+///  record
+///////////////////////////////////////////////////////////////////////////
+void Record::swap_graph( Record & other )
+{
+   m_blocks.swap( other.m_blocks );
+   m_graph.swap( other.m_graph );
+   m_line_table.swap( other.m_line_table );
+   bind_blocks();
+   other.bind_blocks();
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Points the blocks at the record's graph and line table
+///////////////////////////////////////////////////////////////////////////
+void Record::bind_blocks()
+{
+   for ( unsigned i = 0; i < m_blocks.size(); ++i )
+   {
+      m_blocks[i].m_graph = &m_graph;
+      m_blocks[i].m_line_table = &m_line_table;
+   }
+}
+
+/////////////////////////////////////////////////////////////////////////
+///  @brief
+///  Returns the demangled signature of the function
+///
+///  @return const string &
+///
+///  @remarks
+///  Names are demangled only once they are printed or sorted, and each
+///  name is demangled once for all the records sharing it.
+///////////////////////////////////////////////////////////////////////////
+const string & Record::get_name_demangled() const
+{
+   if ( m_name_demangled.empty() && ! m_name.empty() )
+   {
+      m_name_demangled = Demangler::get_instance().demangle( m_name );
+   }
+
+   return m_name_demangled;
+}
+
 /////////////////////////////////////////////////////////////////////////
 ///  @brief
 ///  Returns an HTML friendly format of a function's demangled name
@@ -449,9 +994,10 @@ const string Record::get_HTML_name() const
    string temp_string = "";
 
    // For each character in the string
-   for ( unsigned i = 0; i < m_name_demangled.size(); ++i )
+   const string & name = get_name_demangled();
+   for ( unsigned i = 0; i < name.size(); ++i )
    {
-      const char c = m_name_demangled[i];
+      const char c = name[i];
 
       switch( c )
       {
@@ -500,7 +1046,7 @@ const unsigned Record::get_function_arc_taken() const
       if ( m_blocks[i].is_branch() && ! m_blocks[i].is_fake() )
       {
          // Get the block's arcs
-         const vector<Arc> & arcs = m_blocks[i].get_arcs();
+         const Arc_range arcs = m_blocks[i].get_arcs();
 
          // For each of the block's arcs
          for ( unsigned j = 0; j < arcs.size(); ++j )
@@ -538,7 +1084,7 @@ const unsigned Record::get_function_arc_total() const
       if ( m_blocks[i].is_branch() && ! m_blocks[i].is_fake() )
       {
          // Get the block's arcs
-         const vector<Arc> & arcs = m_blocks[i].get_arcs();
+         const Arc_range arcs = m_blocks[i].get_arcs();
 
          // For each of the block's arcs
          for ( unsigned j = 0; j < arcs.size(); ++j )
@@ -566,7 +1112,7 @@ const uint64_t Record::get_execution_count() const
    uint64_t total = 0;
 
    // Get the first block's arcs
-   const vector<Arc> & arcs = m_blocks[0].get_arcs();
+   const Arc_range arcs = m_blocks[0].get_arcs();
 
    for ( unsigned i = 0; i < arcs.size(); ++i )
    {
@@ -629,5 +1175,5 @@ bool record_line_lessthan(const Record * const lhs, const Record * const rhs)
 ///////////////////////////////////////////////////////////////////////////
 bool record_name_lessthan(const Record * const lhs, const Record * const rhs)
 {
-   return lhs->m_name_demangled < rhs->m_name_demangled;
+   return lhs->get_name_demangled() < rhs->get_name_demangled();
 }
@@ -38,6 +38,10 @@
 
 #include "selector.h"
 
+//  LOCAL INCLUDES
+
+#include "demangler.h"
+
 //  USING STATEMENTS
 
 using std::cerr;
@@ -68,6 +72,7 @@ Selector::Selector()
     is_all_selected = true;
     is_full_match = true;
     is_signature_match = false;
+    is_mangled_match = false;
 
 } // End of Selector Constructor
 
@@ -108,6 +113,7 @@ void Selector::select( const vector<string> & selection_list )
     is_full_match = config.get_flag_value(Config::Full_match);
     is_and_match = config.get_flag_value(Config::And);
     is_signature_match = config.get_flag_value(Config::Signature_match);
+    is_mangled_match = config.get_flag_value(Config::Mangle);
 
     // Populate regex selection list
     for (unsigned int i = 0; i < selection_list.size(); i++)
@@ -134,7 +140,8 @@ void Selector::select( const vector<string> & selection_list )
 
         cerr << "}\nSelect: full_match = " << is_full_match
              << "\nSelect: and_match = " << is_and_match
-             << "\nSelect: signature_match = " << is_signature_match << "\n";        
+             << "\nSelect: signature_match = " << is_signature_match
+             << "\nSelect: mangled_match = " << is_mangled_match << "\n";        
     }
 #endif
 
@@ -145,12 +152,12 @@ void Selector::select( const vector<string> & selection_list )
 /// Returns if a function was selected or not
 ///
 /// @param source_name The source file name
-/// @param function_signature The name of the function
+/// @param mangled_name The mangled name of the function
 ///
 /// @return bool
 //////////////////////////////////////////////////////////////////////////////
 bool Selector::is_selected( const std::string & source_name,
-    const std::string & function_signature )
+    const std::string & mangled_name )
 {
     // Instantiate utility class pointer
     Tru_utility * ptr_utility = Tru_utility::get_instance();
@@ -162,6 +169,15 @@ bool Selector::is_selected( const std::string & source_name,
         return true;
     }
 
+    // The mangled names are output, so they are what is selected.
+    if ( is_mangled_match )
+    {
+        return check_in_selection( mangled_name );
+    }
+
+    const string & function_signature = 
+        Demangler::get_instance().demangle( mangled_name );
+
     // If match by function signature, then parse the function name out
     // first and then attempt to match.
     if ( !is_signature_match )
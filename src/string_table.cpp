@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file string_table.cpp
+///
+///  @brief
+///  Implements the String_table class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <stdexcept>
+
+// LOCAL INCLUDES
+
+#include "string_table.h"
+
+// CONSTANT DEFINITIONS
+
+const String_id String_table::Empty;
+const std::size_t String_table::Chunk_size;
+const std::size_t String_table::Max_chunks;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Orders two ids as their strings.
+///////////////////////////////////////////////////////////////////////////////
+bool String_table::Less::operator()( String_id left, String_id right ) const
+{
+   if ( left == right )
+   {
+      return false;
+   }
+
+   const String_table & table = String_table::get_instance();
+   return table.get_string( left ) < table.get_string( right );
+} // End of String_table::Less::operator()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes the table with the empty string.
+///////////////////////////////////////////////////////////////////////////////
+String_table::String_table() : m_size( 0 )
+{
+   for ( std::size_t i = 0; i < Max_chunks; ++i )
+   {
+      m_chunks[i] = NULL;
+   }
+   intern( std::string() );
+} // End of String_table::String_table()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the table of the process.
+///////////////////////////////////////////////////////////////////////////////
+String_table & String_table::get_instance()
+{
+   static String_table * table = new String_table();
+   return *table;
+} // End of String_table::get_instance()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the id of a string, interning it on first use.
+///////////////////////////////////////////////////////////////////////////////
+String_id String_table::intern( const std::string & value )
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+
+   Index::const_iterator found = m_index.find( value );
+   if ( found != m_index.end() )
+   {
+      return found->second;
+   }
+
+   const std::size_t chunk = m_size / Chunk_size;
+   if ( chunk == Max_chunks )
+   {
+      throw std::length_error( "String_table::intern" );
+   }
+   if ( m_chunks[chunk] == NULL )
+   {
+      m_chunks[chunk] = new const std::string *[Chunk_size];
+   }
+
+   const String_id id = static_cast<String_id>( m_size );
+   found = m_index.insert( std::make_pair( value, id ) ).first;
+   m_chunks[chunk][m_size % Chunk_size] = &found->first;
+   ++m_size;
+   return id;
+} // End of String_table::intern(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the number of strings interned.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t String_table::size() const
+{
+   boost::mutex::scoped_lock lock( m_mutex );
+   return m_size;
+} // End of String_table::size()
@@ -0,0 +1,413 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file tar_archive.cpp
+///
+///  @brief
+///  Implements the Tar_archive class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <fstream>
+#include <cstring>
+#include <exception>
+
+#include <boost/cstdint.hpp>
+#include <boost/version.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+
+// zstd support appeared in Boost 1.70
+#if BOOST_VERSION >= 107000
+   #include <boost/iostreams/filter/zstd.hpp>
+   #define TAR_ARCHIVE_ZSTD
+#endif
+
+// LOCAL INCLUDES
+
+#include "tar_archive.h"
+#include "bounded_read.h"
+
+// USING STATEMENTS
+
+using std::string;
+using std::vector;
+using std::map;
+using std::pair;
+using std::size_t;
+
+namespace io = boost::iostreams;
+
+// CONSTANTS
+
+/// The size of a tar header and the unit the members are padded to.
+static const size_t Block_size = 512;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns if a string ends with the given suffix.
+///////////////////////////////////////////////////////////////////////////////
+static bool ends_with( const string & value, const string & suffix )
+{
+   return value.size() >= suffix.size() &&
+      value.compare( value.size() - suffix.size(), suffix.size(), suffix ) == 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns a null padded header field as a string.
+///////////////////////////////////////////////////////////////////////////////
+static string read_field( const char * field, size_t length )
+{
+   return string( field, strnlen( field, length ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns a numeric header field, stored as octal digits or, for values
+/// too large for them, as a base 256 number flagged by its high bit.
+///////////////////////////////////////////////////////////////////////////////
+static boost::uintmax_t read_number( const char * field, size_t length )
+{
+   boost::uintmax_t value = 0;
+
+   if ( static_cast<unsigned char>( field[0] ) & 0x80 )
+   {
+      value = field[0] & 0x7F;
+      for ( size_t i = 1; i < length; ++i )
+      {
+         value = ( value << 8 ) | static_cast<unsigned char>( field[i] );
+      }
+      return value;
+   }
+
+   size_t i = 0;
+   while ( i < length && field[i] == ' ' )
+   {
+      ++i;
+   }
+   for ( ; i < length && field[i] >= '0' && field[i] <= '7'; ++i )
+   {
+      value = value * 8 + ( field[i] - '0' );
+   }
+   return value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns if the checksum of a header matches its bytes, the checksum
+/// field counting as spaces.
+///////////////////////////////////////////////////////////////////////////////
+static bool is_valid_header( const char * header )
+{
+   boost::uintmax_t sum = 0;
+   for ( size_t i = 0; i < Block_size; ++i )
+   {
+      sum += ( i >= 148 && i < 156 ) ? ' ' 
+         : static_cast<unsigned char>( header[i] );
+   }
+   return sum == read_number( header + 148, 8 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the data of a member into a buffer, then skips its padding.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+static bool read_data( std::istream & in, boost::uintmax_t size, 
+   vector<char> & data )
+{
+   if ( ! read_bounded( in, size, data ) )
+   {
+      return false;
+   }
+
+   const std::streamsize padding = ( Block_size - size % Block_size ) 
+      % Block_size;
+   in.ignore( padding );
+   return in.gcount() == padding;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Skips the data of a member and its padding.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+static bool skip_data( std::istream & in, boost::uintmax_t size )
+{
+   const boost::uintmax_t padded = 
+      ( size + Block_size - 1 ) / Block_size * Block_size;
+
+   in.ignore( static_cast<std::streamsize>( padded ) );
+   return static_cast<boost::uintmax_t>( in.gcount() ) == padded;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the path of a pax extended header, or an empty string if it has
+/// none.
+///
+/// @return success(true), malformed record(false)
+///////////////////////////////////////////////////////////////////////////////
+static bool read_pax_path( const vector<char> & data, string & path )
+{
+   // Each record is "<length> <key>=<value>\n", its length counting all
+   size_t pos = 0;
+   while ( pos < data.size() )
+   {
+      size_t length = 0;
+      size_t i = pos;
+      for ( ; i < data.size() && data[i] >= '0' && data[i] <= '9'; ++i )
+      {
+         length = length * 10 + ( data[i] - '0' );
+      }
+      // The length must cover the space and the newline of the record
+      if ( length == 0 || pos + length > data.size() || i >= data.size()
+           || data[i] != ' ' || i + 1 >= pos + length 
+           || data[pos + length - 1] != '\n' )
+      {
+         return false;
+      }
+
+      const string record( &data[i + 1], &data[pos + length - 1] );
+      if ( record.compare( 0, 5, "path=" ) == 0 )
+      {
+         path = record.substr( 5 );
+         return true;
+      }
+      pos += length;
+   }
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns a member name without its leading "./".
+///////////////////////////////////////////////////////////////////////////////
+static string clean_name( string name )
+{
+   while ( name.compare( 0, 2, "./" ) == 0 )
+   {
+      name.erase( 0, 2 );
+   }
+   return name;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns if a path names a tar archive, by its extension.
+///////////////////////////////////////////////////////////////////////////////
+bool Tar_archive::is_archive( const string & path )
+{
+   return ends_with( path, ".tar" ) || ends_with( path, ".tar.gz" ) ||
+      ends_with( path, ".tgz" ) || ends_with( path, ".tar.zst" );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+Tar_archive::Tar_archive()
+   : m_open( false )
+{
+   // void
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the gcno and gcda members of an archive file through the
+/// decompressor its extension asks for.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Tar_archive::open( const string & path )
+{
+   m_path = path;
+
+   std::ifstream file( path.c_str(), std::ios::in | std::ios::binary );
+   if ( ! file )
+   {
+      return false;
+   }
+
+   io::filtering_istream in;
+   if ( ends_with( path, ".gz" ) || ends_with( path, ".tgz" ) )
+   {
+      in.push( io::gzip_decompressor() );
+   }
+   else if ( ends_with( path, ".zst" ) )
+   {
+#ifdef TAR_ARCHIVE_ZSTD
+      in.push( io::zstd_decompressor() );
+#else
+      return false;
+#endif
+   }
+   in.push( file );
+
+   // The decompressors throw on corrupt data
+   try
+   {
+      return read( in );
+   }
+   catch ( const std::exception & )
+   {
+      return false;
+   }
+} // End of Tar_archive::open(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the members of a tar stream up to its end of archive blocks. The
+/// gcno and gcda members are kept and the others skipped. GNU long names
+/// and pax paths are applied to the member that follows them.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Tar_archive::read( std::istream & in )
+{
+   char header[Block_size];
+   vector<char> data;
+   string long_name;
+
+   for ( ;; )
+   {
+      in.read( header, Block_size );
+
+      // Some writers end the archive without the end of archive blocks
+      if ( in.gcount() == 0 && in.eof() )
+      {
+         break;
+      }
+      if ( static_cast<size_t>( in.gcount() ) != Block_size )
+      {
+         return false;
+      }
+
+      // A zero block marks the end of the archive
+      if ( header[0] == '\0' && 
+           std::memcmp( header, header + 1, Block_size - 1 ) == 0 )
+      {
+         break;
+      }
+
+      if ( ! is_valid_header( header ) )
+      {
+         return false;
+      }
+
+      const boost::uintmax_t size = read_number( header + 124, 12 );
+      const char type = header[156];
+
+      string name = long_name;
+      long_name.clear();
+      if ( name.empty() )
+      {
+         name = read_field( header, 100 );
+
+         const string prefix = read_field( header + 345, 155 );
+         if ( std::memcmp( header + 257, "ustar", 5 ) == 0 && 
+              ! prefix.empty() )
+         {
+            name = prefix + "/" + name;
+         }
+      }
+      name = clean_name( name );
+
+      bool consumed = true;
+      switch ( type )
+      {
+         case 'L':
+            consumed = read_data( in, size, data );
+            long_name = data.empty() ? "" 
+               : read_field( &data[0], data.size() );
+            break;
+         case 'x':
+            consumed = read_data( in, size, data ) 
+               && read_pax_path( data, long_name );
+            break;
+         case '0':
+         case '\0':
+         case '7':
+            if ( ends_with( name, ".gcno" ) || ends_with( name, ".gcda" ) )
+            {
+               if ( ends_with( name, ".gcno" ) && ! m_members.count( name ) )
+               {
+                  m_gcno_names.push_back( name );
+               }
+               consumed = read_data( in, size, m_members[name] );
+            }
+            else
+            {
+               consumed = skip_data( in, size );
+            }
+            break;
+         default:
+            consumed = skip_data( in, size );
+            break;
+      }
+
+      if ( ! consumed )
+      {
+         return false;
+      }
+   }
+
+   pair_members();
+   m_open = true;
+   return true;
+} // End of Tar_archive::read(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Returns the contents of a gcno or gcda member, or NULL.
+///////////////////////////////////////////////////////////////////////////////
+const vector<char> * Tar_archive::find_member( const string & name ) const
+{
+   map< string, vector<char> >::const_iterator found = m_members.find( name );
+
+   return found == m_members.end() ? NULL : &found->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Pairs each gcno member with the gcda member of the same name. A gcno
+/// member without a gcda member is left out, as for the build directories.
+///////////////////////////////////////////////////////////////////////////////
+void Tar_archive::pair_members()
+{
+   m_pairs.clear();
+   for ( size_t i = 0; i < m_gcno_names.size(); ++i )
+   {
+      const string & gcno = m_gcno_names[i];
+      const string gcda = gcno.substr( 0, gcno.size() - 4 ) + "gcda";
+
+      if ( m_members.count( gcda ) )
+      {
+         m_pairs.push_back( std::make_pair( gcno, gcda ) );
+      }
+   }
+}
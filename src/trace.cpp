@@ -0,0 +1,460 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file trace.cpp
+///
+///  @brief
+///  Implements the Trace_writer and Trace_reader class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// SYSTEM INCLUDES
+
+#include <cstring>
+
+// LOCAL INCLUDES
+
+#include "trace.h"
+#include "bounded_read.h"
+
+// USING STATEMENTS
+
+using std::string;
+using std::size_t;
+
+// CONSTANTS
+
+const char Trace_writer::Magic[4] = { 'T', 'R', 'C', '1' };
+
+namespace
+{
+   /// The fields of each kind of event, in order: a number (n) or a
+   /// string (s).
+   const char * const Event_fields[Trace_event::Tag_count] =
+   {
+      "",        // Unused
+      "ss",      // Pair
+      "nn",      // Gcno_file
+      "nnnssn",  // Gcno_function
+      "n",       // Gcno_blocks
+      "nnn",     // Gcno_block
+      "nn",      // Gcno_arcs
+      "nn",      // Gcno_arc
+      "nn",      // Gcno_lines
+      "s",       // Gcno_line_name
+      "n",       // Gcno_line_number
+      "nn",      // Gcda_file
+      "nnn",     // Gcda_function
+      "n",       // Gcda_arcs
+      "n",       // Gcda_count
+      "nnnnnnn", // Gcda_object_summary
+      "nnnnnnn"  // Gcda_program_summary
+   };
+
+   /// The longest varint, a 64 bit value in 7 bit groups.
+   const size_t Max_varint_size = 10;
+
+   /// The room reserved for the tag and offset of an event.
+   const size_t Event_header_size = 1 + Max_varint_size;
+}
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes a writer not tracing to any file.
+///////////////////////////////////////////////////////////////////////////////
+Trace_writer::Trace_writer()
+   : m_buffer( Buffer_size ),
+     m_used( 0 ),
+     m_base( NULL )
+{
+   // void
+} // End of Trace_writer constructor
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Writes out the events still buffered.
+///////////////////////////////////////////////////////////////////////////////
+Trace_writer::~Trace_writer()
+{
+   close();
+} // End of Trace_writer destructor
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Starts a trace, replacing the file.
+///
+/// @param path The path of the trace file.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Trace_writer::open( const string & path )
+{
+   close();
+   m_file.open( path.c_str(), std::ios::out | std::ios::binary );
+   if ( ! m_file.is_open() )
+   {
+      return false;
+   }
+
+   std::memcpy( &m_buffer[0], Magic, sizeof( Magic ) );
+   m_used = sizeof( Magic );
+   return true;
+} // End of Trace_writer::open( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Writes out the events still buffered and closes the file.
+///////////////////////////////////////////////////////////////////////////////
+void Trace_writer::close()
+{
+   if ( m_file.is_open() )
+   {
+      flush();
+      m_file.close();
+   }
+   m_used = 0;
+} // End of Trace_writer::close()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Starts an event. Its fields are added next, in the order of its tag.
+///
+/// @param tag The kind of the event.
+/// @param position The position of the event in the file being parsed.
+///////////////////////////////////////////////////////////////////////////////
+Trace_writer & Trace_writer::event( Trace_event::Tag tag, 
+   const char * position )
+{
+   reserve( Event_header_size );
+   m_buffer[m_used++] = static_cast<char>( tag );
+   put_varint( m_base != NULL && position != NULL ? position - m_base : 0 );
+   return *this;
+} // End of Trace_writer::event( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Adds a number field to the event.
+///////////////////////////////////////////////////////////////////////////////
+Trace_writer & Trace_writer::number( uint64_t value )
+{
+   reserve( Max_varint_size );
+   put_varint( value );
+   return *this;
+} // End of Trace_writer::number( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Adds a string field to the event.
+///////////////////////////////////////////////////////////////////////////////
+Trace_writer & Trace_writer::text( const string & value )
+{
+   number( value.size() );
+
+   // A string longer than the buffer is written out past it
+   if ( value.size() > Buffer_size )
+   {
+      flush();
+      m_file.write( value.data(), value.size() );
+      return *this;
+   }
+
+   reserve( value.size() );
+   value.copy( &m_buffer[m_used], value.size() );
+   m_used += value.size();
+   return *this;
+} // End of Trace_writer::text( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Makes room for a number of bytes in the buffer.
+///////////////////////////////////////////////////////////////////////////////
+void Trace_writer::reserve( size_t size )
+{
+   if ( m_used + size > m_buffer.size() )
+   {
+      flush();
+   }
+} // End of Trace_writer::reserve( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Writes out the bytes buffered.
+///////////////////////////////////////////////////////////////////////////////
+void Trace_writer::flush()
+{
+   if ( m_file.is_open() && m_used != 0 )
+   {
+      m_file.write( &m_buffer[0], m_used );
+   }
+   m_used = 0;
+} // End of Trace_writer::flush()
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Packs a varint into the buffer, which has room for it.
+///////////////////////////////////////////////////////////////////////////////
+void Trace_writer::put_varint( uint64_t value )
+{
+   while ( value >= 0x80 )
+   {
+      m_buffer[m_used++] = static_cast<char>( ( value & 0x7F ) | 0x80 );
+      value >>= 7;
+   }
+   m_buffer[m_used++] = static_cast<char>( value );
+} // End of Trace_writer::put_varint( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes the reader of a trace.
+///
+/// @param input The trace, read from its start.
+///////////////////////////////////////////////////////////////////////////////
+Trace_reader::Trace_reader( std::istream & input )
+   : m_input( input ),
+     m_started( false ),
+     m_complete( false )
+{
+   // void
+} // End of Trace_reader constructor
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads the next event.
+///
+/// @param event Receives the event.
+///
+/// @return read(true), end of trace or error(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Trace_reader::read( Trace_event & event )
+{
+   if ( ! m_started )
+   {
+      char magic[sizeof( Trace_writer::Magic )];
+      if ( ! m_input.read( magic, sizeof( magic ) ) ||
+           std::memcmp( magic, Trace_writer::Magic, sizeof( magic ) ) != 0 )
+      {
+         return false;
+      }
+      m_started = true;
+   }
+
+   const int tag = m_input.get();
+   if ( tag == std::char_traits<char>::eof() )
+   {
+      m_complete = true;
+      return false;
+   }
+   if ( tag <= 0 || tag >= Trace_event::Tag_count )
+   {
+      return false;
+   }
+
+   event.m_tag = static_cast<Trace_event::Tag>( tag );
+   event.m_numbers.clear();
+   event.m_strings.clear();
+   if ( ! get_varint( event.m_offset ) )
+   {
+      return false;
+   }
+
+   for ( const char * field = Event_fields[tag]; *field != '\0'; ++field )
+   {
+      uint64_t value;
+      if ( ! get_varint( value ) )
+      {
+         return false;
+      }
+
+      if ( *field == 'n' )
+      {
+         event.m_numbers.push_back( value );
+         continue;
+      }
+
+      string text;
+      if ( ! read_bounded( m_input, value, text ) )
+      {
+         return false;
+      }
+      event.m_strings.push_back( text );
+   }
+
+   return true;
+} // End of Trace_reader::read( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Reads a varint.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Trace_reader::get_varint( uint64_t & value )
+{
+   value = 0;
+   for ( unsigned int shift = 0; shift < 64; shift += 7 )
+   {
+      const int byte = m_input.get();
+      if ( byte == std::char_traits<char>::eof() )
+      {
+         return false;
+      }
+
+      value |= static_cast<uint64_t>( byte & 0x7F ) << shift;
+      if ( ( byte & 0x80 ) == 0 )
+      {
+         return true;
+      }
+   }
+
+   return false;
+} // End of Trace_reader::get_varint( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Formats an event as the text of the debug dump.
+///
+/// @param event The event.
+/// @param out The stream the text is written to.
+///////////////////////////////////////////////////////////////////////////////
+void Trace_reader::write_text( const Trace_event & event, std::ostream & out )
+{
+   const std::vector<uint64_t> & n = event.m_numbers;
+   const std::vector<string> & s = event.m_strings;
+
+   switch ( event.m_tag )
+   {
+      case Trace_event::Pair:
+         out << "**************************************************\n"
+             << "GCNO FILE: " << s[0] << "\n"
+             << "GCDA FILE: " << s[1] << "\n";
+         break;
+
+      case Trace_event::Gcno_file:
+         out << "Version: " << n[0] << "\n"
+             << "Stamp:   " << n[1] << "\n";
+         break;
+
+      case Trace_event::Gcno_function:
+         out << "AnnounceFunction: "
+             << "rLength= " << n[0]
+             << " rIdent= " << n[1]
+             << " rChecksum= " << n[2] << "\n"
+             << "                  rName= " << s[0] << "\n"
+             << "                  rSource= " << s[1] << "\n"
+             << "                  rLineno= " << n[3] << "\n";
+         break;
+
+      case Trace_event::Gcno_blocks:
+         out << "BasicBlocks:  bLength= " << n[0] << "\n";
+         break;
+
+      case Trace_event::Gcno_block:
+         out << "blocks=" << n[0] << "   bIteratin" << n[1] 
+             << "   bFlags= " << n[2] << "\n";
+         break;
+
+      case Trace_event::Gcno_arcs:
+         out << "Arcs: aLength= " << n[0] << " aBlockno= " << n[1] << "\n";
+         break;
+
+      case Trace_event::Gcno_arc:
+         out << "      destblock= " << n[0] << " aFlags= " << n[1] << "\n";
+         break;
+
+      case Trace_event::Gcno_lines:
+         out << "  Lines:"
+             << " lLength= " << n[0]
+             << " lBlockno= " << n[1] << "\n";
+         break;
+
+      case Trace_event::Gcno_line_name:
+         out << "         lname= " << s[0] << "\n";
+         break;
+
+      case Trace_event::Gcno_line_number:
+         out << "         lLineno= " << n[0] << "\n";
+         break;
+
+      case Trace_event::Gcda_file:
+         out << "Version: " << n[0] << " Stamp: " << n[1] << "\n";
+         break;
+
+      case Trace_event::Gcda_function:
+         out << "rLength: " << n[0]
+             << " rIdent: " << n[1]
+             << " rChecksum: " << n[2] << "\n";
+         break;
+
+      case Trace_event::Gcda_arcs:
+         out << "   aLength: " << n[0] << "\n";
+         break;
+
+      case Trace_event::Gcda_count:
+         out << "     aCount: " << n[0] << "\n";
+         break;
+
+      case Trace_event::Gcda_object_summary:
+         out << " oLength: " << n[0] << "\n"
+             << "   oChecksum: " << n[1] << "\n"
+             << "   oCounts: " << n[2] << "\n"
+             << "   oRuns: " << n[3] << "\n"
+             << "   oSumall: " << n[4] << "\n"
+             << "   oRunmax: " << n[5] << "\n"
+             << "   oSummax: " << n[6] << "\n";
+         break;
+
+      case Trace_event::Gcda_program_summary:
+         out << " pLength: " << n[0] << "\n"
+             << "   pChecksum: " << n[1] << "\n"
+             << "   pCounts: " << n[2] << "\n"
+             << "   pRuns: " << n[3] << "\n"
+             << "   pSumall: " << n[4] << "\n"
+             << "   pRunmax: " << n[5] << "\n"
+             << "   pSummax: " << n[6] << "\n";
+         break;
+
+      default:
+         break;
+   }
+} // End of Trace_reader::write_text( ... )
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Formats a whole trace as the text of the debug dump.
+///
+/// @param out The stream the text is written to.
+///
+/// @return success(true), failure(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Trace_reader::write_text( std::ostream & out )
+{
+   Trace_event event;
+   while ( read( event ) )
+   {
+      write_text( event, out );
+   }
+
+   return is_complete();
+} // End of Trace_reader::write_text( ... )
@@ -29,6 +29,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "tru_utility.h"
+#include "project_context.h"
 
 #include <boost/tuple/tuple.hpp>
 
@@ -288,34 +289,84 @@ const bool Tru_utility::is_within_project(
    const vector<string> &srcFiles, 
    const string & srcGCNO,
    string & source_path ) const
+{
+   boost::mutex::scoped_lock lock( m_cache_mutex );
+   const Cache_value & found = find_cache_value( srcFiles, srcGCNO );
+
+   source_path = found.source_path;
+   return found.within_project;
+}
+
+const bool Tru_utility::is_within_project( 
+   const vector<string> &srcFiles, 
+   String_id source,
+   string & source_path ) const
+{
+   boost::mutex::scoped_lock lock( m_cache_mutex );
+   if ( source >= m_id_cache.size() )
+   {
+      m_id_cache.resize( source + 1, NULL );
+   }
+   if ( m_id_cache[source] == NULL )
+   {
+      m_id_cache[source] = &find_cache_value( srcFiles, 
+         String_table::get_instance().get_string( source ) );
+   }
+
+   source_path = m_id_cache[source]->source_path;
+   return m_id_cache[source]->within_project;
+}
+
+const Tru_utility::Cache_value & Tru_utility::find_cache_value( 
+   const vector<string> &srcFiles, 
+   const string & srcGCNO ) const
 {
    Cache::const_iterator found = m_cache.find(srcGCNO);
 
    if( found == m_cache.cend() )
    {
-      const string temp = get_filename( srcGCNO );
-      for ( unsigned i = 0; i < srcFiles.size(); ++i )
+      Cache_value value;
+
+      // The project index finds the source file by its file name at once
+      if ( m_project )
       {
-         if ( temp == get_filename( srcFiles[i] ) )
+         const Project_source * source = m_project->find_source( srcGCNO );
+         if ( source != NULL )
          {
-            bool success;
-            boost::tie(found,success) = m_cache.insert( std::make_pair( srcGCNO, Cache_value(srcFiles[i]) ));
-            assert(success);
-            break;
+            value = Cache_value( source->m_path );
          }
       }
-
-      if( found == m_cache.cend() )
+      else
       {
-         bool success;
-         boost::tie(found, success ) = m_cache.insert( std::make_pair( srcGCNO, Cache_value() ) );
-         assert( success );
+         const string temp = get_filename( srcGCNO );
+         for ( unsigned i = 0; i < srcFiles.size(); ++i )
+         {
+            if ( temp == get_filename( srcFiles[i] ) )
+            {
+               value = Cache_value( srcFiles[i] );
+               break;
+            }
+         }
       }
+
+      bool success;
+      boost::tie(found,success) = m_cache.insert( std::make_pair( srcGCNO, value ) );
+      assert(success);
    }
    assert( found != m_cache.end() );
 
-   source_path = found->second.source_path;
-   return found->second.within_project;
+   return found->second;
+}
+
+void Tru_utility::set_project_context( 
+   const boost::shared_ptr<const Project_context> & project )
+{
+   boost::mutex::scoped_lock lock( m_cache_mutex );
+
+   // The cached lookups may come from other source files
+   m_project = project;
+   m_cache.clear();
+   m_id_cache.clear();
 }
 
 const string Tru_utility::get_filename( const string & pathname ) const
@@ -460,11 +511,11 @@ string Tru_utility::escape_function_signature(const string & signature)
 
 void Tru_utility::sort_records(
    vector<Record *> & list,
-   map<Source_file::Source_key, Record> & records,
+   Source_file::Record_map & records,
    bool sort_line)
 {
       list.clear();
-      for( map<Source_file::Source_key, Record>::iterator i = records.begin();
+      for( Source_file::Record_map::iterator i = records.begin();
            i != records.end();
            ++i )
       {
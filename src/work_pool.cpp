@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file work_pool.cpp
+///
+///  @brief
+///  Implements the Work_pool class methods.
+///////////////////////////////////////////////////////////////////////////////
+
+// LOCAL INCLUDES
+
+#include "work_pool.h"
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+// USING STATEMENTS
+
+using std::size_t;
+using std::vector;
+
+// FUNCTION DEFINITIONS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Initializes an idle pool with one empty queue per worker.
+///////////////////////////////////////////////////////////////////////////////
+Work_pool::Work_pool( unsigned int worker_count )
+{
+   if ( worker_count == 0 )
+   {
+      worker_count = 1;
+   }
+
+   for ( unsigned int i = 0; i < worker_count; ++i )
+   {
+      m_queues.push_back( boost::make_shared<Queue>() );
+   }
+} // End of Work_pool constructor
+
+///////////////////////////////////////////////////////////////////////////////
+Work_pool::~Work_pool()
+{
+   join();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Deals the jobs round robin to the workers and starts the threads.
+///
+/// @param jobs The job indices, in the order they should be started.
+/// @param job The function run for each index.
+///////////////////////////////////////////////////////////////////////////////
+void Work_pool::start( const vector<size_t> & jobs, const Job & job )
+{
+   m_job = job;
+
+   for ( size_t i = 0; i < jobs.size(); ++i )
+   {
+      m_queues[ i % m_queues.size() ]->m_jobs.push_back( jobs[i] );
+   }
+
+   for ( unsigned int i = 0; i < m_queues.size(); ++i )
+   {
+      m_threads.create_thread( boost::bind( &Work_pool::work, this, i ) );
+   }
+} // End of Work_pool::start(...)
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Waits for every job to complete.
+///////////////////////////////////////////////////////////////////////////////
+void Work_pool::join()
+{
+   m_threads.join_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Runs jobs until every queue is empty.
+///
+/// @param worker The index of the worker's own queue.
+///////////////////////////////////////////////////////////////////////////////
+void Work_pool::work( unsigned int worker )
+{
+   size_t job;
+
+   while ( take_job( worker, job ) )
+   {
+      m_job( job );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Takes the next job from the front of the worker's queue, or steals one
+/// from the back of another queue. No jobs are added once the pool has
+/// started, so finding every queue empty means the worker is done.
+///
+/// @return found(true), no jobs left(false)
+///////////////////////////////////////////////////////////////////////////////
+bool Work_pool::take_job( unsigned int worker, size_t & job )
+{
+   {
+      Queue & own = *m_queues[worker];
+      boost::mutex::scoped_lock lock( own.m_mutex );
+
+      if ( ! own.m_jobs.empty() )
+      {
+         job = own.m_jobs.front();
+         own.m_jobs.pop_front();
+         return true;
+      }
+   }
+
+   for ( unsigned int i = 1; i < m_queues.size(); ++i )
+   {
+      Queue & victim = *m_queues[ ( worker + i ) % m_queues.size() ];
+      boost::mutex::scoped_lock lock( victim.m_mutex );
+
+      if ( ! victim.m_jobs.empty() )
+      {
+         job = victim.m_jobs.back();
+         victim.m_jobs.pop_back();
+         return true;
+      }
+   }
+
+   return false;
+} // End of Work_pool::take_job(...)
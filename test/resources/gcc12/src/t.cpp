@@ -0,0 +1,3 @@
+#include "t.h"
+int f(int x) { if (x > 2) return x * 2; return inl(x); }
+int main(int argc, char**) { return f(argc) > 3; }
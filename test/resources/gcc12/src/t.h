@@ -0,0 +1 @@
+inline int inl(int x) { return x + 1; }
@@ -0,0 +1,25 @@
+#include <stdexcept>
+
+int classify(int x)
+{
+   if (x > 2 && x < 10)
+   {
+      return 1;
+   }
+   return 0;
+}
+
+void thrower(int x)
+{
+   if (x == 5)
+      throw std::runtime_error("x");
+}
+
+int main(int argc, char **)
+{
+   int total = 0;
+   for (int i = 0; i < 4; ++i)
+      total += classify(i + argc);
+   try { thrower(argc); } catch (...) { }
+   return total > 100;
+}
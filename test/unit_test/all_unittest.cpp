@@ -40,7 +40,20 @@
 #include "gcno_actors_unittest.cpp"
 #include "gcda_actors_unittest.cpp"
 #include "prims_unittest.cpp"
+#include "gcov_decoder_unittest.cpp"
+#include "work_pool_unittest.cpp"
+#include "mapped_file_unittest.cpp"
+#include "gcda_stream_unittest.cpp"
+#include "tar_archive_unittest.cpp"
+#include "gcov_json_decoder_unittest.cpp"
+#include "demangler_unittest.cpp"
+#include "project_context_unittest.cpp"
+#include "trace_unittest.cpp"
+#include "byte_order_unittest.cpp"
 #include "record_unittest.cpp"
+#include "arena_unittest.cpp"
+#include "dense_map_unittest.cpp"
+#include "string_table_unittest.cpp"
 #include "parser_builder_unittest.cpp"
 #include "parser_unittest.cpp"
 #include "coverage_creator_unittest.cpp"
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  arena_unittest.cpp 
+///
+///  @brief
+///  Tests the Arena class and the Arena_allocator template. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+
+// SOURCE FILE 
+
+#include "arena.h"
+#include "work_pool.h"
+
+#define private public // Needed to fill the line data.
+
+#include "record.h"
+
+#undef private
+
+using namespace std;
+
+class ArenaTest : public testing::Test
+{
+public:
+
+   // Allocates from the arena, as a parser thread does.
+   void allocate_job( size_t job )
+   {
+      results[job] = arena.allocate( 24 );
+   }
+
+protected:
+
+   Arena arena;
+   vector<void *> results;
+};
+
+// Verify the allocations are aligned and do not overlap.
+TEST_F(ArenaTest, allocates_aligned_memory)
+{
+   char * first = static_cast<char *>( arena.allocate( 1 ) );
+   char * second = static_cast<char *>( arena.allocate( 17 ) );
+   char * third = static_cast<char *>( arena.allocate( 8 ) );
+
+   EXPECT_EQ( 0u, reinterpret_cast<size_t>( first ) % Arena::Alignment );
+   EXPECT_EQ( 0u, reinterpret_cast<size_t>( second ) % Arena::Alignment );
+   EXPECT_EQ( 0u, reinterpret_cast<size_t>( third ) % Arena::Alignment );
+   EXPECT_GE( second, first + 1 );
+   EXPECT_GE( third, second + 17 );
+}
+
+// Verify the allocations are counted and share a chunk.
+TEST_F(ArenaTest, counts_allocations)
+{
+   Arena::Stats stats = arena.get_stats();
+   EXPECT_EQ( 0u, stats.m_allocations );
+   EXPECT_EQ( 0u, stats.m_chunks );
+
+   for ( size_t i = 0; i < 100; ++i )
+   {
+      arena.allocate( 16 );
+   }
+
+   stats = arena.get_stats();
+   EXPECT_EQ( 100u, stats.m_allocations );
+   EXPECT_EQ( 1600u, stats.m_bytes );
+   EXPECT_EQ( 1u, stats.m_chunks );
+   EXPECT_EQ( Arena::Chunk_size, stats.m_reserved );
+}
+
+// Verify a large allocation gets a chunk of its own and the current chunk
+// is still used.
+TEST_F(ArenaTest, large_allocations_get_their_own_chunk)
+{
+   char * small = static_cast<char *>( arena.allocate( 16 ) );
+   arena.allocate( Arena::Chunk_size );
+   char * next = static_cast<char *>( arena.allocate( 16 ) );
+
+   Arena::Stats stats = arena.get_stats();
+   EXPECT_EQ( 2u, stats.m_chunks );
+   EXPECT_EQ( 2 * Arena::Chunk_size, stats.m_reserved );
+   EXPECT_EQ( small + 16, next );
+}
+
+// Verify releasing frees the chunks at once.
+TEST_F(ArenaTest, release_frees_everything)
+{
+   for ( size_t i = 0; i < 10; ++i )
+   {
+      arena.allocate( Arena::Chunk_size / 8 );
+   }
+   arena.release();
+
+   Arena::Stats stats = arena.get_stats();
+   EXPECT_EQ( 0u, stats.m_allocations );
+   EXPECT_EQ( 0u, stats.m_chunks );
+   EXPECT_EQ( 0u, stats.m_reserved );
+
+   EXPECT_TRUE( arena.allocate( 16 ) != NULL );
+   EXPECT_EQ( 1u, arena.get_stats().m_chunks );
+}
+
+// Verify the threads allocate from chunks of their own and their counts
+// are kept once they exit.
+TEST_F(ArenaTest, threads_allocate_from_their_chunks)
+{
+   results.assign( 400, NULL );
+   vector<size_t> jobs;
+   for ( size_t i = 0; i < results.size(); ++i )
+   {
+      jobs.push_back( i );
+   }
+
+   {
+      Work_pool pool( 4 );
+      pool.start( jobs, boost::bind( &ArenaTest::allocate_job, this, _1 ) );
+      pool.join();
+   }
+
+   vector<void *> sorted( results );
+   std::sort( sorted.begin(), sorted.end() );
+   for ( size_t i = 1; i < sorted.size(); ++i )
+   {
+      ASSERT_TRUE( sorted[i] != NULL );
+      EXPECT_GE( static_cast<char *>( sorted[i] ), 
+         static_cast<char *>( sorted[i - 1] ) + 24 );
+   }
+
+   Arena::Stats stats = arena.get_stats();
+   EXPECT_EQ( 400u, stats.m_allocations );
+   EXPECT_GE( stats.m_chunks, 1u );
+   EXPECT_LE( stats.m_chunks, 4u );
+}
+
+// Verify the containers of the coverage model allocate from the model
+// arena.
+TEST_F(ArenaTest, model_containers_use_the_model_arena)
+{
+   const size_t before = Arena::get_model_arena().get_stats().m_allocations;
+
+   Line_list lines;
+   Line line = { 12, false };
+   lines.push_back( line );
+   Line_list copy( lines );
+
+   EXPECT_EQ( 12u, copy.front().m_line_num );
+   EXPECT_EQ( before + 2, 
+      Arena::get_model_arena().get_stats().m_allocations );
+
+   // The lines, runs and block spans of a built line table
+   Line_table table;
+   table.add_line( 0, String_table::get_instance().intern( "a.cpp" ), 12 );
+   table.build( 1 );
+
+   EXPECT_EQ( before + 5, 
+      Arena::get_model_arena().get_stats().m_allocations );
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  byte_order_unittest.cpp 
+///
+///  @brief
+///  Tests the byte order helpers against the scalar decoding. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cstdlib>
+
+// SOURCE FILE 
+
+#include "byte_order.h"
+
+using namespace std;
+
+TEST(ByteOrderTest, swap_int32)
+{
+   EXPECT_EQ( 0x78563412u, swap_int32( 0x12345678u ) );
+   EXPECT_EQ( 0x12345678u, swap_int32( swap_int32( 0x12345678u ) ) );
+}
+
+TEST(ByteOrderTest, scalar_big_endian)
+{
+   // Low int32 1, high int32 2, both big endian
+   const char run[] = { 0, 0, 0, 1, 0, 0, 0, 2 };
+   uint64_t value = 0;
+
+   decode_int64_run_scalar( run, 1, false, &value );
+   EXPECT_EQ( ( static_cast<uint64_t>( 2 ) << 32 ) | 1, value );
+}
+
+// Compares the selected kernel with the scalar decoding for runs of every
+// length around the vector widths, from an unaligned start.
+TEST(ByteOrderTest, matches_scalar)
+{
+   vector<char> bytes( 37 * 8 + 1 );
+   srand( 42 );
+   for ( size_t i = 0; i < bytes.size(); ++i )
+   {
+      bytes[i] = static_cast<char>( rand() );
+   }
+
+   for ( size_t count = 0; count <= 37; ++count )
+   {
+      for ( int little_endian = 0; little_endian < 2; ++little_endian )
+      {
+         vector<uint64_t> expected( count + 1 ), actual( count + 1 );
+         decode_int64_run_scalar( &bytes[1], count, little_endian, &expected[0] );
+         decode_int64_run( &bytes[1], count, little_endian, &actual[0] );
+
+         EXPECT_TRUE( expected == actual ) 
+            << int64_run_kernel_name() << " count " << count;
+      }
+   }
+}
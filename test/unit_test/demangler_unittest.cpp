@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  demangler_unittest.cpp 
+///
+///  @brief
+///  Tests the Demangler class. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+
+// SOURCE FILE 
+
+#include "demangler.h"
+#include "record.h"
+#include "work_pool.h"
+
+using namespace std;
+
+class DemanglerTest : public testing::Test
+{
+public:
+
+   // Demangles the name of a job, as the parser threads do.
+   void demangle_job( size_t job )
+   {
+      results[job] = &Demangler::get_instance().demangle( names[job % 2] );
+   }
+
+protected:
+
+   vector<string> names;
+   vector<const string *> results;
+};
+
+// Verify mangled names are demangled.
+TEST_F(DemanglerTest, demangles_names)
+{
+   Demangler & demangler = Demangler::get_instance();
+
+   EXPECT_EQ( "bar::foo(int)", demangler.demangle( "_ZN3bar3fooEi" ) );
+   EXPECT_EQ( "std::vector<int, std::allocator<int> >::size() const",
+      demangler.demangle( "_ZNKSt6vectorIiSaIiEE4sizeEv" ) );
+}
+
+// Verify names that are not mangled are kept.
+TEST_F(DemanglerTest, keeps_plain_names)
+{
+   Demangler & demangler = Demangler::get_instance();
+
+   EXPECT_EQ( "main", demangler.demangle( "main" ) );
+   EXPECT_EQ( "", demangler.demangle( "" ) );
+}
+
+// Verify each name is demangled once.
+TEST_F(DemanglerTest, remembers_names)
+{
+   Demangler & demangler = Demangler::get_instance();
+
+   const string & first = demangler.demangle( "_ZN5plain4onceEv" );
+   const size_t size = demangler.size();
+   const string & second = demangler.demangle( "_ZN5plain4onceEv" );
+
+   EXPECT_EQ( &first, &second );
+   EXPECT_EQ( size, demangler.size() );
+   EXPECT_EQ( "plain::once()", first );
+}
+
+// Verify the threads demangling the same names share them.
+TEST_F(DemanglerTest, shares_names_across_threads)
+{
+   names.push_back( "_ZN6shared5firstEv" );
+   names.push_back( "_ZN6shared6secondEi" );
+   results.assign( 200, NULL );
+   vector<size_t> jobs;
+   for ( size_t i = 0; i < results.size(); ++i )
+   {
+      jobs.push_back( i );
+   }
+
+   {
+      Work_pool pool( 4 );
+      pool.start( jobs, boost::bind( &DemanglerTest::demangle_job, this, _1 ) );
+      pool.join();
+   }
+
+   for ( size_t i = 0; i < results.size(); ++i )
+   {
+      ASSERT_TRUE( results[i] != NULL );
+      EXPECT_EQ( results[i % 2], results[i] );
+   }
+   EXPECT_EQ( "shared::first()", *results[0] );
+   EXPECT_EQ( "shared::second(int)", *results[1] );
+}
+
+// Verify records demangle their name when it is asked for.
+TEST_F(DemanglerTest, records_demangle_lazily)
+{
+   Record record;
+   record.m_name = "_ZN6record4nameEv";
+
+   EXPECT_TRUE( record.m_name_demangled.empty() );
+   EXPECT_EQ( "record::name()", record.get_name_demangled() );
+   EXPECT_EQ( "record::name()", record.m_name_demangled );
+}
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  dense_map_unittest.cpp 
+///
+///  @brief
+///  Tests the Dense_map template. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+// SOURCE FILE 
+
+#include "dense_map.h"
+#include "source_file.h"
+
+using namespace std;
+
+class DenseMapTest : public testing::Test
+{
+protected:
+
+   Dense_map<unsigned int, string> numbers;
+};
+
+// Verify the values are walked in key order, whatever the insertion order.
+TEST_F(DenseMapTest, walks_keys_in_order)
+{
+   const unsigned int keys[] = { 42, 7, 100, 3, 7, 64, 1000, 5 };
+   for ( size_t i = 0; i < sizeof( keys ) / sizeof( keys[0] ); ++i )
+   {
+      numbers[keys[i]] += "x";
+   }
+
+   ASSERT_EQ(numbers.size(), 7);
+   vector<unsigned int> walked;
+   for ( Dense_map<unsigned int, string>::const_iterator value = 
+            numbers.begin();
+         value != numbers.end(); ++value )
+   {
+      walked.push_back( value->first );
+   }
+   const unsigned int expected[] = { 3, 5, 7, 42, 64, 100, 1000 };
+   EXPECT_TRUE(equal( walked.begin(), walked.end(), expected ));
+   EXPECT_EQ(numbers[7], "xx");
+}
+
+// Verify find and count, before and after the table grows.
+TEST_F(DenseMapTest, finds_keys)
+{
+   EXPECT_TRUE(numbers.find( 1 ) == numbers.end());
+   EXPECT_EQ(numbers.count( 1 ), 0);
+
+   for ( unsigned int i = 0; i < 1000; ++i )
+   {
+      numbers[i * 37 % 1000] = "v";
+   }
+
+   ASSERT_EQ(numbers.size(), 1000);
+   for ( unsigned int i = 0; i < 1000; ++i )
+   {
+      Dense_map<unsigned int, string>::iterator value = numbers.find( i );
+      ASSERT_TRUE(value != numbers.end());
+      EXPECT_EQ(value->first, i);
+      EXPECT_EQ(numbers.count( i ), 1);
+   }
+   EXPECT_TRUE(numbers.find( 1000 ) == numbers.end());
+
+   // The iterator of a key is at its place in the order.
+   Dense_map<unsigned int, string>::iterator value = numbers.find( 500 );
+   ++value;
+   EXPECT_EQ(value->first, 501);
+}
+
+// Verify the values do not move when the map grows or is swapped.
+TEST_F(DenseMapTest, keeps_references)
+{
+   string & first = numbers[1];
+   first = "first";
+   for ( unsigned int i = 2; i < 500; ++i )
+   {
+      numbers[i] = "v";
+   }
+   EXPECT_EQ(&numbers[1], &first);
+
+   Dense_map<unsigned int, string> other;
+   other.swap( numbers );
+   EXPECT_TRUE(numbers.empty());
+   EXPECT_EQ(&other[1], &first);
+   EXPECT_EQ(first, "first");
+}
+
+// Verify a copy holds its own values, in the same order.
+TEST_F(DenseMapTest, copies)
+{
+   numbers[2] = "two";
+   numbers[1] = "one";
+
+   Dense_map<unsigned int, string> copy( numbers );
+   copy[1] = "uno";
+   EXPECT_EQ(numbers[1], "one");
+   EXPECT_EQ(copy.begin()->second, "uno");
+   EXPECT_EQ(( ++copy.begin() )->second, "two");
+
+   numbers = copy;
+   EXPECT_EQ(numbers[1], "uno");
+   numbers.clear();
+   EXPECT_TRUE(numbers.begin() == numbers.end());
+   EXPECT_EQ(copy.size(), 2);
+}
+
+// Verify the records are ordered by checksum, then by name.
+TEST_F(DenseMapTest, orders_record_keys)
+{
+   Source_file::Record_map records;
+   records[Source_file::Source_key( 9, "foo" )].m_line_num = 1;
+   records[Source_file::Source_key( 2, "zed" )].m_line_num = 2;
+   records[Source_file::Source_key( 9, "bar" )].m_line_num = 3;
+
+   ASSERT_EQ(records.size(), 3);
+   Source_file::Record_map::iterator rec = records.begin();
+   EXPECT_EQ((rec++)->second.m_line_num, 2);
+   EXPECT_EQ((rec++)->second.m_line_num, 3);
+   EXPECT_EQ((rec++)->second.m_line_num, 1);
+   EXPECT_TRUE(rec == records.end());
+}
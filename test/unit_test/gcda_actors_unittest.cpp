@@ -75,23 +75,23 @@ protected:
    // Called before every test.  
    virtual void SetUp()
    {
-      map<string, Source_file> r;
+      Source_file_map r;
       string path = "../scripts/svn_revision_script.sh";
       vector<string> source_list;
       m_parser_builder = new Parser_builder(r, path, source_list);
   
-      ofstream o;
+      Trace_writer o;
       m_parsing_data = new Parsing_data_gcda(*m_parser_builder, false, o);         
    }
 
    // Quick way to create a parser_data_gcda.
    Parsing_data_gcda create_parser_data(void)
    {
-      map<string, Source_file> r;
+      Source_file_map r;
       string path = "../scripts/svn_revision_script.sh";
       vector<string> source_list;
       Parser_builder parser_builder(r, path, source_list);
-      ofstream o;
+      Trace_writer o;
 
       Parsing_data_gcda data(parser_builder, false, o);    
       return data; 
@@ -104,17 +104,17 @@ protected:
 
 TEST(parsing_data_gcda, constructor)
 {
-   map<string, Source_file> r;
+   Source_file_map r;
    string path = "../scripts/svn_revision_script.sh";
    vector<string> source_list;
    Parser_builder parser_builder(r, path, source_list);
-   ofstream o;
+   Trace_writer o;
 
    Parsing_data_gcda data(parser_builder, false, o);    
  
    EXPECT_FALSE(data.is_dump);
    EXPECT_EQ( &data.parser_builder, &parser_builder );
-   EXPECT_EQ( &data.dump_file, &o );
+   EXPECT_EQ( &data.trace, &o );
 }
 
 //////////////////////////////////////////////////////////////////////////////
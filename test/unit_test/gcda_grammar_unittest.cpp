@@ -47,11 +47,11 @@ using namespace std;
 TEST(gcda_grammar_constructor, default_case)
 {
    ifstream s("../unit_test/resources/fast_protocol_test-control_cadi.gcda");
-   map<string, Source_file> r; 
+   Source_file_map r; 
    string path = "../scripts/svn_revision_script.sh";
    vector<string> source_list;
    Parser_builder parser_builder(r, path, source_list); 
-   ofstream d;
+   Trace_writer d;
 
    Gcda_grammar grammar(parser_builder, false, d);
    
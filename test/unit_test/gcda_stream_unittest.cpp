@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file gcda_stream_unittest.cpp
+///
+///  @brief
+///  Tests the Gcda_stream class.
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+// SOURCE FILE 
+
+#include "gcda_stream.h"
+
+using namespace std;
+
+TEST(GcdaStreamTest, reads_frames)
+{
+   string data( "3 /build/a.gcda\nabc" );
+   data += string( "4 /build/dir with space/b.gcda\n" ) + string( "\0\1\n\3", 4 );
+   data += "0 /build/c.gcda\n";
+   istringstream in( data );
+   Gcda_stream stream( in );
+
+   string path;
+   vector<char> payload;
+   ASSERT_TRUE( stream.next( path, payload ) );
+   EXPECT_EQ( "/build/a.gcda", path );
+   EXPECT_EQ( "abc", string( payload.begin(), payload.end() ) );
+
+   ASSERT_TRUE( stream.next( path, payload ) );
+   EXPECT_EQ( "/build/dir with space/b.gcda", path );
+   EXPECT_EQ( string( "\0\1\n\3", 4 ), string( payload.begin(), payload.end() ) );
+
+   ASSERT_TRUE( stream.next( path, payload ) );
+   EXPECT_EQ( "/build/c.gcda", path );
+   EXPECT_TRUE( payload.empty() );
+
+   EXPECT_FALSE( stream.next( path, payload ) );
+   EXPECT_FALSE( stream.is_failed() );
+}
+
+TEST(GcdaStreamTest, truncated_payload)
+{
+   istringstream in( "8 /build/a.gcda\nabc" );
+   Gcda_stream stream( in );
+
+   string path;
+   vector<char> payload;
+   EXPECT_FALSE( stream.next( path, payload ) );
+   EXPECT_TRUE( stream.is_failed() );
+}
+
+TEST(GcdaStreamTest, malformed_frame)
+{
+   const char * frames[] = { "x /build/a.gcda\n", "3/build/a.gcda\n", "3 \n" };
+
+   for ( size_t i = 0; i < sizeof( frames ) / sizeof( frames[0] ); ++i )
+   {
+      istringstream in( frames[i] );
+      Gcda_stream stream( in );
+
+      string path;
+      vector<char> payload;
+      EXPECT_FALSE( stream.next( path, payload ) );
+      EXPECT_TRUE( stream.is_failed() );
+   }
+}
+
+TEST(GcdaStreamTest, oversized_payload)
+{
+   istringstream in( "99999999999999999 a.gcda\nxx" );
+   Gcda_stream stream( in );
+
+   string path;
+   vector<char> payload;
+   EXPECT_FALSE( stream.next( path, payload ) );
+   EXPECT_TRUE( stream.is_failed() );
+   EXPECT_TRUE( payload.empty() );
+}
@@ -68,7 +68,7 @@ using namespace std;
 
 Parser_builder * m_parser_builder;
 Parsing_data_gcno * m_parsing_data; 
-map<string, Source_file> r;
+Source_file_map r;
 
 class Gcno_actors : public testing::Test
 {
@@ -85,18 +85,18 @@ protected:
       source_list.push_back("source");
       m_parser_builder = new Parser_builder(r, path, source_list);
   
-      ofstream o;
+      Trace_writer o;
       m_parsing_data = new Parsing_data_gcno(*m_parser_builder, false, o); 
    }
 
    // Quick way to create a parser_data_gcno.
    Parsing_data_gcno create_parser_data(void)
    {
-      map<string, Source_file> r;
+      Source_file_map r;
       string path = "../scripts/svn_revision_script.sh";
       vector<string> source_list;
       Parser_builder parser_builder(r, path, source_list);
-      ofstream o;
+      Trace_writer o;
 
       Parsing_data_gcno data(parser_builder, false, o);    
       return data; 
@@ -109,17 +109,17 @@ protected:
 
 TEST(parsing_data_gcno, constructor)
 {
-   map<string, Source_file> r;
+   Source_file_map r;
    string path = "../scripts/svn_revision_script.sh";
    vector<string> source_list;
    Parser_builder parser_builder(r, path, source_list);
-   ofstream o;
+   Trace_writer o;
 
    Parsing_data_gcno data(parser_builder, false, o);    
  
    EXPECT_FALSE(data.is_dump);
    EXPECT_EQ( &data.parser_builder, &parser_builder );
-   EXPECT_EQ( &data.dump_file, &o );
+   EXPECT_EQ( &data.trace, &o );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,508 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  gcov_decoder_unittest.cpp 
+///
+///  @brief
+///  Tests the Gcov_decoder class against the Spirit grammars. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <map>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// SOURCE FILE 
+#define protected public // Needed to test private methods.
+#define private public
+
+#include "gcov_decoder.h"
+#include "gcno_grammar.h"
+#include "gcda_grammar.h"
+#include "source_file.h"
+
+#undef protected // Undo changes made to test private methods.
+#undef private
+
+using namespace std;
+
+class GcovDecoderTest : public testing::Test
+{
+protected:
+
+   vector<char> gcno_buf, gcda_buf;
+   vector<string> found_source_files;
+   string revision_script;
+
+   // Called before every test.  
+   virtual void SetUp()
+   {
+      read_file( "../test/resources/BST/bst.gcno", gcno_buf );
+      read_file( "../test/resources/BST/bst.gcda", gcda_buf );
+
+      found_source_files.clear();
+      found_source_files.push_back( "bst.cpp" );
+      found_source_files.push_back( "bst.h" );
+      revision_script = "";
+
+      Selector::get_instance().select( vector<string>() );
+   }
+
+   void read_file( const char * path, vector<char> & buf )
+   {
+      ifstream in( path );
+      in.seekg( 0, ios::end );
+      buf.resize( in.tellg() );
+      in.seekg( 0, ios::beg );
+      in.read( &buf[0], buf.size() );
+   }
+
+   const char * first( const vector<char> & buf )
+   {
+      return &buf[0];
+   }
+
+   const char * last( const vector<char> & buf )
+   {
+      return &buf[0] + buf.size();
+   }
+};
+
+TEST_F(GcovDecoderTest, decode_gcno)
+{
+   Source_file_map sources;
+   Parser_builder parser_builder( sources, revision_script, found_source_files );
+   Trace_writer o;
+   Gcov_decoder decoder( parser_builder, false, o );
+
+   EXPECT_TRUE( decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true ) );
+   EXPECT_FALSE( sources.empty() );
+}
+
+TEST_F(GcovDecoderTest, decode_gcda)
+{
+   Source_file_map sources;
+   Parser_builder parser_builder( sources, revision_script, found_source_files );
+   Trace_writer o;
+   Gcov_decoder decoder( parser_builder, false, o );
+
+   EXPECT_TRUE( decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true ) );
+   EXPECT_TRUE( decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true ) );
+}
+
+TEST_F(GcovDecoderTest, decode_bad_magic)
+{
+   Source_file_map sources;
+   Parser_builder parser_builder( sources, revision_script, found_source_files );
+   Trace_writer o;
+   Gcov_decoder decoder( parser_builder, false, o );
+
+   EXPECT_FALSE( decoder.decode_gcno( first(gcda_buf), last(gcda_buf), true ) );
+   EXPECT_FALSE( decoder.decode_gcda( first(gcno_buf), last(gcno_buf), true ) );
+}
+
+TEST_F(GcovDecoderTest, decode_truncated)
+{
+   Source_file_map sources;
+   Parser_builder parser_builder( sources, revision_script, found_source_files );
+   Trace_writer o;
+   Gcov_decoder decoder( parser_builder, false, o );
+
+   EXPECT_FALSE( decoder.decode_gcno( first(gcno_buf), last(gcno_buf) - 6, true ) );
+}
+
+TEST_F(GcovDecoderTest, matches_grammar)
+{
+   Trace_writer o;
+
+   Source_file_map decoded;
+   Parser_builder decoder_builder( decoded, revision_script, found_source_files );
+   Gcov_decoder decoder( decoder_builder, false, o );
+   decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true );
+   decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true );
+
+   Source_file_map parsed;
+   Parser_builder grammar_builder( parsed, revision_script, found_source_files );
+   Gcno_grammar gcno_grammar( grammar_builder, false, o );
+   Gcda_grammar gcda_grammar( grammar_builder, false, o );
+   raw_parse( first(gcno_buf), last(gcno_buf), gcno_grammar, true );
+   raw_parse( first(gcda_buf), last(gcda_buf), gcda_grammar, true );
+
+   ASSERT_EQ( parsed.size(), decoded.size() );
+   for ( Source_file_map::iterator src = parsed.begin();
+         src != parsed.end(); ++src )
+   {
+      Source_file::Record_map & expected = src->second.m_records;
+      Source_file::Record_map & actual = decoded[src->first].m_records;
+      ASSERT_EQ( expected.size(), actual.size() );
+
+      for ( Source_file::Record_map::iterator rec = expected.begin();
+            rec != expected.end(); ++rec )
+      {
+         Record & other = actual[rec->first];
+         EXPECT_EQ( rec->second.m_name, other.m_name );
+         EXPECT_EQ( rec->second.m_line_num, other.m_line_num );
+         EXPECT_EQ( rec->second.m_blocks.size(), other.m_blocks.size() );
+         EXPECT_TRUE( rec->second.m_counts == other.m_counts );
+      }
+   }
+}
+
+// Parses the BST files with the Spirit grammars into the given sources.
+static void parse_with_grammars( const vector<char> * gcno_buf,
+   const vector<char> * gcda_buf, const vector<string> * found_source_files,
+   Source_file_map * sources, bool * parsed )
+{
+   Trace_writer o;
+   Parser_builder builder( *sources, "", *found_source_files );
+   Gcno_grammar gcno_grammar( builder, false, o );
+   Gcda_grammar gcda_grammar( builder, false, o );
+
+   const char * gcno = &(*gcno_buf)[0];
+   const char * gcda = &(*gcda_buf)[0];
+   *parsed = 
+      raw_parse( gcno, gcno + gcno_buf->size(), gcno_grammar, true ).full &&
+      raw_parse( gcda, gcda + gcda_buf->size(), gcda_grammar, true ).full;
+}
+
+// Tests grammars running on several threads at once each read the same data.
+TEST_F(GcovDecoderTest, grammars_on_threads)
+{
+   const unsigned thread_count = 4;
+   vector< Source_file_map > sources( thread_count );
+   bool parsed[thread_count];
+
+   boost::thread_group threads;
+   for ( unsigned i = 0; i < thread_count; ++i )
+   {
+      threads.create_thread( boost::bind( parse_with_grammars, &gcno_buf,
+         &gcda_buf, &found_source_files, &sources[i], &parsed[i] ) );
+   }
+   threads.join_all();
+
+   for ( unsigned i = 0; i < thread_count; ++i )
+   {
+      EXPECT_TRUE( parsed[i] );
+      ASSERT_EQ( sources[0].size(), sources[i].size() );
+
+      Source_file_map::iterator expected = sources[0].begin();
+      Source_file_map::iterator actual = sources[i].begin();
+      for ( ; expected != sources[0].end(); ++expected, ++actual )
+      {
+         Source_file::Record_map & records = expected->second.m_records;
+         ASSERT_EQ( records.size(), actual->second.m_records.size() );
+
+         for ( Source_file::Record_map::iterator rec = records.begin();
+               rec != records.end(); ++rec )
+         {
+            Record & other = actual->second.m_records[rec->first];
+            EXPECT_EQ( rec->second.m_name, other.m_name );
+            EXPECT_TRUE( rec->second.m_counts == other.m_counts );
+         }
+      }
+   }
+}
+
+// Tests records of unknown tags are skipped by their length.
+TEST_F(GcovDecoderTest, skips_unknown_tags)
+{
+   // An unknown tag of two words, inserted after the file headers
+   const unsigned int unknown[] = { 0x01470000, 2, 0xDEADBEEF, 0xDEADBEEF };
+   const char * record = reinterpret_cast<const char *>( unknown );
+   vector<char> gcno_extended( gcno_buf ), gcda_extended( gcda_buf );
+   gcno_extended.insert( gcno_extended.begin() + 12, 
+      record, record + sizeof( unknown ) );
+   gcda_extended.insert( gcda_extended.begin() + 12, 
+      record, record + sizeof( unknown ) );
+
+   Trace_writer o;
+   Source_file_map expected;
+   Parser_builder expected_builder( expected, revision_script, found_source_files );
+   Gcov_decoder expected_decoder( expected_builder, false, o );
+   expected_decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true );
+   expected_decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true );
+
+   Source_file_map actual;
+   Parser_builder actual_builder( actual, revision_script, found_source_files );
+   Gcov_decoder actual_decoder( actual_builder, false, o );
+   EXPECT_TRUE( actual_decoder.decode_gcno( 
+      first(gcno_extended), last(gcno_extended), true ) );
+   EXPECT_TRUE( actual_decoder.decode_gcda( 
+      first(gcda_extended), last(gcda_extended), true ) );
+
+   ASSERT_EQ( expected.size(), actual.size() );
+   for ( Source_file_map::iterator src = expected.begin();
+         src != expected.end(); ++src )
+   {
+      EXPECT_EQ( src->second.m_records.size(), 
+         actual[src->first].m_records.size() );
+   }
+}
+
+// Tests the functions of unselected sources are skipped but the selected
+// ones are decoded whole.
+TEST_F(GcovDecoderTest, skips_unselected_functions)
+{
+   Trace_writer o;
+   Source_file_map all;
+   Parser_builder all_builder( all, revision_script, found_source_files );
+   Gcov_decoder all_decoder( all_builder, false, o );
+   all_decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true );
+   all_decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true );
+
+   Selector::get_instance().select( vector<string>( 1, "bst.h" ) );
+
+   Source_file_map selected;
+   Parser_builder selected_builder( selected, revision_script, found_source_files );
+   Gcov_decoder selected_decoder( selected_builder, false, o );
+   EXPECT_TRUE( selected_decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true ) );
+   EXPECT_TRUE( selected_decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true ) );
+
+   Selector::get_instance().select( vector<string>() );
+
+   ASSERT_EQ( 1u, selected.size() );
+   Source_file::Record_map & records = selected.begin()->second.m_records;
+   Source_file::Record_map & expected = all[selected.begin()->first].m_records;
+   EXPECT_FALSE( records.empty() );
+   ASSERT_EQ( expected.size(), records.size() );
+   for ( Source_file::Record_map::iterator rec = records.begin();
+         rec != records.end(); ++rec )
+   {
+      EXPECT_EQ( expected[rec->first].m_blocks.size(), rec->second.m_blocks.size() );
+      EXPECT_TRUE( expected[rec->first].m_counts == rec->second.m_counts );
+   }
+}
+
+// Tests the functions whose structure another builder published are
+// stored with their counts only.
+TEST_F(GcovDecoderTest, skips_known_structures)
+{
+   // hpp() of hpp.hpp is compiled into both objects
+   vector<char> hpp_gcno, main_gcno, main_gcda;
+   read_file( "../test/resources/all_source_types/build/hpp.gcno", hpp_gcno );
+   read_file( "../test/resources/all_source_types/build/main.gcno", main_gcno );
+   read_file( "../test/resources/all_source_types/build/main.gcda", main_gcda );
+   found_source_files.push_back( "hpp.hpp" );
+
+   Trace_writer o;
+   Known_structures known;
+   Source_file_map hpp;
+   Parser_builder hpp_builder( hpp, revision_script, found_source_files, &known );
+   Gcov_decoder hpp_decoder( hpp_builder, false, o );
+   ASSERT_TRUE( hpp_decoder.decode_gcno( first(hpp_gcno), last(hpp_gcno), true ) );
+   known.publish( hpp );
+
+   Source_file_map alone;
+   Parser_builder alone_builder( alone, revision_script, found_source_files );
+   Gcov_decoder alone_decoder( alone_builder, false, o );
+   alone_decoder.decode_gcno( first(main_gcno), last(main_gcno), true );
+   alone_decoder.decode_gcda( first(main_gcda), last(main_gcda), true );
+
+   Source_file_map shared;
+   Parser_builder shared_builder( shared, revision_script, found_source_files, &known );
+   Gcov_decoder shared_decoder( shared_builder, false, o );
+   EXPECT_TRUE( shared_decoder.decode_gcno( first(main_gcno), last(main_gcno), true ) );
+   EXPECT_TRUE( shared_decoder.decode_gcda( first(main_gcda), last(main_gcda), true ) );
+
+   ASSERT_EQ( 1u, shared.count( "hpp.hpp" ) );
+   Source_file::Record_map & records = shared["hpp.hpp"].m_records;
+   ASSERT_FALSE( records.empty() );
+   for ( Source_file::Record_map::iterator rec = records.begin();
+         rec != records.end(); ++rec )
+   {
+      Record & expected = alone["hpp.hpp"].m_records[rec->first];
+      EXPECT_TRUE( known.is_known( "hpp.hpp", rec->first ) );
+      EXPECT_TRUE( rec->second.m_blocks.empty() );
+      EXPECT_FALSE( expected.m_blocks.empty() );
+      EXPECT_TRUE( expected.m_counts == rec->second.m_counts );
+
+      Record * structure = known.find_structure( "hpp.hpp", rec->first );
+      ASSERT_TRUE( structure != NULL );
+      EXPECT_EQ( expected.m_blocks.size(), structure->m_blocks.size() );
+   }
+}
+
+// Tests the line records are skipped when the lines are not wanted.
+TEST_F(GcovDecoderTest, skips_lines)
+{
+   Trace_writer o;
+   Source_file_map sources;
+   Parser_builder parser_builder( sources, revision_script, found_source_files );
+   parser_builder.set_with_lines( false );
+   Gcov_decoder decoder( parser_builder, false, o );
+
+   EXPECT_TRUE( decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true ) );
+   EXPECT_TRUE( decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true ) );
+
+   ASSERT_FALSE( sources.empty() );
+   for ( Source_file_map::iterator src = sources.begin();
+         src != sources.end(); ++src )
+   {
+      Source_file::Record_map & records = src->second.m_records;
+      for ( Source_file::Record_map::iterator rec = records.begin();
+            rec != records.end(); ++rec )
+      {
+         EXPECT_FALSE( rec->second.m_blocks.empty() );
+         rec->second.build();
+         for ( size_t i = 0; i < rec->second.m_blocks.size(); ++i )
+         {
+            EXPECT_EQ( 0u, rec->second.m_blocks[i].get_source_count() );
+         }
+      }
+   }
+}
+
+// Tests the gcc release is read from the version word.
+TEST_F(GcovDecoderTest, get_gcc_release)
+{
+   EXPECT_EQ( 403u, Gcov_decoder::get_gcc_release( 0x3430332A ) );
+   EXPECT_EQ( 407u, Gcov_decoder::get_gcc_release( 0x3430372A ) );
+   EXPECT_EQ( 705u, Gcov_decoder::get_gcc_release( 0x4137352A ) );
+   EXPECT_EQ( 903u, Gcov_decoder::get_gcc_release( 0x4139332A ) );
+   EXPECT_EQ( 1202u, Gcov_decoder::get_gcc_release( 0x4232322A ) );
+
+   EXPECT_EQ( Gcov_decoder::Layout_3_4, Gcov_decoder::get_layout( 0x3430332A ) );
+   EXPECT_EQ( Gcov_decoder::Layout_4_7, Gcov_decoder::get_layout( 0x3430372A ) );
+   EXPECT_EQ( Gcov_decoder::Layout_8, Gcov_decoder::get_layout( 0x4138302A ) );
+   EXPECT_EQ( Gcov_decoder::Layout_9, Gcov_decoder::get_layout( 0x4231302A ) );
+   EXPECT_EQ( Gcov_decoder::Layout_12, Gcov_decoder::get_layout( 0x4232322A ) );
+}
+
+// Tests the files of gcc 12, with byte lengths and unpadded strings.
+TEST_F(GcovDecoderTest, decode_gcc12)
+{
+   vector<char> gcno, gcda;
+   read_file( "../test/resources/gcc12/build/t.gcno", gcno );
+   read_file( "../test/resources/gcc12/build/t.gcda", gcda );
+   found_source_files.clear();
+   found_source_files.push_back( "t.cpp" );
+   found_source_files.push_back( "t.h" );
+
+   Trace_writer o;
+   Source_file_map sources;
+   Parser_builder parser_builder( sources, revision_script, found_source_files );
+   Gcov_decoder decoder( parser_builder, false, o );
+
+   EXPECT_TRUE( decoder.decode_gcno( first(gcno), last(gcno), true ) );
+   EXPECT_TRUE( decoder.decode_gcda( first(gcda), last(gcda), true ) );
+
+   ASSERT_EQ( 1u, sources.count( "t.cpp" ) );
+   ASSERT_EQ( 1u, sources.count( "t.h" ) );
+   EXPECT_EQ( 2u, sources["t.cpp"].m_records.size() );
+   EXPECT_EQ( 1u, sources["t.h"].m_records.size() );
+
+   for ( Source_file_map::iterator src = sources.begin();
+         src != sources.end(); ++src )
+   {
+      Source_file::Record_map & records = src->second.m_records;
+      for ( Source_file::Record_map::iterator rec = records.begin();
+            rec != records.end(); ++rec )
+      {
+         EXPECT_FALSE( rec->second.m_blocks.empty() );
+         EXPECT_FALSE( rec->second.m_counts.empty() );
+      }
+   }
+}
+
+// Tests a gcc 12 block count below the entry and exit blocks, or past the
+// most blocks a function may have, fails the gcno file.
+TEST_F(GcovDecoderTest, rejects_bad_block_count)
+{
+   vector<char> gcno;
+   read_file( "../test/resources/gcc12/build/t.gcno", gcno );
+   found_source_files.clear();
+   found_source_files.push_back( "t.cpp" );
+   found_source_files.push_back( "t.h" );
+
+   // The first blocks record: its tag, its length of 4 bytes and the count
+   const unsigned int header[] = { Gcov_decoder::Tag_blocks, 4 };
+   vector<char>::iterator found = search( gcno.begin(), gcno.end(), 
+      reinterpret_cast<const char *>( header ), 
+      reinterpret_cast<const char *>( header ) + sizeof( header ) );
+   ASSERT_TRUE( found != gcno.end() );
+   char * count = &*found + sizeof( header );
+
+   const unsigned int counts[] = { 0, 1, Gcov_decoder::Max_blocks + 1, 
+      0x7fffffff };
+   for ( size_t i = 0; i < sizeof( counts ) / sizeof( counts[0] ); ++i )
+   {
+      memcpy( count, &counts[i], sizeof( counts[i] ) );
+
+      Trace_writer o;
+      Source_file_map sources;
+      Parser_builder parser_builder( sources, revision_script, 
+         found_source_files );
+      Gcov_decoder decoder( parser_builder, false, o );
+
+      EXPECT_FALSE( decoder.decode_gcno( first(gcno), last(gcno), true ) );
+   }
+}
+
+// Tests a second gcda file of the same functions adds to their counts.
+TEST_F(GcovDecoderTest, adds_repeated_gcda)
+{
+   Trace_writer o;
+   Source_file_map once, twice;
+   Parser_builder once_builder( once, revision_script, found_source_files );
+   Parser_builder twice_builder( twice, revision_script, found_source_files );
+   Gcov_decoder once_decoder( once_builder, false, o );
+   Gcov_decoder twice_decoder( twice_builder, false, o );
+
+   ASSERT_TRUE( once_decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true ) );
+   ASSERT_TRUE( once_decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true ) );
+
+   ASSERT_TRUE( twice_decoder.decode_gcno( first(gcno_buf), last(gcno_buf), true ) );
+   for ( int i = 0; i < 2; ++i )
+   {
+      twice_builder.begin_gcda();
+      ASSERT_TRUE( twice_decoder.decode_gcda( first(gcda_buf), last(gcda_buf), true ) );
+   }
+
+   ASSERT_FALSE( once.empty() );
+   for ( Source_file_map::iterator src = once.begin();
+         src != once.end(); ++src )
+   {
+      Source_file::Record_map & records = src->second.m_records;
+      for ( Source_file::Record_map::iterator rec = records.begin();
+            rec != records.end(); ++rec )
+      {
+         vector<uint64_t> & counts = 
+            twice[src->first].m_records[rec->first].m_counts;
+         ASSERT_EQ( rec->second.m_counts.size(), counts.size() );
+         for ( size_t i = 0; i < counts.size(); ++i )
+         {
+            EXPECT_EQ( 2 * rec->second.m_counts[i], counts[i] );
+         }
+      }
+   }
+}
@@ -0,0 +1,329 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  gcov_json_decoder_unittest.cpp 
+///
+///  @brief
+///  Tests the Json_reader and Gcov_json_decoder classes. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+#include <map>
+
+// SOURCE FILE 
+#define protected public // Needed to test private methods.
+#define private public
+
+#include "json_reader.h"
+#include "gcov_json_decoder.h"
+#include "parser.h"
+#include "source_file.h"
+
+#undef protected // Undo changes made to test private methods.
+#undef private
+
+using namespace std;
+
+// Writes each value read as a token, to check their order.
+class Json_recorder : public Json_handler
+{
+public:
+
+   virtual bool start_object() { m_events += "{ "; return true; }
+   virtual bool end_object() { m_events += "} "; return true; }
+   virtual bool start_array() { m_events += "[ "; return true; }
+   virtual bool end_array() { m_events += "] "; return true; }
+   virtual bool key( const string & name ) 
+   { 
+      m_events += "k:" + name + " "; 
+      return true; 
+   }
+   virtual bool string_value( const string & value ) 
+   { 
+      m_events += "s:" + value + " "; 
+      return true; 
+   }
+   virtual bool number_value( const string & text ) 
+   { 
+      m_events += "n:" + text + " "; 
+      return true; 
+   }
+   virtual bool bool_value( bool value ) 
+   { 
+      m_events += value ? "true " : "false "; 
+      return true; 
+   }
+   virtual bool null_value() { m_events += "null "; return true; }
+
+   string m_events;
+};
+
+// Reads a text into a recorder.
+static bool read_json( const string & text, string & events )
+{
+   istringstream in( text );
+   Json_reader reader( in );
+   Json_recorder recorder;
+
+   const bool read = reader.read( recorder );
+   events = recorder.m_events;
+   return read;
+}
+
+TEST(JsonReaderTest, reports_values_in_order)
+{
+   string events;
+   ASSERT_TRUE( read_json( 
+      " {\"a\": [1, -2.5e3, true, false, null], \"b\": {}, \"c\": [] }\n", 
+      events ) );
+   EXPECT_EQ( "{ k:a [ n:1 n:-2.5e3 true false null ] k:b { } k:c [ ] } ",
+      events );
+}
+
+TEST(JsonReaderTest, unescapes_strings)
+{
+   string events;
+   ASSERT_TRUE( read_json( 
+      "[\"a\\\"b\\\\c\\/d\\n\", \"\\u00e9\", \"\\ud83d\\ude00\"]", events ) );
+   EXPECT_EQ( "[ s:a\"b\\c/d\n s:\xC3\xA9 s:\xF0\x9F\x98\x80 ] ", events );
+}
+
+TEST(JsonReaderTest, rejects_malformed_texts)
+{
+   string events;
+   EXPECT_FALSE( read_json( "", events ) );
+   EXPECT_FALSE( read_json( "[1,]", events ) );
+   EXPECT_FALSE( read_json( "{\"a\" 1}", events ) );
+   EXPECT_FALSE( read_json( "{\"a\": 1", events ) );
+   EXPECT_FALSE( read_json( "[1] 2", events ) );
+   EXPECT_FALSE( read_json( "[1}", events ) );
+   EXPECT_FALSE( read_json( "[\"abc]", events ) );
+   EXPECT_FALSE( read_json( "[tru]", events ) );
+   EXPECT_FALSE( read_json( "[\"\\x\"]", events ) );
+}
+
+// Reads texts larger than a chunk of the reader.
+TEST(JsonReaderTest, reads_across_chunks)
+{
+   string text = "[";
+   for ( int i = 0; i < 20000; ++i )
+   {
+      text += i ? ", \"line\"" : "\"line\"";
+   }
+   text += "]";
+
+   string events;
+   ASSERT_TRUE( read_json( text, events ) );
+   EXPECT_EQ( 4u + 20000u * 7u, events.size() );
+}
+
+class GcovJsonDecoderTest : public testing::Test
+{
+protected:
+
+   vector<string> found_source_files;
+   string revision_script;
+   Source_file_map sources;
+
+   // Called before every test.  
+   virtual void SetUp()
+   {
+      found_source_files.push_back( "branches.cpp" );
+   }
+
+   // Returns the record of a function of branches.cpp.
+   Record * find_record( const string & name )
+   {
+      Source_file::Record_map & records = sources["branches.cpp"].m_records;
+      for ( Source_file::Record_map::iterator rec = records.begin();
+            rec != records.end(); ++rec )
+      {
+         if ( rec->second.m_name == name )
+         {
+            return &rec->second;
+         }
+      }
+      return NULL;
+   }
+
+   // Returns the first block of a record holding a line.
+   static const Block * find_line( const Record & rec, int line )
+   {
+      const String_id branches = 
+         String_table::get_instance().intern( "branches.cpp" );
+      for ( size_t i = 0; i < rec.m_blocks.size(); ++i )
+      {
+         const Block & block = rec.m_blocks[i];
+         for ( unsigned k = 0; k < block.get_source_count(); ++k )
+         {
+            if ( block.get_source( k ) == branches &&
+                 block.get_lines( k )[0].m_line_num == line )
+            {
+               return &block;
+            }
+         }
+      }
+      return NULL;
+   }
+
+   // Assigns and normalizes the counts of the decoded records as the
+   // parser does.
+   void normalize()
+   {
+      Parser & parser = Parser::get_instance();
+      parser.m_source_files.swap( sources );
+      parser.assign_entry_arcs();
+      parser.assign_arc_counts();
+      parser.normalize_arcs();
+      parser.normalize_fake_blocks();
+      parser.m_source_files.swap( sources );
+   }
+};
+
+TEST_F(GcovJsonDecoderTest, decodes_functions)
+{
+   Parser_builder builder( sources, revision_script, found_source_files );
+   Gcov_json_decoder decoder( builder );
+   ASSERT_TRUE( decoder.decode_file( 
+      "../test/resources/gcov_json/build/branches.gcov.json.gz" ) );
+
+   ASSERT_EQ( 1u, sources.size() );
+   ASSERT_EQ( 3u, sources["branches.cpp"].m_records.size() );
+
+   Record * classify = find_record( "_Z8classifyi" );
+   ASSERT_TRUE( classify != NULL );
+   EXPECT_EQ( "classify(int)", classify->get_name_demangled() );
+   EXPECT_EQ( 3u, classify->m_line_num );
+
+   // Every arc is counted
+   EXPECT_EQ( classify->m_graph.size(), classify->m_counts.size() );
+}
+
+// Tests the counts of the lines and branches survive the normalization.
+TEST_F(GcovJsonDecoderTest, keeps_counts)
+{
+   Parser_builder builder( sources, revision_script, found_source_files );
+   Gcov_json_decoder decoder( builder );
+   ASSERT_TRUE( decoder.decode_file( 
+      "../test/resources/gcov_json/build/branches.gcov.json.gz" ) );
+   normalize();
+
+   Record * classify = find_record( "_Z8classifyi" );
+   ASSERT_TRUE( classify != NULL );
+   EXPECT_EQ( 4u, classify->get_execution_count() );
+   EXPECT_EQ( 4u, classify->get_function_arc_total() );
+   EXPECT_EQ( 3u, classify->get_function_arc_taken() );
+   ASSERT_TRUE( find_line( *classify, 5 ) != NULL );
+   EXPECT_EQ( 4, find_line( *classify, 5 )->get_count() );
+   ASSERT_TRUE( find_line( *classify, 7 ) != NULL );
+   EXPECT_EQ( 2, find_line( *classify, 7 )->get_count() );
+   EXPECT_FALSE( find_line( *classify, 7 )->is_fake() );
+
+   // The throw is a branch, as it is in the gcno file
+   Record * thrower = find_record( "_Z7throweri" );
+   ASSERT_TRUE( thrower != NULL );
+   EXPECT_EQ( 1u, thrower->get_execution_count() );
+   EXPECT_EQ( 4u, thrower->get_function_arc_total() );
+   EXPECT_EQ( 1u, thrower->get_function_arc_taken() );
+   ASSERT_TRUE( find_line( *thrower, 15 ) != NULL );
+   EXPECT_EQ( 0, find_line( *thrower, 15 )->get_count() );
+   EXPECT_TRUE( find_line( *thrower, 15 )->is_branch() );
+
+   Record * main_rec = find_record( "main" );
+   ASSERT_TRUE( main_rec != NULL );
+   EXPECT_EQ( 4u, main_rec->get_function_arc_total() );
+   EXPECT_EQ( 3u, main_rec->get_function_arc_taken() );
+   ASSERT_TRUE( find_line( *main_rec, 22 ) != NULL );
+   EXPECT_EQ( 4, find_line( *main_rec, 22 )->get_count() );
+}
+
+// Tests a function found in two files has its counts added up.
+TEST_F(GcovJsonDecoderTest, adds_repeated_files)
+{
+   Parser_builder builder( sources, revision_script, found_source_files );
+   Gcov_json_decoder decoder( builder );
+   for ( int i = 0; i < 2; ++i )
+   {
+      ASSERT_TRUE( decoder.decode_file( 
+         "../test/resources/gcov_json/build/branches.gcov.json.gz" ) );
+   }
+   normalize();
+
+   ASSERT_EQ( 3u, sources["branches.cpp"].m_records.size() );
+   Record * classify = find_record( "_Z8classifyi" );
+   ASSERT_TRUE( classify != NULL );
+   EXPECT_EQ( 8u, classify->get_execution_count() );
+   EXPECT_EQ( 8, find_line( *classify, 5 )->get_count() );
+}
+
+// Tests the lines are matched to their functions by range when gcov does
+// not name their function.
+TEST_F(GcovJsonDecoderTest, matches_lines_by_range)
+{
+   Parser_builder builder( sources, revision_script, found_source_files );
+   Gcov_json_decoder decoder( builder );
+   istringstream in( 
+      "{\"format_version\": \"1\", \"files\": [{\"file\": \"branches.cpp\","
+      " \"functions\": [{\"name\": \"_Z1fv\", \"start_line\": 1,"
+      " \"end_line\": 3, \"execution_count\": 2},"
+      " {\"name\": \"_Z1gv\", \"start_line\": 5, \"end_line\": 6,"
+      " \"execution_count\": 0}],"
+      " \"lines\": [{\"line_number\": 5, \"count\": 0, \"branches\": []},"
+      " {\"line_number\": 2, \"count\": 2, \"branches\": [{\"count\": 1,"
+      " \"throw\": false, \"fallthrough\": true}, {\"count\": 1,"
+      " \"throw\": false, \"fallthrough\": false}]}]}]}" );
+   ASSERT_TRUE( decoder.decode( in ) );
+   normalize();
+
+   Record * f = find_record( "_Z1fv" );
+   ASSERT_TRUE( f != NULL );
+   EXPECT_EQ( 2u, f->get_function_arc_total() );
+   EXPECT_EQ( 2u, f->get_function_arc_taken() );
+   EXPECT_TRUE( find_line( *f, 5 ) == NULL );
+
+   Record * g = find_record( "_Z1gv" );
+   ASSERT_TRUE( g != NULL );
+   EXPECT_EQ( 0u, g->get_execution_count() );
+   ASSERT_TRUE( find_line( *g, 5 ) != NULL );
+   EXPECT_EQ( 0, find_line( *g, 5 )->get_count() );
+}
+
+TEST_F(GcovJsonDecoderTest, rejects_bad_files)
+{
+   Parser_builder builder( sources, revision_script, found_source_files );
+   Gcov_json_decoder decoder( builder );
+
+   EXPECT_FALSE( decoder.decode_file( 
+      "../test/resources/gcov_json/missing.gcov.json" ) );
+   EXPECT_FALSE( decoder.decode_file( "../test/resources/gcov_json/src/branches.cpp" ) );
+
+   istringstream in( "{\"files\": [{\"file\": \"branches.cpp\"" );
+   EXPECT_FALSE( decoder.decode( in ) );
+}
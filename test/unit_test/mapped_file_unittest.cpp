@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  mapped_file_unittest.cpp 
+///
+///  @brief
+///  Tests the Mapped_file class. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+// SOURCE FILE 
+
+#include "mapped_file.h"
+
+using namespace std;
+
+TEST(MappedFileTest, maps_regular_file)
+{
+   const char * path = "../test/resources/BST/bst.gcno";
+   Mapped_file file( path );
+
+   ifstream in( path );
+   vector<char> expected( ( istreambuf_iterator<char>( in ) ),
+      istreambuf_iterator<char>() );
+
+   ASSERT_TRUE( file.is_open() );
+   EXPECT_TRUE( file.is_mapped() );
+   ASSERT_EQ( expected.size(), file.size() );
+   EXPECT_TRUE( equal( file.begin(), file.end(), expected.begin() ) );
+}
+
+TEST(MappedFileTest, missing_file)
+{
+   Mapped_file file( "../test/resources/no_such_file.gcda" );
+
+   EXPECT_FALSE( file.is_open() );
+   EXPECT_EQ( 0u, file.size() );
+}
+
+// Files of /proc report a size of 0, so they take the read fallback.
+TEST(MappedFileTest, reads_unmappable_file)
+{
+   Mapped_file file( "/proc/self/status" );
+
+   ASSERT_TRUE( file.is_open() );
+   EXPECT_FALSE( file.is_mapped() );
+   EXPECT_LT( 0u, file.size() );
+}
+
+// Prefetching only warms the page cache, so the contents are unchanged and
+// a missing file is ignored.
+TEST(MappedFileTest, prefetch)
+{
+   const char * path = "../test/resources/BST/bst.gcda";
+   Mapped_file before( path );
+
+   Mapped_file::prefetch( path );
+   Mapped_file::prefetch( "../test/resources/no_such_file.gcda" );
+
+   Mapped_file after( path );
+   ASSERT_TRUE( after.is_open() );
+   ASSERT_EQ( before.size(), after.size() );
+   EXPECT_TRUE( equal( after.begin(), after.end(), before.begin() ) );
+}
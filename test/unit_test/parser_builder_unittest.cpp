@@ -52,8 +52,9 @@ using namespace std;
 using namespace boost;
 
 Parser_builder * pb_parser_builder = NULL;
-map<string, Source_file> pb_sources;
+Source_file_map pb_sources;
 vector<string> pb_sources_found; 
+const Source_file::Source_key foo_key( 1, "foo" );
 
 class ParserBuilderTest : public testing::Test
 {
@@ -69,7 +70,7 @@ protected:
 
    void init_pb(
       Parser_builder *& pb, 
-      map<string, Source_file> & sources,
+      Source_file_map & sources,
       vector<string> & sources_found,
       string & rev_path,
       vector<string> selection)
@@ -93,7 +94,7 @@ TEST_F(ParserBuilderTest, constructor)
    vector<string> selection;
    init_pb(pb_parser_builder, pb_sources, pb_sources_found, revision_script, selection);
 
-   EXPECT_EQ(pb_parser_builder->m_found_source_files.size(), 1);       
+   EXPECT_EQ(pb_parser_builder->m_project.get_source_files().size(), 1);       
    EXPECT_EQ(pb_parser_builder->m_source_files.size(), 0);
 }
 
@@ -105,6 +106,17 @@ TEST_F(ParserBuilderTest, store_record_not_within_project)
    EXPECT_FALSE(pb_parser_builder->m_last_record_selected);
 }
 
+TEST_F(ParserBuilderTest, store_record_not_within_project_skipped)
+{
+   // A mangled name of a function outside the project is never demangled
+   // or indexed, so the decoder skips the rest of its records.
+   pb_parser_builder->store_record(2,2,"sourc","_Z3barv",1);   
+
+   EXPECT_FALSE(pb_parser_builder->is_last_record_selected());
+   EXPECT_FALSE(pb_parser_builder->is_record_selected(2, 2));
+   EXPECT_EQ(pb_parser_builder->m_record_index.size(), 0);
+}
+
 TEST_F(ParserBuilderTest, store_blocks_not_within_project)
 {
    pb_parser_builder->store_blocks(1, 1, 0);   
@@ -141,43 +153,48 @@ TEST_F(ParserBuilderTest, store_record_new_record)
    pb_parser_builder->store_record(1,1,"source","foo",1);   
 
    EXPECT_EQ(pb_parser_builder->m_source_files.size(), 1);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_checksum, 1);
-   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[1].m_name.c_str(), "foo");
-   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[1].m_source.c_str(), "source");
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_checksum, 1);
+   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_name.c_str(), "foo");
+   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].get_source().c_str(), "source");
 }
 
 TEST_F(ParserBuilderTest, store_blocks_new_blocks)
 {
    pb_parser_builder->store_blocks(2, 1, 0);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks.size(), 1);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_blocks.size(), 1);
 
    pb_parser_builder->store_blocks(2, 1, 1);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks.size(), 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_blocks.size(), 2);
 }
 
 TEST_F(ParserBuilderTest, store_arcs_new_arcs)
 {
    pb_parser_builder->store_arcs(0, 1, 0);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks[0].m_arcs.size(), 1);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_graph.size(), 1);
 }
 
 TEST_F(ParserBuilderTest, store_line_number_new_line_number)
 {
    pb_parser_builder->store_line_number(0, 42, "linesource");   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks[0].m_lines["linesource"].m_lines.size(), 1);
+   pb_parser_builder->store_line_number(0, 42, "linesource");   
+   Record & rec = pb_parser_builder->m_source_files["source"].m_records[foo_key];
+   rec.build();
+   EXPECT_EQ(rec.m_blocks[0].get_source_count(), 1);
+   EXPECT_EQ(rec.m_blocks[0].get_source(0), String_table::get_instance().intern("linesource"));
+   EXPECT_EQ(rec.m_blocks[0].get_lines(0).size(), 1);
 
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks[0].m_lines["linesource"].m_lines[0].m_line_num, 42);
+   EXPECT_EQ(rec.m_blocks[0].get_lines(0)[0].m_line_num, 42);
 }
 
 TEST_F(ParserBuilderTest, store_count_new_count)
 {
    pb_parser_builder->store_count(1, 1, 1);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts.size(), 1);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts[0], 1);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts.size(), 1);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts[0], 1);
    
    pb_parser_builder->store_count(1, 1, 2);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts.size(), 2);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts[1], 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts.size(), 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts[1], 2);
 }
 
 TEST_F(ParserBuilderTest, store_record_merge)
@@ -185,9 +202,9 @@ TEST_F(ParserBuilderTest, store_record_merge)
    pb_parser_builder->store_record(1,1,"source","foo",1);   
 
    EXPECT_EQ(pb_parser_builder->m_source_files.size(), 1);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_checksum, 1);
-   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[1].m_name.c_str(), "foo");
-   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[1].m_source.c_str(), "source");
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_checksum, 1);
+   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_name.c_str(), "foo");
+   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].get_source().c_str(), "source");
   
    EXPECT_TRUE(pb_parser_builder->m_merging); 
 }
@@ -195,35 +212,37 @@ TEST_F(ParserBuilderTest, store_record_merge)
 TEST_F(ParserBuilderTest, store_blocks_merge)
 {
    pb_parser_builder->store_blocks(2, 1, 0);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks.size(), 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_blocks.size(), 2);
 
    pb_parser_builder->store_blocks(4, 4, 4);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks.size(), 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_blocks.size(), 2);
 }
 
 TEST_F(ParserBuilderTest, store_arcs_merge)
 {
    pb_parser_builder->store_arcs(4, 4, 4);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks[0].m_arcs.size(), 1);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_graph.size(), 1);
 }
 
 TEST_F(ParserBuilderTest, store_line_number_merge)
 {
    pb_parser_builder->store_line_number(0, 33, "linesource");   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks[0].m_lines["linesource"].m_lines.size(), 1);
+   Record & rec = pb_parser_builder->m_source_files["source"].m_records[foo_key];
+   rec.build();
+   EXPECT_EQ(rec.m_blocks[0].get_lines(0).size(), 1);
 
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_blocks[0].m_lines["linesource"].m_lines[0].m_line_num, 42);
+   EXPECT_EQ(rec.m_blocks[0].get_lines(0)[0].m_line_num, 42);
 }
 
 TEST_F(ParserBuilderTest, store_count_merge_counts)
 {
    pb_parser_builder->store_count(1, 1, 1);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts.size(), 2);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts[0], 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts.size(), 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts[0], 2);
    
    pb_parser_builder->store_count(1, 1, 2);   
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts.size(), 2);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_counts[1], 4);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts.size(), 2);
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_counts[1], 4);
 }
 
 TEST_F(ParserBuilderTest, store_record_no_rev_script_data)
@@ -232,13 +251,71 @@ TEST_F(ParserBuilderTest, store_record_no_rev_script_data)
    vector<string> selection;
    init_pb(pb_parser_builder, pb_sources, pb_sources_found, rev, selection);
 
-   EXPECT_EQ(pb_parser_builder->m_found_source_files.size(), 1);       
+   EXPECT_EQ(pb_parser_builder->m_project.get_source_files().size(), 1);       
    EXPECT_EQ(pb_parser_builder->m_source_files.size(), 0);
    
    pb_parser_builder->store_record(1,1,"source","foo",1);   
 
    EXPECT_EQ(pb_parser_builder->m_source_files.size(), 1);
-   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[1].m_checksum, 1);
-   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[1].m_name.c_str(), "foo");
-   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[1].m_source.c_str(), "source");
+   EXPECT_EQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_checksum, 1);
+   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].m_name.c_str(), "foo");
+   EXPECT_STREQ(pb_parser_builder->m_source_files["source"].m_records[foo_key].get_source().c_str(), "source");
+}
+
+TEST_F(ParserBuilderTest, store_counts_run)
+{
+   Source_file_map sources;
+   vector<string> sources_found( 1, "source" );
+   Selector::get_instance().select( vector<string>() );
+   Parser_builder pb( sources, "", sources_found );
+   uint64_t counts[3] = { 1, 2, 3 };
+   const Source_file::Source_key key( 9, "foo" );
+
+   pb.store_record(7,9,"source","foo",1);
+   pb.store_blocks(1, 0, 0);
+   pb.store_counts(7, 9, counts, 3);
+   ASSERT_EQ(sources["source"].m_records[key].m_counts.size(), 3);
+   EXPECT_EQ(sources["source"].m_records[key].m_counts[2], 3);
+
+   // Another function with the same checksum was not stored.
+   pb.store_counts(8, 9, counts, 3);
+   EXPECT_EQ(sources["source"].m_records[key].m_counts.size(), 3);
+
+   // Merged runs add up, and counts past the stored ones are dropped.
+   pb.store_record(7,9,"source","foo",1);
+   pb.store_counts(7, 9, counts, 2);
+   pb.store_counts(7, 9, counts, 2);
+   ASSERT_EQ(sources["source"].m_records[key].m_counts.size(), 3);
+   EXPECT_EQ(sources["source"].m_records[key].m_counts[0], 2);
+   EXPECT_EQ(sources["source"].m_records[key].m_counts[1], 4);
+   EXPECT_EQ(sources["source"].m_records[key].m_counts[2], 4);
+}
+
+TEST_F(ParserBuilderTest, store_record_checksum_collision)
+{
+   Source_file_map sources;
+   vector<string> sources_found( 1, "source" );
+   Selector::get_instance().select( vector<string>() );
+   Parser_builder pb( sources, "", sources_found );
+   uint64_t counts[1] = { 5 };
+
+   // Two functions with the same checksum are kept apart.
+   pb.store_record(1,9,"source","foo",1);
+   pb.store_blocks(1, 0, 0);
+   pb.store_counts(1, 9, counts, 1);
+   pb.store_record(2,9,"source","bar",3);
+   pb.store_blocks(1, 0, 0);
+   pb.store_counts(2, 9, counts, 1);
+   ASSERT_EQ(sources["source"].m_records.size(), 2);
+   EXPECT_STREQ(sources["source"].m_records.begin()->second.m_name.c_str(),
+      "bar");
+
+   // The same function from another object is merged, whatever its ident.
+   pb.begin_gcda();
+   pb.store_record(7,9,"source","foo",1);
+   pb.store_counts(7, 9, counts, 1);
+   ASSERT_EQ(sources["source"].m_records.size(), 2);
+   const Source_file::Source_key key( 9, "foo" );
+   EXPECT_EQ(sources["source"].m_records[key].m_counts[0], 10);
+   EXPECT_EQ(sources["source"].m_records[key].m_line_num, 1);
 }
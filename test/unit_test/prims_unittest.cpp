@@ -80,7 +80,7 @@ protected:
    string fail_buf;
 
    Parser_builder * parser_builder;   
-   map<string, Source_file> source_files;
+   Source_file_map source_files;
    vector<string> found_source_files;
 
    PrimsTest()
@@ -147,27 +147,27 @@ TEST_F(PrimsTest, reverse_buffer)
 
 TEST_F(PrimsTest, raw_parse_failure)
 {
-   ofstream o;
+   Trace_writer o;
    Gcno_grammar g( *parser_builder, false, o );
-   SP::parse_info<> info = raw_parse(fail_first, fail_last, g); 
+   SP::parse_info<> info = raw_parse(fail_first, fail_last, g, true); 
    
    EXPECT_FALSE(info.full);     
 }
 
 TEST_F(PrimsTest, raw_parse_gcno)
 {
-   ofstream o;
+   Trace_writer o;
    Gcno_grammar g( *parser_builder, false, o );
-   SP::parse_info<> info = raw_parse(gcno_first, gcno_last, g); 
+   SP::parse_info<> info = raw_parse(gcno_first, gcno_last, g, true); 
    
    EXPECT_TRUE(info.full);     
 }
 
 TEST_F(PrimsTest, raw_parse_gcda)
 {
-   ofstream o;
+   Trace_writer o;
    Gcda_grammar g( *parser_builder, false, o );
-   SP::parse_info<> info = raw_parse(gcda_first, gcda_last, g); 
+   SP::parse_info<> info = raw_parse(gcda_first, gcda_last, g, true); 
    
    EXPECT_TRUE(info.full);     
 }
@@ -240,119 +240,112 @@ TEST_F(PrimsTest, TOKEN32)
 TEST(int32_parser, big_endian_pass)
 {
    int32lit<unsigned int> p(1); 
-   global_little_endian = false;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[4] = { 0, 0, 0, 1 };    
    char * f = &b1[0];
    char * l = &b1[4];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(1, global_parsed_int32); 
+   EXPECT_EQ(1, hit.value()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 } 
 
 TEST(int32_parser, little_endian_pass)
 {
    int32lit<unsigned int> p(1); 
-   global_little_endian = true;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[4] = { 1, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[4];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(1, global_parsed_int32); 
+   EXPECT_EQ(1, hit.value()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(int32_parser, test_check_fails)
 {
    int32lit<unsigned int> p(2); 
-   global_little_endian = false;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[4] = { 0, 0, 0, 1 };    
    char * f = &b1[0];
    char * l = &b1[4];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(1, global_parsed_int32); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
  
 TEST(int32_parser, parse_failure_length0)
 {
    int32lit<unsigned int> p(1); 
-   global_little_endian = false;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[4] = { 0, 0, 0, 1 };    
    char * f = &b1[0];
    char * l = f;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(0, global_parsed_int32); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
  
 TEST(int32_parser, parse_failure_length1)
 {
    int32lit<unsigned int> p(1); 
-   global_little_endian = false;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[4] = { 0, 0, 0, 1 };    
    char * f = &b1[0];
    char * l = f + 1;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(0, global_parsed_int32); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
  
 TEST(int32_parser, parse_failure_length2)
 {
    int32lit<unsigned int> p(1); 
-   global_little_endian = false;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[4] = { 0, 0, 0, 1 };    
    char * f = &b1[0];
    char * l = f + 2;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(0, global_parsed_int32); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
  
 TEST(int32_parser, parse_failure_length3)
 {
    int32lit<unsigned int> p(1); 
-   global_little_endian = false;
-   global_parsed_int32 = 0; 
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[4] = { 0, 0, 0, 1 };    
    char * f = &b1[0];
    char * l = f + 3;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<unsigned int> hit = p.parse(scan);
 
-   EXPECT_EQ(0, global_parsed_int32); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
@@ -363,51 +356,48 @@ TEST(int32_parser, parse_failure_length3)
 TEST(string_parser, big_endian_pass)
 {
    string_parser<string> p;
-   global_little_endian = false;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b1[8] = { 0, 0, 0, 1, 'a', 'b', 'c', '\0' };    
    char * f = &b1[0];
    char * l = &b1[8];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("abc", global_parsed_string.c_str()); 
+   EXPECT_STREQ("abc", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, little_endian_pass)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 1, 0, 0, 0, 'a', 'b', 'c', '\0' };    
    char * f = &b1[0];
    char * l = &b1[8];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("abc", global_parsed_string.c_str()); 
+   EXPECT_STREQ("abc", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, consume_padding_length_1)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 1, 0, 0, 0, 'a', 'b', 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[8];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("ab", global_parsed_string.c_str()); 
+   EXPECT_STREQ("ab", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
@@ -415,76 +405,71 @@ TEST(string_parser, consume_padding_length_1)
 TEST(string_parser, consume_padding_length_2)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 1, 0, 0, 0, 'a', 0, 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[8];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("a", global_parsed_string.c_str()); 
+   EXPECT_STREQ("a", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, consume_padding_length_3)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[12] = { 2, 0, 0, 0, 'a', 'b', 'c', 'd', 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[12];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("abcd", global_parsed_string.c_str()); 
+   EXPECT_STREQ("abcd", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, consume_padding_length_4)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[12] = { 2, 0, 0, 0, 'a', 'b', 'c', 0, 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[12];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("abc", global_parsed_string.c_str()); 
+   EXPECT_STREQ("abc", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, consume_padding_length_5)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[12] = { 2, 0, 0, 0, 'a', 'b', 0, 0, 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[12];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("ab", global_parsed_string.c_str()); 
+   EXPECT_STREQ("ab", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, large_string)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[24] = {  5,   0,   0,   0, 
                   'a', 'b', 'c', 'd', 
@@ -495,129 +480,122 @@ TEST(string_parser, large_string)
    char * f = &b1[0];
    char * l = f + 24;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("abcdefghijkl", global_parsed_string.c_str()); 
+   EXPECT_STREQ("abcdefghijkl", hit.value().c_str()); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST(string_parser, failure_string_size_value_is_0)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = &b1[8];
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST(string_parser, failure_string_size_is_0_bytes)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = f;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST(string_parser, failure_string_size_is_1_bytes)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = f + 1;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST(string_parser, failure_string_size_is_3_bytes)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b1[0];
    char * l = f + 3;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST(string_parser, failure_string_is_4_bytes_short)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[12] = { 2, 0, 0, 0, 'a', 'b', 'c', 'd' };    
    char * f = &b1[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST(string_parser, failure_string_is_3_bytes_short)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 1, 0, 0, 0, 'a', 'b', 'c', 'd' };    
    char * f = &b1[0];
    char * l = f + 4;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST(string_parser, failure_string_is_1_byte_short)
 {
    string_parser<string> p;
-   global_little_endian = true;
-   global_parsed_string = "";
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b1[8] = { 1, 0, 0, 0, 'a', 'b', 'c', 'd' };    
    char * f = &b1[0];
    char * l = f + 7;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
 
-   EXPECT_STREQ("", global_parsed_string.c_str()); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
@@ -642,67 +620,63 @@ TEST(string_parser, failure_string_is_1_byte_short)
 TEST_F(int64_parser_test, pass_little_endian_number_is_1 )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 1, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(1, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(1, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_little_endian_number_1_below_max)
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
    uint64_t r = -2; 
-   EXPECT_TRUE( compare_64(r, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(r, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_little_endian_small_number )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 0x11, 0x22, 0x33, 0x44, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(0x44332211, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(0x44332211, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_little_endian_large_number )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
    uint64_t c = 0xfffffffe;
    c |= ((uint64_t) 0xffffffff) << 32; 
@@ -713,74 +687,70 @@ TEST_F(int64_parser_test, pass_little_endian_large_number )
 
    uint64_t r = 0x44332211;
    r |= ((uint64_t) 0x88776655) << 32; 
-   EXPECT_TRUE( compare_64(r, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(r, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_big_endian_number_is_1 )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = false;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b[8] = { 0, 0, 0, 1, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(1, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(1, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_big_endian_number_1_below_max)
 {
    int64_parser<uint64_t> p;
-   global_little_endian = false;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b[8] = { 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
    uint64_t r = -2; 
-   EXPECT_TRUE( compare_64(r, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(r, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_big_endian_small_number )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = false;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b[8] = { 0x44, 0x33, 0x22, 0x11, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(0x44332211, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(0x44332211, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, pass_big_endian_large_number )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = false;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(false));
  
    char b[8] = { 0x44, 0x33, 0x22, 0x11, 0x88, 0x77, 0x66, 0x55 };    
    char * f = &b[0];
    char * l = f + 8;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
    uint64_t c = 0xfffffffe;
    c |= ((uint64_t) 0xffffffff) << 32; 
@@ -791,58 +761,93 @@ TEST_F(int64_parser_test, pass_big_endian_large_number )
 
    uint64_t r = 0x44332211;
    r |= ((uint64_t) 0x88776655) << 32; 
-   EXPECT_TRUE( compare_64(r, global_parsed_int64) ); 
+   EXPECT_TRUE( compare_64(r, hit.value()) ); 
    EXPECT_TRUE(f == l && hit);        // good parse
 }
 
 TEST_F(int64_parser_test, failure_parse_length_0 )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 1, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 0;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(0, global_parsed_int64) ); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST_F(int64_parser_test, failure_parse_length_1 )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 1, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 1;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(0, global_parsed_int64) ); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
 TEST_F(int64_parser_test, failure_parse_length_7 )
 {
    int64_parser<uint64_t> p;
-   global_little_endian = true;
-   global_parsed_int64 = 0;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
  
    char b[8] = { 1, 0, 0, 0, 0, 0, 0, 0 };    
    char * f = &b[0];
    char * l = f + 7;
 
-   SP::scanner<char *, SP::scanner_policies<> > scan(f, l);
-   SP::match<SP::nil_t> hit = p.parse(scan);
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<uint64_t> hit = p.parse(scan);
 
-   EXPECT_TRUE( compare_64(0, global_parsed_int64) ); 
+   EXPECT_FALSE(hit);
    EXPECT_FALSE(f == l && hit);        // bad parse
 }
 
+
+TEST(string_parser, view_pass)
+{
+   string_parser<String_ref> p;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
+ 
+   const char b1[12] = { 2, 0, 0, 0, 'a', 'b', 'c', 0, 0, 0, 0, 0 };    
+   const char * f = &b1[0];
+   const char * l = &b1[12];
+
+   SP::scanner<const char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<String_ref> hit = p.parse(scan);
+
+   // The view points into the buffer, up to the null
+   EXPECT_TRUE(hit.value().begin() == &b1[4]);
+   EXPECT_EQ(3, hit.value().size());
+   EXPECT_TRUE(f == l && hit);        // good parse
+
+   string value = "previous";
+   assign_string_a(value)(hit.value());
+   EXPECT_EQ("abc", value);
+}
+
+TEST(string_parser, unterminated_stays_in_length)
+{
+   string_parser<string> p;
+   gcov_scanner_policies policies(gcov_iteration_policy(true));
+ 
+   char b1[12] = { 1, 0, 0, 0, 'a', 'b', 'c', 'd', 'e', 0, 0, 0 };    
+   char * f = &b1[0];
+   char * l = &b1[12];
+
+   SP::scanner<char *, gcov_scanner_policies> scan(f, l, policies);
+   SP::match<string> hit = p.parse(scan);
+
+   EXPECT_EQ("abcd", hit.value()); 
+   EXPECT_TRUE(f == &b1[8] && hit);
+}
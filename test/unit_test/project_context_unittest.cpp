@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  project_context_unittest.cpp 
+///
+///  @brief
+///  Tests the Project_context class. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+// SOURCE FILE 
+
+#define private public
+
+#include "project_context.h"
+#include "parser_builder.h"
+#include "tru_utility.h"
+
+#undef private
+
+using namespace std;
+
+class ProjectContextTest : public testing::Test
+{
+protected:
+
+   vector<string> source_files;
+
+   // Called before every test.  
+   virtual void SetUp()
+   {
+      source_files.clear();
+      source_files.push_back( "src/main.cpp" );
+      source_files.push_back( "src/tree/node.h" );
+      source_files.push_back( "lib/main.cpp" );
+   }
+};
+
+// Verify sources are found by their file name.
+TEST_F(ProjectContextTest, finds_sources_by_name)
+{
+   Project_context project( source_files, "" );
+
+   const Project_source * source = project.find_source( "/build/tree/node.h" );
+   ASSERT_TRUE( source != NULL );
+   EXPECT_EQ( "src/tree/node.h", source->m_path );
+   EXPECT_TRUE( source->m_revision_number.empty() );
+
+   source = project.find_source( "node.h" );
+   ASSERT_TRUE( source != NULL );
+   EXPECT_EQ( "src/tree/node.h", source->m_path );
+}
+
+// Verify the first source of a file name is the one found.
+TEST_F(ProjectContextTest, finds_first_source_of_name)
+{
+   Project_context project( source_files, "" );
+
+   const Project_source * source = project.find_source( "/other/main.cpp" );
+   ASSERT_TRUE( source != NULL );
+   EXPECT_EQ( "src/main.cpp", source->m_path );
+   EXPECT_EQ( 3u, project.get_source_files().size() );
+}
+
+// Verify sources outside the project are not found.
+TEST_F(ProjectContextTest, misses_sources_outside_project)
+{
+   Project_context project( source_files, "" );
+
+   EXPECT_TRUE( project.find_source( "/usr/include/c++/12/vector" ) == NULL );
+   EXPECT_TRUE( project.find_source( "" ) == NULL );
+}
+
+// Verify the revision numbers are resolved once for each source.
+TEST_F(ProjectContextTest, resolves_revision_numbers)
+{
+   // The revision script prints the file name of the source it is given
+   Project_context project( source_files, "basename" );
+
+   EXPECT_EQ( "node.h", project.find_source( "node.h" )->m_revision_number );
+   EXPECT_EQ( "main.cpp", project.find_source( "main.cpp" )->m_revision_number );
+}
+
+// Verify builders sharing a context store the sources it finds.
+TEST_F(ProjectContextTest, shared_by_builders)
+{
+   Project_context project( source_files, "" );
+   Selector::get_instance().select( vector<string>() );
+   Source_file_map first_sources;
+   Source_file_map second_sources;
+   Parser_builder first( first_sources, project );
+   Parser_builder second( second_sources, project );
+
+   first.store_record( 1, 1, "/build/src/main.cpp", "main", 1 );
+   second.store_record( 2, 2, "/usr/include/stdio.h", "printf", 1 );
+
+   ASSERT_EQ( 1u, first_sources.size() );
+   EXPECT_EQ( "src/main.cpp", 
+      first_sources["/build/src/main.cpp"].m_source_path );
+   EXPECT_TRUE( first.is_last_record_selected() );
+   EXPECT_TRUE( second_sources.empty() );
+   EXPECT_FALSE( second.is_last_record_selected() );
+}
+
+// Verify is_within_project looks the sources up in the project context set,
+// without scanning the source files it is given.
+TEST_F(ProjectContextTest, utility_uses_project_context)
+{
+   Tru_utility * utility = Tru_utility::get_instance();
+   utility->set_project_context( boost::shared_ptr<const Project_context>( 
+      new Project_context( source_files, "" ) ) );
+
+   string source_path;
+   EXPECT_TRUE( utility->is_within_project( vector<string>(), 
+      "/build/main.cpp", source_path ) );
+   EXPECT_EQ( "src/main.cpp", source_path );
+   EXPECT_FALSE( utility->is_within_project( source_files, 
+      "/build/other.cpp", source_path ) );
+
+   // Without a project context the given source files are scanned
+   utility->set_project_context( boost::shared_ptr<const Project_context>() );
+   EXPECT_FALSE( utility->is_within_project( vector<string>(), 
+      "/build/main.cpp", source_path ) );
+   EXPECT_TRUE( utility->is_within_project( source_files, 
+      "/build/tree/node.h", source_path ) );
+   EXPECT_EQ( "src/tree/node.h", source_path );
+}
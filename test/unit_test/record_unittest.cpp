@@ -45,36 +45,130 @@
 #undef protected // Undo changes made to test private methods.
 #undef private
 
+/// @brief
+/// Adds blocks and their outgoing arcs to a record, then builds the
+/// record's flow graph.
+class Graph_builder
+{
+public:
+   Graph_builder( Record & record ) : m_record( record ), m_block( 0 )
+   {
+   }
+
+   /// Adds a block, whose arcs are added next
+   Graph_builder & block( unsigned block_no )
+   {
+      m_record.m_blocks.push_back( Block( block_no ) );
+      m_block = block_no;
+      return *this;
+   }
+
+   /// Adds an arc leaving the last block added
+   Graph_builder & arc( unsigned dest, unsigned flag, int64_t count = -1 )
+   {
+      m_record.add_arc( m_block, dest, flag );
+      m_record.m_graph.m_arcs.back().m_count = count;
+      return *this;
+   }
+
+   /// Builds the flow graph of the record
+   void build()
+   {
+      m_record.build();
+   }
+
+private:
+   Record & m_record;
+   unsigned m_block;
+};
+
 //////////////////////////////////////////////////////////////////////////////
-// get_line_nums()
+// Line_table
 //////////////////////////////////////////////////////////////////////////////
 
-TEST(get_lines_test, no_lines)
+TEST(line_table_test, no_lines)
 {
    // Initialize
-   Lines_data l;
-
-   std::vector<Line> line_nums = l.get_lines();
+   Line_table t;
+   t.build( 2 );
 
    // Verify no lines assigned yet
-   EXPECT_EQ( 0, line_nums.size() );
+   EXPECT_EQ( 0, t.size() );
+   EXPECT_EQ( 0, t.get_source_count( 1 ) );
+   EXPECT_EQ( 0, t.get_source_count( 5 ) );
 }
 
-TEST(get_lines_test, has_lines)
+TEST(line_table_test, has_lines)
 {
-   // Initialize and add 2 lines
-   Lines_data l;
-   Line l1;
-   Line l2;
-   l1.m_line_num = 1;
-   l2.m_line_num = 3;
-   l.m_lines.push_back( l1 );
-   l.m_lines.push_back( l2 );
+   // Initialize and add 2 lines to block 1 and 1 line to block 0
+   const String_id a = String_table::get_instance().intern( "a.cpp" );
+   Line_table t;
+   t.add_line( 1, a, 3 );
+   t.add_line( 0, a, 7 );
+   t.add_line( 1, a, 1 );
+   t.build( 2 );
+
+   // Verify count and that the lines are sorted by line number
+   EXPECT_EQ( 3, t.size() );
+   ASSERT_EQ( 1, t.get_source_count( 1 ) );
+   Line_range lines = t.get_lines( 1, 0 );
+   ASSERT_EQ( 2, lines.size() );
+   EXPECT_EQ( 1, lines[0].m_line_num );
+   EXPECT_EQ( 3, lines[1].m_line_num );
+   EXPECT_EQ( 7, t.get_lines( 0, 0 )[0].m_line_num );
+}
 
-   std::vector<Line> line_nums = l.get_lines();
+TEST(line_table_test, drops_repeated_lines)
+{
+   const String_id a = String_table::get_instance().intern( "a.cpp" );
+   const String_id b = String_table::get_instance().intern( "b.cpp" );
+   Line_table t;
+   t.add_line( 0, a, 4 );
+   t.add_line( 0, b, 4 );
+   t.add_line( 0, a, 4 );
+   t.add_line( 3, a, 4 );
+   t.build( 1 );
+
+   // Verify a line number is kept once per source file, and the lines of
+   // blocks past the block count are dropped
+   EXPECT_EQ( 2, t.size() );
+   ASSERT_EQ( 2, t.get_source_count( 0 ) );
+   EXPECT_EQ( 0, t.find_source( 0, a ) );
+   EXPECT_EQ( 1, t.find_source( 0, b ) );
+   EXPECT_EQ( 1, t.get_lines( 0, 0 ).size() );
+}
 
-   // Verify count
-   EXPECT_EQ( 2, line_nums.size() );
+TEST(line_table_test, push_line)
+{
+   const String_id a = String_table::get_instance().intern( "a.cpp" );
+   const String_id b = String_table::get_instance().intern( "b.cpp" );
+   Line_table t;
+   t.add_line( 0, b, 1 );
+   t.add_line( 1, b, 2 );
+   t.build( 3 );
+
+   Line l = { 9, true };
+   t.push_line( 0, a, l );
+   t.push_line( 0, b, l );
+   t.push_line( 2, b, l );
+
+   // Verify the new lines are in place and the runs stay in name order
+   ASSERT_EQ( 2, t.get_source_count( 0 ) );
+   EXPECT_EQ( a, t.get_source( 0, 0 ) );
+   EXPECT_EQ( 9, t.get_lines( 0, 0 )[0].m_line_num );
+   ASSERT_EQ( 2, t.get_lines( 0, 1 ).size() );
+   EXPECT_EQ( 1, t.get_lines( 0, 1 )[0].m_line_num );
+   EXPECT_TRUE( t.get_lines( 0, 1 )[1].m_inlined );
+   EXPECT_EQ( 2, t.get_lines( 1, 0 )[0].m_line_num );
+   EXPECT_EQ( 9, t.get_lines( 2, 0 )[0].m_line_num );
+
+   // Verify a rebuild keeps the lines pushed and their inline status
+   t.add_line( 2, a, 5 );
+   t.build( 3 );
+   ASSERT_EQ( 2, t.get_lines( 0, 1 ).size() );
+   EXPECT_TRUE( t.get_lines( 0, 1 )[1].m_inlined );
+   ASSERT_EQ( 2, t.get_source_count( 2 ) );
+   EXPECT_EQ( 5, t.get_lines( 2, 0 )[0].m_line_num );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -213,11 +307,10 @@ TEST( block_constructor_test, default_constructor )
 TEST( is_end_block_test, not_end_block )
 {
    // Initialize
-   Block b( 4 );
-   Arc a( 1, 0, 0 );
-   b.m_arcs.push_back( a );
+   Record r;
+   Graph_builder( r ).block( 0 ).arc( 1, 0 ).build();
 
-   EXPECT_FALSE( b.is_end_block() );
+   EXPECT_FALSE( r.m_blocks[0].is_end_block() );
 }
 
 TEST( is_end_block_test, end_block )
@@ -235,11 +328,10 @@ TEST( is_end_block_test, end_block )
 TEST( is_start_block_test, not_start_block )
 {
    // Initialize
-   Block b( 4 );
-   Arc a( 1, 0, 0 );
-   b.m_from_arcs.push_back( &a );
+   Record r;
+   Graph_builder( r ).block( 0 ).arc( 1, 0 ).block( 1 ).build();
 
-   EXPECT_FALSE( b.is_start_block() );
+   EXPECT_FALSE( r.m_blocks[1].is_start_block() );
 }
 
 TEST( is_start_block_test, start_block )
@@ -257,28 +349,23 @@ TEST( is_start_block_test, start_block )
 TEST( is_branch_test, not_a_branch )
 {
    // Initialize
-   Block b0( 0 );
-   Block b1( 1 );
-   Arc a1( 1, 0, 0 );
-   b1.m_arcs.push_back( a1 );
+   Record r;
+   Graph_builder( r ).block( 0 ).block( 1 ).arc( 2, 0 ).build();
 
    // Verify case, no outgoing arcs
-   EXPECT_FALSE( b0.is_branch() );
+   EXPECT_FALSE( r.m_blocks[0].is_branch() );
    // Verify case, one outgoing arc
-   EXPECT_FALSE( b1.is_branch() );
+   EXPECT_FALSE( r.m_blocks[1].is_branch() );
 }
 
 TEST( is_branch_test, a_branch )
 {
    // Initialize
-   Block b( 0 );
-   Arc a0( 1, 0, 0 );
-   Arc a1( 2, 1, 1 );
-   b.m_arcs.push_back( a0 );
-   b.m_arcs.push_back( a1 );
+   Record r;
+   Graph_builder( r ).block( 0 ).arc( 1, 0 ).arc( 2, 1 ).build();
 
    // Verify case more than one outgoing arc
-   EXPECT_TRUE( b.is_branch() );
+   EXPECT_TRUE( r.m_blocks[0].is_branch() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -352,233 +439,132 @@ TEST( is_normalized_test, normalized )
 TEST( has_full_coverage_test, normal_no_coverage )
 {
    // Initialize
-
-   // Case 1 normal block has only a single outgoing fake arc
-   Block b1( 0 );
-   Arc a1( 1, 0, 2 );
-   b1.m_arcs.push_back( a1 );
-
-   // Case 2 normal block has only a single outgoing normal arc
-   Block b2( 0 );
-   Arc a2( 1, 0, 1 );
-   b2.m_arcs.push_back( a2 );
-
-   // Case 3 normal block has outgoing fake and normal arcs
-   Block b3( 0 );
-   Arc a3_1( 1, 0, 1 );
-   Arc a3_2( 1, 0, 3 );
-   b3.m_arcs.push_back( a3_1 );
-   b3.m_arcs.push_back( a3_2 );
+   Record r;
+   Graph_builder( r )
+      // Case 1 normal block has only a single outgoing fake arc
+      .block( 0 ).arc( 3, 2 )
+      // Case 2 normal block has only a single outgoing normal arc
+      .block( 1 ).arc( 3, 1 )
+      // Case 3 normal block has outgoing fake and normal arcs
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3 )
+      .build();
 
    // Verify all cases return w/ false
-   EXPECT_FALSE( b1.has_full_coverage() );
-   EXPECT_FALSE( b2.has_full_coverage() );
-   EXPECT_FALSE( b3.has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[0].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[1].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_full_coverage() );
 }
 
 TEST( has_full_coverage_test, fake_no_coverage )
 {
-   // Case 0 fake block has only a single outgoing fake arc
-   Block b0( 0 );
-   b0.m_fake = true;
-   Arc a0( 1, 0, 2 );
-   b0.m_arcs.push_back( a0 );
-
-   // Case 1 fake block has only a single outgoing normal arc
-   Block b1( 0 );
-   b1.m_fake = true;
-   Arc a1( 1, 0, 1 );
-   b1.m_arcs.push_back( a1 );
-
-   // Case 2 fake block has both normal and fake outoing arcs
-   Block b2( 0 );
-   b2.m_fake = true;
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 3 );
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 fake block has only a single outgoing fake arc
+      .block( 0 ).arc( 3, 2 )
+      // Case 1 fake block has only a single outgoing normal arc
+      .block( 1 ).arc( 3, 1 )
+      // Case 2 fake block has both normal and fake outoing arcs
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3 )
+      .build();
+   r.m_blocks[0].m_fake = true;
+   r.m_blocks[1].m_fake = true;
+   r.m_blocks[2].m_fake = true;
 
    // Verify all cases return w/ false
-   EXPECT_FALSE( b0.has_full_coverage() );
-   EXPECT_FALSE( b1.has_full_coverage() );
-   EXPECT_FALSE( b2.has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[0].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[1].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_full_coverage() );
 }
 
 TEST( has_full_coverage_test, normal_partial_coverage )
 {
    // Initialize
-
-   // Case 0 normal block has a taken outgoing normal arc
-   Block b0( 0 );
-   Arc a0_1( 1, 0, 1 );
-   Arc a0_2( 1, 0, 3 );
-   Arc a0_3( 1, 0, 5 );
-   a0_3.m_count = 1;
-   b0.m_arcs.push_back( a0_1 );
-   b0.m_arcs.push_back( a0_2 );
-   b0.m_arcs.push_back( a0_3 );
-
-   // Case 1 normal block has a taken normal and fake outgoing arcs
-   Block b1( 0 );
-   Arc a1_1( 1, 0, 1 );
-   Arc a1_2( 1, 0, 3 );
-   Arc a1_3( 1, 0, 5 );
-   a1_2.m_count = 1; 
-   a1_3.m_count = 1;
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-   b1.m_arcs.push_back( a1_3 );
-
-   // Case 2 normal block has a taken fake outgoing arc
-   Block b2( 0 );
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 3 );
-   Arc a2_3( 1, 0, 5 );
-   a2_2.m_count = 1; 
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
-   b2.m_arcs.push_back( a2_3 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 normal block has a taken outgoing normal arc
+      .block( 0 ).arc( 3, 1 ).arc( 3, 3 ).arc( 3, 5, 1 )
+      // Case 1 normal block has a taken normal and fake outgoing arcs
+      .block( 1 ).arc( 3, 1 ).arc( 3, 3, 1 ).arc( 3, 5, 1 )
+      // Case 2 normal block has a taken fake outgoing arc
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3, 1 ).arc( 3, 5 )
+      .build();
 
    // Verify all cases return w/ false
-   EXPECT_FALSE( b0.has_full_coverage() );
-   EXPECT_FALSE( b1.has_full_coverage() );
-   EXPECT_FALSE( b2.has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[0].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[1].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_full_coverage() );
 }
 
 TEST( has_full_coverage_test, fake_partial_coverage )
 {
    // Initialize
-
-   // Case 0 fake block has a taken outgoing normal arc
-   Block b0( 0 );
-   b0.m_fake = true;
-   Arc a0_1( 1, 0, 1 );
-   Arc a0_2( 1, 0, 3 );
-   Arc a0_3( 1, 0, 5 );
-   a0_3.m_count = 1;
-   b0.m_arcs.push_back( a0_1 );
-   b0.m_arcs.push_back( a0_2 );
-   b0.m_arcs.push_back( a0_3 );
-
-   // Case 1 fake block has a taken normal and fake outgoing arcs
-   Block b1( 0 );
-   b1.m_fake = true;
-   Arc a1_1( 1, 0, 1 );
-   Arc a1_2( 1, 0, 3 );
-   Arc a1_3( 1, 0, 5 );
-   a1_2.m_count = 1; 
-   a1_3.m_count = 1;
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-   b1.m_arcs.push_back( a1_3 );
-
-   // Case 2 fake block has a taken fake outgoing arc
-   Block b2( 0 );
-   b2.m_fake = true;
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 3 );
-   Arc a2_3( 1, 0, 5 );
-   a2_2.m_count = 1; 
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
-   b2.m_arcs.push_back( a2_3 );
-
-   // Case 3 fake block has a taken normal outgoing arcs
-   // but fake arc is untaken
-   Block b3( 0 );
-   b3.m_fake = true;
-   Arc a3_1( 1, 0, 1 );
-   Arc a3_2( 1, 0, 3 );
-   Arc a3_3( 1, 0, 5 );
-   a3_1.m_count = 1;
-   a3_3.m_count = 1;
-   b3.m_arcs.push_back( a3_1 );
-   b3.m_arcs.push_back( a3_2 );
-   b3.m_arcs.push_back( a3_3 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 fake block has a taken outgoing normal arc
+      .block( 0 ).arc( 4, 1 ).arc( 4, 3 ).arc( 4, 5, 1 )
+      // Case 1 fake block has a taken normal and fake outgoing arcs
+      .block( 1 ).arc( 4, 1 ).arc( 4, 3, 1 ).arc( 4, 5, 1 )
+      // Case 2 fake block has a taken fake outgoing arc
+      .block( 2 ).arc( 4, 1 ).arc( 4, 3, 1 ).arc( 4, 5 )
+      // Case 3 fake block has a taken normal outgoing arcs
+      // but fake arc is untaken
+      .block( 3 ).arc( 4, 1, 1 ).arc( 4, 3 ).arc( 4, 5, 1 )
+      .build();
+   for ( unsigned i = 0; i < 4; ++i )
+   {
+      r.m_blocks[i].m_fake = true;
+   }
 
    // Verify all cases return w/ false
-   EXPECT_FALSE( b0.has_full_coverage() );
-   EXPECT_FALSE( b1.has_full_coverage() );
-   EXPECT_FALSE( b2.has_full_coverage() );
-   EXPECT_FALSE( b3.has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[0].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[1].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_full_coverage() );
+   EXPECT_FALSE( r.m_blocks[3].has_full_coverage() );
 }
 
 TEST( has_full_coverage_test, normal_full_coverage )
 {
-   // Case 0 normal block has one single taken normal arc
-   Block b0( 0 );
-   Arc a0( 1, 0, 1 );
-   a0.m_count = 1;
-   b0.m_arcs.push_back( a0 );
-
-   // Case 1 normal block has one single taken normal arc
-   // But an untaken fake arc as well
-   Block b1( 0 );
-   Arc a1_1( 1, 0, 1 );
-   Arc a1_2( 1, 0, 2 );
-   a1_1.m_count = 1;
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-
-   // Case 2 normal block has all normal arcs taken
-   // but an untaken fake arc as well
-   Block b2( 0 );
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 2 );
-   Arc a2_3( 2, 1, 4 );
-   a2_1.m_count = 1;
-   a2_3.m_count = 1;
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
-   b2.m_arcs.push_back( a2_3 );
-
-   // Case 3 normal block has only a single taken outgoing fake arc
-   Block b3( 0 );
-   Arc a3( 1, 0, 2 );
-   a3.m_count = 1;
-   b3.m_arcs.push_back( a3 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 normal block has one single taken normal arc
+      .block( 0 ).arc( 4, 1, 1 )
+      // Case 1 normal block has one single taken normal arc
+      // But an untaken fake arc as well
+      .block( 1 ).arc( 4, 1, 1 ).arc( 4, 2 )
+      // Case 2 normal block has all normal arcs taken
+      // but an untaken fake arc as well
+      .block( 2 ).arc( 4, 1, 1 ).arc( 4, 2 ).arc( 5, 4, 1 )
+      // Case 3 normal block has only a single taken outgoing fake arc
+      .block( 3 ).arc( 4, 2, 1 )
+      .build();
 
    // Verify that all cases return with true
-   EXPECT_TRUE( b0.has_full_coverage() );
-   EXPECT_TRUE( b1.has_full_coverage() );
-   EXPECT_TRUE( b2.has_full_coverage() );
-   EXPECT_TRUE( b3.has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[0].has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[1].has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[2].has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[3].has_full_coverage() );
 }
 
 TEST( has_full_coverage_test, fake_full_coverage )
 {
-   // Case 0 fake block has one single taken normal arc
-   Block b0( 0 );
-   b0.m_fake = true;
-   Arc a0( 1, 0, 1 );
-   a0.m_count = 1;
-   b0.m_arcs.push_back( a0 );
-
-   // Case 1 fake block has one single taken fake arc
-   Block b1( 0 );
-   b1.m_fake = true;
-   Arc a1( 1, 0, 2 );
-   a1.m_count = 1;
-   b1.m_arcs.push_back( a1 );
-
-   // Case 2 normal block has all normal arcs taken
-   // and a taken fake arc as well
-   Block b2( 0 );
-   b2.m_fake = true;
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 2 );
-   Arc a2_3( 2, 1, 4 );
-   a2_1.m_count = 1;
-   a2_2.m_count = 1;
-   a2_3.m_count = 1;
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
-   b2.m_arcs.push_back( a2_3 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 fake block has one single taken normal arc
+      .block( 0 ).arc( 3, 1, 1 )
+      // Case 1 fake block has one single taken fake arc
+      .block( 1 ).arc( 3, 2, 1 )
+      // Case 2 normal block has all normal arcs taken
+      // and a taken fake arc as well
+      .block( 2 ).arc( 3, 1, 1 ).arc( 3, 2, 1 ).arc( 4, 4, 1 )
+      .build();
+   r.m_blocks[0].m_fake = true;
+   r.m_blocks[1].m_fake = true;
+   r.m_blocks[2].m_fake = true;
 
    // Verify that all cases return with true
-   EXPECT_TRUE( b0.has_full_coverage() );
-   EXPECT_TRUE( b1.has_full_coverage() );
-   EXPECT_TRUE( b2.has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[0].has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[1].has_full_coverage() );
+   EXPECT_TRUE( r.m_blocks[2].has_full_coverage() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -588,141 +574,82 @@ TEST( has_full_coverage_test, fake_full_coverage )
 TEST( has_partial_coverage, normal_no_coverage )
 {
    // Initialize
-
-   // Case 1 normal block has only a single outgoing fake arc
-   Block b1( 0 );
-   Arc a1( 1, 0, 2 );
-   b1.m_arcs.push_back( a1 );
-
-   // Case 2 normal block has only a single outgoing normal arc
-   Block b2( 0 );
-   Arc a2( 1, 0, 1 );
-   b2.m_arcs.push_back( a2 );
-
-   // Case 3 normal block has outgoing fake and normal arcs
-   Block b3( 0 );
-   Arc a3_1( 1, 0, 1 );
-   Arc a3_2( 1, 0, 3 );
-   b3.m_arcs.push_back( a3_1 );
-   b3.m_arcs.push_back( a3_2 );
+   Record r;
+   Graph_builder( r )
+      // Case 1 normal block has only a single outgoing fake arc
+      .block( 0 ).arc( 3, 2 )
+      // Case 2 normal block has only a single outgoing normal arc
+      .block( 1 ).arc( 3, 1 )
+      // Case 3 normal block has outgoing fake and normal arcs
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3 )
+      .build();
 
    // Verify all cases return w/ false
-   EXPECT_FALSE( b1.has_partial_coverage() );
-   EXPECT_FALSE( b2.has_partial_coverage() );
-   EXPECT_FALSE( b3.has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[0].has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[1].has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_partial_coverage() );
 }
 
 TEST( has_partial_coverage_test, fake_no_coverage )
 {
-   // Case 0 fake block has only a single outgoing fake arc
-   Block b0( 0 );
-   b0.m_fake = true;
-   Arc a0( 1, 0, 2 );
-   b0.m_arcs.push_back( a0 );
-
-   // Case 1 fake block has only a single outgoing normal arc
-   Block b1( 0 );
-   b1.m_fake = true;
-   Arc a1( 1, 0, 1 );
-   b1.m_arcs.push_back( a1 );
-
-   // Case 2 fake block has both normal and fake outoing arcs
-   Block b2( 0 );
-   b2.m_fake = true;
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 3 );
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 fake block has only a single outgoing fake arc
+      .block( 0 ).arc( 3, 2 )
+      // Case 1 fake block has only a single outgoing normal arc
+      .block( 1 ).arc( 3, 1 )
+      // Case 2 fake block has both normal and fake outoing arcs
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3 )
+      .build();
+   r.m_blocks[0].m_fake = true;
+   r.m_blocks[1].m_fake = true;
+   r.m_blocks[2].m_fake = true;
 
    // Verify all cases return w/ false
-   EXPECT_FALSE( b0.has_partial_coverage() );
-   EXPECT_FALSE( b1.has_partial_coverage() );
-   EXPECT_FALSE( b2.has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[0].has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[1].has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_partial_coverage() );
 }
 
 TEST( has_partial_coverage_test, normal_partial_coverage )
 {
    // Initialize
-
-   // Case 0 normal block has a taken outgoing normal arc
-   Block b0( 0 );
-   Arc a0_1( 1, 0, 1 );
-   Arc a0_2( 1, 0, 3 );
-   Arc a0_3( 1, 0, 5 );
-   a0_3.m_count = 1;
-   b0.m_arcs.push_back( a0_1 );
-   b0.m_arcs.push_back( a0_2 );
-   b0.m_arcs.push_back( a0_3 );
-
-   // Case 1 normal block has a taken normal and fake outgoing arcs
-   Block b1( 0 );
-   Arc a1_1( 1, 0, 1 );
-   Arc a1_2( 1, 0, 3 );
-   Arc a1_3( 1, 0, 5 );
-   a1_2.m_count = 1; 
-   a1_3.m_count = 1;
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-   b1.m_arcs.push_back( a1_3 );
-
-   // Case 2 normal block has a taken fake outgoing arc
-   Block b2( 0 );
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 3 );
-   Arc a2_3( 1, 0, 5 );
-   a2_2.m_count = 1; 
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
-   b2.m_arcs.push_back( a2_3 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 normal block has a taken outgoing normal arc
+      .block( 0 ).arc( 3, 1 ).arc( 3, 3 ).arc( 3, 5, 1 )
+      // Case 1 normal block has a taken normal and fake outgoing arcs
+      .block( 1 ).arc( 3, 1 ).arc( 3, 3, 1 ).arc( 3, 5, 1 )
+      // Case 2 normal block has a taken fake outgoing arc
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3, 1 ).arc( 3, 5 )
+      .build();
 
    // Verify all cases
-   EXPECT_TRUE( b0.has_partial_coverage() );
-   EXPECT_TRUE( b1.has_partial_coverage() );
-   EXPECT_FALSE( b2.has_partial_coverage() );
+   EXPECT_TRUE( r.m_blocks[0].has_partial_coverage() );
+   EXPECT_TRUE( r.m_blocks[1].has_partial_coverage() );
+   EXPECT_FALSE( r.m_blocks[2].has_partial_coverage() );
 }
 
 TEST( has_partial_coverage_test, fake_partial_coverage )
 {
    // Initialize
-
-   // Case 0 fake block has a taken outgoing normal arc
-   Block b0( 0 );
-   b0.m_fake = true;
-   Arc a0_1( 1, 0, 1 );
-   Arc a0_2( 1, 0, 3 );
-   Arc a0_3( 1, 0, 5 );
-   a0_3.m_count = 1;
-   b0.m_arcs.push_back( a0_1 );
-   b0.m_arcs.push_back( a0_2 );
-   b0.m_arcs.push_back( a0_3 );
-
-   // Case 1 fake block has a taken normal and fake outgoing arcs
-   Block b1( 0 );
-   b1.m_fake = true;
-   Arc a1_1( 1, 0, 1 );
-   Arc a1_2( 1, 0, 3 );
-   Arc a1_3( 1, 0, 5 );
-   a1_2.m_count = 1; 
-   a1_3.m_count = 1;
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-   b1.m_arcs.push_back( a1_3 );
-
-   // Case 2 fake block has a taken fake outgoing arc
-   Block b2( 0 );
-   b2.m_fake = true;
-   Arc a2_1( 1, 0, 1 );
-   Arc a2_2( 1, 0, 3 );
-   Arc a2_3( 1, 0, 5 );
-   a2_2.m_count = 1; 
-   b2.m_arcs.push_back( a2_1 );
-   b2.m_arcs.push_back( a2_2 );
-   b2.m_arcs.push_back( a2_3 );
+   Record r;
+   Graph_builder( r )
+      // Case 0 fake block has a taken outgoing normal arc
+      .block( 0 ).arc( 3, 1 ).arc( 3, 3 ).arc( 3, 5, 1 )
+      // Case 1 fake block has a taken normal and fake outgoing arcs
+      .block( 1 ).arc( 3, 1 ).arc( 3, 3, 1 ).arc( 3, 5, 1 )
+      // Case 2 fake block has a taken fake outgoing arc
+      .block( 2 ).arc( 3, 1 ).arc( 3, 3, 1 ).arc( 3, 5 )
+      .build();
+   r.m_blocks[0].m_fake = true;
+   r.m_blocks[1].m_fake = true;
+   r.m_blocks[2].m_fake = true;
 
    // Verify all cases return w/ true
-   EXPECT_TRUE( b0.has_partial_coverage() );
-   EXPECT_TRUE( b1.has_partial_coverage() );
-   EXPECT_TRUE( b2.has_partial_coverage() );
+   EXPECT_TRUE( r.m_blocks[0].has_partial_coverage() );
+   EXPECT_TRUE( r.m_blocks[1].has_partial_coverage() );
+   EXPECT_TRUE( r.m_blocks[2].has_partial_coverage() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -744,43 +671,73 @@ TEST( get_block_no_test, getter )
 TEST( get_arcs_test, getter )
 {
    // Initialize
-   Block b( 0 );
-   Arc a1( 1, 0, 1 );
-   Arc a2( 2, 1, 4 );
-   a1.m_count = 1;
-   a2.m_count = 2;
-   b.m_arcs.push_back( a1 );
-   b.m_arcs.push_back( a2 );
+   Record r;
+   Graph_builder( r ).block( 0 ).arc( 1, 1, 1 ).arc( 2, 4, 2 ).build();
 
-   const std::vector<Arc> & arcs = b.get_arcs();
+   const Arc_range arcs = r.m_blocks[0].get_arcs();
 
+   EXPECT_EQ( 2, arcs.size() );
    EXPECT_EQ( 1, arcs[0].m_dest_block );
    EXPECT_EQ( 0, arcs[0].m_origin_block );
    EXPECT_EQ( 1, arcs[0].m_flag );
    EXPECT_EQ( 1, arcs[0].m_count );
    EXPECT_EQ( 2, arcs[1].m_dest_block );
-   EXPECT_EQ( 1, arcs[1].m_origin_block );
+   EXPECT_EQ( 0, arcs[1].m_origin_block );
    EXPECT_EQ( 4, arcs[1].m_flag );
    EXPECT_EQ( 2, arcs[1].m_count );
 }
 
+TEST( get_arcs_test, unbound_block )
+{
+   // Initialize
+   Block b( 0 );
+
+   EXPECT_TRUE( b.get_arcs().empty() );
+   EXPECT_EQ( 0, b.get_from_arc_count() );
+}
+
 //////////////////////////////////////////////////////////////////////////////
-// get_line_data()
+// get_from_arc()
 //////////////////////////////////////////////////////////////////////////////
 
-TEST( get_line_data_test, getter )
+TEST( get_from_arc_test, getter )
 {
-   Block b( 1 );
-   Line l1;
-   Line l2;
-   l1.m_line_num = 5;
-   l2.m_line_num = 6;
-   b.m_lines[ "test" ].m_lines.push_back( l1 );
-   b.m_lines[ "test" ].m_lines.push_back( l2 );
+   // Initialize
+   Record r;
+   Graph_builder( r )
+      .block( 0 ).arc( 2, 0, 3 )
+      .block( 1 ).arc( 2, 1, 4 )
+      .block( 2 )
+      .build();
+
+   const Block & b = r.m_blocks[2];
+
+   EXPECT_EQ( 2, b.get_from_arc_count() );
+   EXPECT_EQ( 0, b.get_from_arc( 0 ).m_origin_block );
+   EXPECT_EQ( 3, b.get_from_arc( 0 ).get_count() );
+   EXPECT_EQ( 1, b.get_from_arc( 1 ).m_origin_block );
+   EXPECT_EQ( 4, b.get_from_arc( 1 ).get_count() );
+}
 
-   const std::map<std::string, Lines_data> & lines = b.get_lines();
+//////////////////////////////////////////////////////////////////////////////
+// get_line_data()
+//////////////////////////////////////////////////////////////////////////////
 
-   EXPECT_EQ( 1, lines.size() );
+TEST( get_line_data_test, getter )
+{
+   Record r;
+   Graph_builder( r ).block( 0 ).block( 1 );
+   const String_id test = String_table::get_instance().intern( "test" );
+   r.add_line( 1, test, 5 );
+   r.add_line( 1, test, 6 );
+   r.build();
+
+   const Block & b = r.m_blocks[1];
+
+   EXPECT_EQ( 1, b.get_source_count() );
+   EXPECT_EQ( test, b.get_source( 0 ) );
+   EXPECT_EQ( 2, b.get_lines( 0 ).size() );
+   EXPECT_EQ( 0, r.m_blocks[0].get_source_count() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -790,24 +747,14 @@ TEST( get_line_data_test, getter )
 TEST( get_branch_arc_taken_test, getter )
 {
    // Initialize
-   Block b0( 0 );
-   Arc a0( 1, 0, 0 );
-   Arc a1( 2, 0, 1 );
-   Arc a2( 4, 0, 4 );
-   Arc a3( 5, 0, 3 );
-   a0.m_count = 1;
-   a1.m_count = 0;
-   a2.m_count = 2;
-   a3.m_count = 0;
-   b0.m_arcs.push_back( a0 );
-   b0.m_arcs.push_back( a1 );
-   b0.m_arcs.push_back( a2 );
-   b0.m_arcs.push_back( a3 );
-
-   Block b1( 1 );
+   Record r;
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 0, 1 ).arc( 2, 1, 0 ).arc( 4, 4, 2 ).arc( 5, 3, 0 )
+      .block( 1 )
+      .build();
 
-   EXPECT_EQ( 2, b0.get_branch_arc_taken() );
-   EXPECT_EQ( 0, b1.get_branch_arc_taken() );
+   EXPECT_EQ( 2, r.m_blocks[0].get_branch_arc_taken() );
+   EXPECT_EQ( 0, r.m_blocks[1].get_branch_arc_taken() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -816,24 +763,14 @@ TEST( get_branch_arc_taken_test, getter )
 
 TEST( get_branch_arc_total_test, getter )
 {
-   Block b0( 0 );
-   Arc a0( 1, 0, 0 );
-   Arc a1( 2, 0, 1 );
-   Arc a2( 4, 0, 4 );
-   Arc a3( 5, 0, 3 );
-   a0.m_count = 1;
-   a1.m_count = 0;
-   a2.m_count = 2;
-   a3.m_count = 0;
-   b0.m_arcs.push_back( a0 );
-   b0.m_arcs.push_back( a1 );
-   b0.m_arcs.push_back( a2 );
-   b0.m_arcs.push_back( a3 );
-
-   Block b1( 1 );
+   Record r;
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 0, 1 ).arc( 2, 1, 0 ).arc( 4, 4, 2 ).arc( 5, 3, 0 )
+      .block( 1 )
+      .build();
 
-   EXPECT_EQ( 3, b0.get_branch_arc_total() );
-   EXPECT_EQ( 0, b1.get_branch_arc_total() );
+   EXPECT_EQ( 3, r.m_blocks[0].get_branch_arc_total() );
+   EXPECT_EQ( 0, r.m_blocks[1].get_branch_arc_total() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -842,41 +779,20 @@ TEST( get_branch_arc_total_test, getter )
 
 TEST( get_block_count_test, getter )
 {
-   // Case 1: Non start/end block
-   Block b( 1 );
-   Arc a0( 1, 0, 0 );
-   Arc a1( 2, 0, 1 );
-   Arc a2( 4, 0, 4 );
-   Arc a3( 5, 0, 3 );
-   a0.m_count = 1;
-   a1.m_count = 0;
-   a2.m_count = 2;
-   a3.m_count = 2;
-   b.m_from_arcs.push_back( &a0 );
-   b.m_from_arcs.push_back( &a1 );
-   b.m_from_arcs.push_back( &a2 );
-   b.m_from_arcs.push_back( &a3 );
-   b.m_arcs.push_back( a0 );
-   b.m_arcs.push_back( a1 );
-   b.m_arcs.push_back( a2 );
-   b.m_arcs.push_back( a3 );
-
-   // Case 2: Start block
-   Block b2( 2 );
-   Arc a4( 3, 0, 1);
-   a4.m_count = 3;
-   b2.m_arcs.push_back( a4 );
-
-   // Case 3: End block
-   Block b3( 3 );
-   Arc a5( 5, 0, 5);
-   a5.m_count = 5;
-   b3.m_from_arcs.push_back( &a5 );
-
-   //EXPECT_EQ( 4, b.m_from_arcs.size() );
-   EXPECT_EQ( 5, b.get_count() );
-   EXPECT_EQ( 0, b2.get_count() );
-   EXPECT_EQ( 0, b3.get_count() );
+   // Case 1: Non start/end block 1
+   // Case 2: Start block 0
+   // Case 3: End block 3
+   Record r;
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 0, 1 ).arc( 1, 1, 0 )
+      .block( 1 ).arc( 3, 1, 3 ).arc( 3, 5, 2 )
+      .block( 2 ).arc( 1, 4, 2 ).arc( 1, 3, 2 )
+      .block( 3 )
+      .build();
+
+   EXPECT_EQ( 5, r.m_blocks[1].get_count() );
+   EXPECT_EQ( 0, r.m_blocks[0].get_count() );
+   EXPECT_EQ( 0, r.m_blocks[3].get_count() );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -897,7 +813,7 @@ TEST( get_non_inlined_test, getter )
    b1.m_non_inlined.push_back( l1 );
    b1.m_non_inlined.push_back( l2 );
 
-   const std::vector<Line> & non_inlined = b1.get_non_inlined();
+   const Line_list & non_inlined = b1.get_non_inlined();
 
    EXPECT_FALSE( non_inlined.empty() );
    EXPECT_EQ( 2, non_inlined.size() );
@@ -905,6 +821,96 @@ TEST( get_non_inlined_test, getter )
    EXPECT_EQ( 14, non_inlined[1].m_line_num );
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Flow_graph::build()
+//////////////////////////////////////////////////////////////////////////////
+
+TEST( flow_graph_build_test, groups_arcs_by_origin )
+{
+   // Arcs added out of block order keep their order within a block
+   Flow_graph g;
+   g.add_arc( 1, 2, 0 );
+   g.add_arc( 0, 1, 0 );
+   g.add_arc( 1, 3, 4 );
+   g.add_arc( 0, 2, 1 );
+   g.build( 4 );
+
+   ASSERT_EQ( 4, g.size() );
+   EXPECT_EQ( 2, g.get_arc_count( 0 ) );
+   EXPECT_EQ( 1, g.get_arcs( 0 )[0].get_dest() );
+   EXPECT_EQ( 2, g.get_arcs( 0 )[1].get_dest() );
+   EXPECT_EQ( 2, g.get_arc_count( 1 ) );
+   EXPECT_EQ( 2, g.get_arcs( 1 )[0].get_dest() );
+   EXPECT_EQ( 3, g.get_arcs( 1 )[1].get_dest() );
+   EXPECT_EQ( 0, g.get_arc_count( 2 ) );
+   EXPECT_TRUE( g.get_arcs( 3 ).empty() );
+}
+
+TEST( flow_graph_build_test, indexes_entering_arcs )
+{
+   Flow_graph g;
+   g.add_arc( 0, 1, 0 );
+   g.add_arc( 0, 2, 1 );
+   g.add_arc( 1, 2, 0 );
+   g.build( 3 );
+
+   EXPECT_EQ( 0, g.get_from_arc_count( 0 ) );
+   EXPECT_EQ( 1, g.get_from_arc_count( 1 ) );
+   ASSERT_EQ( 2, g.get_from_arc_count( 2 ) );
+   EXPECT_EQ( 0, g.get_from_arc( 2, 0 ).m_origin_block );
+   EXPECT_EQ( 1, g.get_from_arc( 2, 1 ).m_origin_block );
+}
+
+TEST( flow_graph_build_test, unknown_blocks )
+{
+   // Blocks only referenced by arcs are indexed, unbuilt blocks are empty
+   Flow_graph g;
+   EXPECT_EQ( 0, g.get_arc_count( 0 ) );
+   EXPECT_EQ( 0, g.get_from_arc_count( 0 ) );
+
+   g.add_arc( 0, 5, 0 );
+   g.build( 1 );
+
+   EXPECT_EQ( 1, g.get_from_arc_count( 5 ) );
+   EXPECT_EQ( 0, g.get_arc_count( 9 ) );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Record( const Record & ), swap_graph()
+//////////////////////////////////////////////////////////////////////////////
+
+TEST( record_copy_test, copy_views_own_graph )
+{
+   Record r;
+   Graph_builder( r ).block( 0 ).arc( 1, 0, 1 ).block( 1 ).build();
+
+   Record copy( r );
+   r.m_graph.get_arc( 0, 0 ).m_count = 7;
+
+   EXPECT_EQ( &copy.m_graph, copy.m_blocks[0].m_graph );
+   EXPECT_EQ( 1, copy.m_blocks[0].get_arcs()[0].get_count() );
+   EXPECT_EQ( 7, r.m_blocks[0].get_arcs()[0].get_count() );
+
+   Record assigned;
+   assigned = r;
+   EXPECT_EQ( &assigned.m_graph, assigned.m_blocks[1].m_graph );
+   EXPECT_EQ( 7, assigned.m_blocks[0].get_arcs()[0].get_count() );
+}
+
+TEST( record_copy_test, swap_graph )
+{
+   Record r;
+   Graph_builder( r ).block( 0 ).arc( 1, 0, 1 ).block( 1 ).build();
+   Record other;
+
+   other.swap_graph( r );
+
+   EXPECT_TRUE( r.m_blocks.empty() );
+   ASSERT_EQ( 2, other.m_blocks.size() );
+   EXPECT_EQ( &other.m_graph, other.m_blocks[0].m_graph );
+   EXPECT_EQ( 1, other.m_blocks[0].get_arcs().size() );
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // get_HTML_name()
 //////////////////////////////////////////////////////////////////////////////
@@ -926,53 +932,16 @@ TEST( get_function_arc_taken_test, getter )
 {
    // Initialize
    Record r;
-
-   Block b0( 0 );
-   Block b1( 1 );
-   Block b2( 2 );
-   Block b3( 3 );
-   Block b4( 4 );
-   Block b5( 5 );
-   Block b6( 6 );
-
-   Arc a0_0( 1, 0, 1 );
-   Arc a1_0( 2, 1, 1 );
-   Arc a1_1( 3, 1, 4 );
-   Arc a1_2( 4, 1, 2 );
-   Arc a2_0( 6, 2, 4 );
-   Arc a3_0( 6, 3, 4 );
-   Arc a4_0( 6, 4, 1 );
-   Arc a4_1( 5, 4, 4 );
-   Arc a5_0( 6, 5, 4 );
-
-   a0_0.m_count = 2;
-   a1_0.m_count = 1;
-   a1_1.m_count = 1;
-   a1_2.m_count = 0;
-   a2_0.m_count = 1;
-   a3_0.m_count = 1;
-   a4_0.m_count = 0;
-   a4_1.m_count = 0;
-   a5_0.m_count = 0;
-
-   b0.m_arcs.push_back( a0_0 );
-   b1.m_arcs.push_back( a1_0 );
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-   b2.m_arcs.push_back( a2_0 );
-   b3.m_arcs.push_back( a3_0 );
-   b4.m_arcs.push_back( a4_0 );
-   b4.m_arcs.push_back( a4_1 );
-   b5.m_arcs.push_back( a5_0 );
-   b4.m_fake = true;
-
-   r.m_blocks.push_back( b0 );
-   r.m_blocks.push_back( b1 );
-   r.m_blocks.push_back( b2 );
-   r.m_blocks.push_back( b3 );
-   r.m_blocks.push_back( b4 );
-   r.m_blocks.push_back( b5 );
-   r.m_blocks.push_back( b6 );
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 1, 2 )
+      .block( 1 ).arc( 2, 1, 1 ).arc( 3, 4, 1 ).arc( 4, 2, 0 )
+      .block( 2 ).arc( 6, 4, 1 )
+      .block( 3 ).arc( 6, 4, 1 )
+      .block( 4 ).arc( 6, 1, 0 ).arc( 5, 4, 0 )
+      .block( 5 ).arc( 6, 4, 0 )
+      .block( 6 )
+      .build();
+   r.m_blocks[4].m_fake = true;
 
    EXPECT_EQ( 2, r.get_function_arc_taken() );
 }
@@ -985,53 +954,16 @@ TEST( get_function_arc_total_test, getter )
 {
    // Initialize
    Record r;
-
-   Block b0( 0 );
-   Block b1( 1 );
-   Block b2( 2 );
-   Block b3( 3 );
-   Block b4( 4 );
-   Block b5( 5 );
-   Block b6( 6 );
-
-   Arc a0_0( 1, 0, 1 );
-   Arc a1_0( 2, 1, 1 );
-   Arc a1_1( 3, 1, 4 );
-   Arc a1_2( 4, 1, 2 );
-   Arc a2_0( 6, 2, 4 );
-   Arc a3_0( 6, 3, 4 );
-   Arc a4_0( 6, 4, 1 );
-   Arc a4_1( 5, 4, 4 );
-   Arc a5_0( 6, 5, 4 );
-
-   a0_0.m_count = 2;
-   a1_0.m_count = 1;
-   a1_1.m_count = 1;
-   a1_2.m_count = 0;
-   a2_0.m_count = 1;
-   a3_0.m_count = 1;
-   a4_0.m_count = 0;
-   a4_1.m_count = 0;
-   a5_0.m_count = 0;
-
-   b0.m_arcs.push_back( a0_0 );
-   b1.m_arcs.push_back( a1_0 );
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_2 );
-   b2.m_arcs.push_back( a2_0 );
-   b3.m_arcs.push_back( a3_0 );
-   b4.m_arcs.push_back( a4_0 );
-   b4.m_arcs.push_back( a4_1 );
-   b5.m_arcs.push_back( a5_0 );
-   b4.m_fake = true;
-
-   r.m_blocks.push_back( b0 );
-   r.m_blocks.push_back( b1 );
-   r.m_blocks.push_back( b2 );
-   r.m_blocks.push_back( b3 );
-   r.m_blocks.push_back( b4 );
-   r.m_blocks.push_back( b5 );
-   r.m_blocks.push_back( b6 );
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 1, 2 )
+      .block( 1 ).arc( 2, 1, 1 ).arc( 3, 4, 1 ).arc( 4, 2, 0 )
+      .block( 2 ).arc( 6, 4, 1 )
+      .block( 3 ).arc( 6, 4, 1 )
+      .block( 4 ).arc( 6, 1, 0 ).arc( 5, 4, 0 )
+      .block( 5 ).arc( 6, 4, 0 )
+      .block( 6 )
+      .build();
+   r.m_blocks[4].m_fake = true;
 
    EXPECT_EQ( 2, r.get_function_arc_total() );
 }
@@ -1044,17 +976,9 @@ TEST( get_execution_count, getter )
 {
    // Initialize
    Record r;
-   Block b( 0 );
-   Arc a0( 1, 0, 1 );
-   Arc a1( 1, 0, 3 );
-   Arc a2( 1, 0, 5 );
-   a0.m_count = 2;
-   a1.m_count = 3;
-   a2.m_count = 0;
-   b.m_arcs.push_back( a0 );
-   b.m_arcs.push_back( a1 );
-   b.m_arcs.push_back( a2 );
-   r.m_blocks.push_back( b );
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 1, 2 ).arc( 1, 3, 3 ).arc( 1, 5, 0 )
+      .build();
 
    EXPECT_EQ( 5, r.get_execution_count() );
 }
@@ -1067,29 +991,12 @@ TEST( get_coverage_percentage_test, getter )
 {
    // Initialize
    Record r;
-   Block b0( 0 );
-   Block b1( 1 );
-   Block b2( 2 );
-   Block b3( 3 );
-   Arc a0( 1, 0, 1 );
-   Arc a1_0( 2, 1, 4 );
-   Arc a1_1( 3, 1, 5 );
-   Arc a1_2( 3, 1, 3 );
-   Arc a2( 3, 2, 1 );
-   a0.m_count = 1;
-   a1_0.m_count = 1;
-   a1_1.m_count = 0;
-   a1_2.m_count = 0;
-   a2.m_count = 0;
-   b0.m_arcs.push_back( a0 );
-   b1.m_arcs.push_back( a1_0 );
-   b1.m_arcs.push_back( a1_1 );
-   b1.m_arcs.push_back( a1_1 );
-   b2.m_arcs.push_back( a2 );
-   r.m_blocks.push_back( b0 );
-   r.m_blocks.push_back( b1 );
-   r.m_blocks.push_back( b2 );
-   r.m_blocks.push_back( b3 );
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 1, 1 )
+      .block( 1 ).arc( 2, 4, 1 ).arc( 3, 5, 0 ).arc( 3, 5, 0 )
+      .block( 2 ).arc( 3, 1, 0 )
+      .block( 3 )
+      .build();
 
    EXPECT_DOUBLE_EQ( 0.333, 
       (double)(int)(r.get_coverage_percentage() * 1000) / 1000 );
@@ -1099,20 +1006,11 @@ TEST( get_coverage_percentage_test, getter_no_branch_no_coverage )
 {
    // Initialize
    Record r;
-   Block b0( 0 );
-   Block b1( 1 );
-   Block b2( 2 );
-
-   Arc a0( 1, 0, 1 );
-   Arc a1( 2, 1, 4 );
-
-   a0.m_count = 0;
-   a1.m_count = 0;
-   b0.m_arcs.push_back( a0 );
-   b1.m_arcs.push_back( a1 );
-   r.m_blocks.push_back( b0 );
-   r.m_blocks.push_back( b1 );
-   r.m_blocks.push_back( b2 );
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 1, 0 )
+      .block( 1 ).arc( 2, 4, 0 )
+      .block( 2 )
+      .build();
 
    EXPECT_DOUBLE_EQ( 0.000, 
       (double)(int)(r.get_coverage_percentage() * 1000) / 1000 );
@@ -1122,20 +1020,11 @@ TEST( get_coverage_percentage_test, getter_no_branch_full_coverage )
 {
    // Initialize
    Record r;
-   Block b0( 0 );
-   Block b1( 1 );
-   Block b2( 2 );
-
-   Arc a0( 1, 0, 1 );
-   Arc a1( 2, 1, 4 );
-
-   a0.m_count = 1;
-   a1.m_count = 1;
-   b0.m_arcs.push_back( a0 );
-   b1.m_arcs.push_back( a1 );
-   r.m_blocks.push_back( b0 );
-   r.m_blocks.push_back( b1 );
-   r.m_blocks.push_back( b2 );
+   Graph_builder( r )
+      .block( 0 ).arc( 1, 1, 1 )
+      .block( 1 ).arc( 2, 4, 1 )
+      .block( 2 )
+      .build();
 
    EXPECT_DOUBLE_EQ( 1.000, 
       (double)(int)(r.get_coverage_percentage() * 1000) / 1000 );
@@ -163,6 +163,45 @@ TEST(is_selected_test, function_signature_selected)
    EXPECT_FALSE(selector.is_selected("", "fooo"));
 }
 
+// Verify is_selected, mangled names are demangled before they are matched.
+TEST(is_selected_test, mangled_name_demangled)
+{
+   // Initialize.
+   Selector & selector = Selector::get_instance();
+   vector<string> selection_list;
+   selection_list.push_back("foo");
+   Config & config = Config::get_instance();
+   config.m_bool_flag_value[Config::Full_match] = true;
+   config.m_bool_flag_value[Config::And] = false;
+   config.m_bool_flag_value[Config::Signature_match] = false;
+   config.m_bool_flag_value[Config::Mangle] = false;
+   selector.select( selection_list );
+
+   EXPECT_TRUE(selector.is_selected("source.cpp", "_ZN3bar3fooEi"));
+   EXPECT_FALSE(selector.is_selected("source.cpp", "_ZN3foo3barEi"));
+}
+
+// Verify is_selected, mangled names are matched as is in mangle mode.
+TEST(is_selected_test, mangled_name_selected)
+{
+   // Initialize.
+   Selector & selector = Selector::get_instance();
+   vector<string> selection_list;
+   selection_list.push_back("_ZN3bar3fooEi");
+   Config & config = Config::get_instance();
+   config.m_bool_flag_value[Config::Full_match] = true;
+   config.m_bool_flag_value[Config::And] = false;
+   config.m_bool_flag_value[Config::Signature_match] = false;
+   config.m_bool_flag_value[Config::Mangle] = true;
+   selector.select( selection_list );
+
+   EXPECT_TRUE(selector.is_selected("source.cpp", "_ZN3bar3fooEi"));
+   EXPECT_FALSE(selector.is_selected("source.cpp", "_ZN3foo3barEi"));
+
+   config.m_bool_flag_value[Config::Mangle] = false;
+   selector.select( vector<string>() );
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // check_in_selection() 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  string_table_unittest.cpp 
+///
+///  @brief
+///  Tests the String_table class. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+
+// SOURCE FILE 
+
+#include "string_table.h"
+#include "work_pool.h"
+#include "record.h"
+
+using namespace std;
+
+class StringTableTest : public testing::Test
+{
+public:
+
+   // Interns a name shared by several jobs, as a parser thread does.
+   void intern_job( size_t job )
+   {
+      ostringstream name;
+      name << "thread_" << job % 50 << ".cpp";
+      ids[job] = table.intern( name.str() );
+   }
+
+protected:
+
+   StringTableTest() : table( String_table::get_instance() )
+   {
+      // void
+   }
+
+   String_table & table;
+   vector<String_id> ids;
+};
+
+// Verify a string keeps its id and the empty string is id 0.
+TEST_F(StringTableTest, interns_once)
+{
+   const String_id first = table.intern( "interns_once.cpp" );
+   const String_id second = table.intern( "interns_once.hpp" );
+
+   EXPECT_NE( first, second );
+   EXPECT_EQ( first, table.intern( string( "interns_once.cpp" ) ) );
+   EXPECT_EQ( "interns_once.hpp", table.get_string( second ) );
+   EXPECT_EQ( String_table::Empty, table.intern( "" ) );
+   EXPECT_EQ( "", table.get_string( String_table::Empty ) );
+}
+
+// Verify the strings keep their ids past the first chunk.
+TEST_F(StringTableTest, grows)
+{
+   vector<String_id> grown;
+   for ( size_t i = 0; i < 3000; ++i )
+   {
+      ostringstream name;
+      name << "grows_" << i;
+      grown.push_back( table.intern( name.str() ) );
+   }
+
+   EXPECT_GE( table.size(), 3001u );
+   for ( size_t i = 0; i < grown.size(); ++i )
+   {
+      ostringstream name;
+      name << "grows_" << i;
+      ASSERT_EQ( name.str(), table.get_string( grown[i] ) );
+   }
+}
+
+// Verify the threads get the same id for the same string.
+TEST_F(StringTableTest, threads_share_ids)
+{
+   ids.assign( 400, String_table::Empty );
+   vector<size_t> jobs;
+   for ( size_t i = 0; i < ids.size(); ++i )
+   {
+      jobs.push_back( i );
+   }
+
+   {
+      Work_pool pool( 4 );
+      pool.start( jobs, boost::bind( &StringTableTest::intern_job, this, _1 ) );
+      pool.join();
+   }
+
+   for ( size_t i = 50; i < ids.size(); ++i )
+   {
+      ASSERT_EQ( ids[i - 50], ids[i] );
+   }
+   EXPECT_EQ( "thread_7.cpp", table.get_string( ids[7] ) );
+}
+
+// Verify the line data of a block is ordered by source file name, not by
+// interning order.
+TEST_F(StringTableTest, orders_lines_by_name)
+{
+   const String_id zed = table.intern( "orders_zed.cpp" );
+   const String_id alpha = table.intern( "orders_alpha.cpp" );
+
+   String_table::Less less;
+   EXPECT_TRUE( less( alpha, zed ) );
+   EXPECT_FALSE( less( zed, alpha ) );
+   EXPECT_FALSE( less( zed, zed ) );
+
+   Line_table lines;
+   lines.add_line( 0, zed, 1 );
+   lines.add_line( 0, alpha, 2 );
+   lines.build( 1 );
+   ASSERT_EQ( 2u, lines.get_source_count( 0 ) );
+   EXPECT_EQ( alpha, lines.get_source( 0, 0 ) );
+}
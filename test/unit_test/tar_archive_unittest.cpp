@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file tar_archive_unittest.cpp
+///
+///  @brief
+///  Tests the Tar_archive class.
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <boost/version.hpp>
+
+// SOURCE FILE 
+
+#include "tar_archive.h"
+
+using namespace std;
+
+// Returns a ustar header block of a member with a valid checksum.
+static string make_header( const string & name, const string & octal_size,
+   char type )
+{
+   string header( 512, '\0' );
+   header.replace( 0, name.size(), name );
+   header.replace( 100, 7, "0000644" );
+   header.replace( 124, octal_size.size(), octal_size );
+   header[156] = type;
+   header.replace( 257, 8, string( "ustar\0" "00", 8 ) );
+
+   header.replace( 148, 8, string( 8, ' ' ) );
+   unsigned sum = 0;
+   for ( size_t i = 0; i < header.size(); ++i )
+   {
+      sum += static_cast<unsigned char>( header[i] );
+   }
+   char checksum[8];
+   sprintf( checksum, "%06o", sum );
+   header.replace( 148, 7, string( checksum, 6 ) + '\0' );
+   return header;
+}
+
+// Checks an archive of the BST resources holds their gcno and gcda files.
+static void expect_bst_members( const Tar_archive & archive )
+{
+   ASSERT_TRUE( archive.is_open() );
+
+   const vector< pair<string, string> > & pairs = archive.get_pairs();
+   ASSERT_EQ( 2u, pairs.size() );
+   EXPECT_EQ( "BST/bst.gcno", pairs[0].first );
+   EXPECT_EQ( "BST/bst.gcda", pairs[0].second );
+   EXPECT_EQ( "BST/driver.gcno", pairs[1].first );
+   EXPECT_EQ( "BST/driver.gcda", pairs[1].second );
+
+   ifstream in( "../test/resources/BST/bst.gcda" );
+   vector<char> expected( ( istreambuf_iterator<char>( in ) ),
+      istreambuf_iterator<char>() );
+   const vector<char> * member = archive.find_member( "BST/bst.gcda" );
+   ASSERT_TRUE( member != NULL );
+   EXPECT_TRUE( expected == *member );
+
+   EXPECT_TRUE( archive.find_member( "BST/bst.h" ) == NULL );
+}
+
+TEST(TarArchiveTest, is_archive)
+{
+   EXPECT_TRUE( Tar_archive::is_archive( "shard.tar" ) );
+   EXPECT_TRUE( Tar_archive::is_archive( "/ci/shard.tar.gz" ) );
+   EXPECT_TRUE( Tar_archive::is_archive( "shard.tgz" ) );
+   EXPECT_TRUE( Tar_archive::is_archive( "shard.tar.zst" ) );
+   EXPECT_FALSE( Tar_archive::is_archive( "shard.gz" ) );
+   EXPECT_FALSE( Tar_archive::is_archive( "build" ) );
+}
+
+TEST(TarArchiveTest, reads_tar)
+{
+   Tar_archive archive;
+   EXPECT_TRUE( archive.open( "../test/resources/bundle/bst.tar" ) );
+   expect_bst_members( archive );
+}
+
+// The gzip archive is a pax archive whose names start with "./".
+TEST(TarArchiveTest, reads_tar_gz)
+{
+   Tar_archive archive;
+   EXPECT_TRUE( archive.open( "../test/resources/bundle/bst.tar.gz" ) );
+   expect_bst_members( archive );
+}
+
+#if BOOST_VERSION >= 107000
+TEST(TarArchiveTest, reads_tar_zst)
+{
+   Tar_archive archive;
+   EXPECT_TRUE( archive.open( "../test/resources/bundle/bst.tar.zst" ) );
+   expect_bst_members( archive );
+}
+#endif
+
+TEST(TarArchiveTest, missing_archive)
+{
+   Tar_archive archive;
+   EXPECT_FALSE( archive.open( "../test/resources/bundle/none.tar" ) );
+   EXPECT_FALSE( archive.is_open() );
+}
+
+TEST(TarArchiveTest, invalid_header)
+{
+   istringstream in( string( 512, 'x' ) );
+   Tar_archive archive;
+
+   EXPECT_FALSE( archive.read( in ) );
+   EXPECT_FALSE( archive.is_open() );
+}
+
+TEST(TarArchiveTest, truncated_member)
+{
+   ifstream file( "../test/resources/bundle/bst.tar" );
+   string data( ( istreambuf_iterator<char>( file ) ),
+      istreambuf_iterator<char>() );
+   istringstream in( data.substr( 0, 2048 ) );
+   Tar_archive archive;
+
+   EXPECT_FALSE( archive.read( in ) );
+}
+
+TEST(TarArchiveTest, pax_path)
+{
+   const string record( "15 path=b.gcno\n" );
+   string data = make_header( "pax", "00000000017", 'x' );
+   data += record + string( 512 - record.size(), '\0' );
+   data += make_header( "a.gcno", "00000000000", '0' );
+   data += string( 1024, '\0' );
+   istringstream in( data );
+   Tar_archive archive;
+
+   EXPECT_TRUE( archive.read( in ) );
+   EXPECT_TRUE( archive.find_member( "b.gcno" ) != NULL );
+   EXPECT_TRUE( archive.find_member( "a.gcno" ) == NULL );
+}
+
+TEST(TarArchiveTest, malformed_pax_record)
+{
+   // The lengths end before the space or the newline of their record
+   const char * records[] = { "1 ", "3 ab", "5 ab=c" };
+
+   for ( size_t i = 0; i < sizeof( records ) / sizeof( records[0] ); ++i )
+   {
+      const string record( records[i] );
+      char size[12];
+      sprintf( size, "%011o", static_cast<unsigned>( record.size() ) );
+
+      string data = make_header( "pax", size, 'x' );
+      data += record + string( 512 - record.size(), '\0' );
+      data += make_header( "a.gcno", "00000000000", '0' );
+      data += string( 1024, '\0' );
+      istringstream in( data );
+      Tar_archive archive;
+
+      EXPECT_FALSE( archive.read( in ) );
+      EXPECT_FALSE( archive.is_open() );
+   }
+}
+
+TEST(TarArchiveTest, oversized_member)
+{
+   // The header claims a member of 8 GiB, which the archive does not hold
+   string data = make_header( "a.gcda", "77777777777", '0' );
+   data += string( 512, 'x' );
+   istringstream in( data );
+   Tar_archive archive;
+
+   EXPECT_FALSE( archive.read( in ) );
+   EXPECT_FALSE( archive.is_open() );
+}
@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  trace_unittest.cpp 
+///
+///  @brief
+///  Tests the Trace_writer and Trace_reader classes. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// SOURCE FILE 
+
+#include "trace.h"
+#include "gcov_decoder.h"
+#include "gcno_grammar.h"
+#include "gcda_grammar.h"
+
+using namespace std;
+
+class TraceTest : public testing::Test
+{
+protected:
+
+   string path;
+
+   // Called before every test.  
+   virtual void SetUp()
+   {
+      path = "trace_unittest.trace";
+   }
+
+   // Called after every test.  
+   virtual void TearDown()
+   {
+      std::remove( path.c_str() );
+   }
+
+   // Formats the trace file as text.
+   string read_text( bool * complete = NULL )
+   {
+      ifstream in( path.c_str(), ios::binary );
+      Trace_reader reader( in );
+      ostringstream text;
+      const bool read = reader.write_text( text );
+      if ( complete != NULL )
+      {
+         *complete = read;
+      }
+      return text.str();
+   }
+
+   void read_file( const char * file, vector<char> & buf )
+   {
+      ifstream in( file, ios::binary );
+      in.seekg( 0, ios::end );
+      buf.resize( in.tellg() );
+      in.seekg( 0, ios::beg );
+      in.read( &buf[0], buf.size() );
+   }
+};
+
+// Verify events are read back with their offsets and fields.
+TEST_F(TraceTest, reads_events_back)
+{
+   const char file[16] = { 0 };
+   {
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      writer.event( Trace_event::Pair, NULL ).text( "a.gcno" ).text( "a.gcda" );
+      writer.set_base( file );
+      writer.event( Trace_event::Gcno_arc, file + 12 )
+         .number( 3 ).number( 5 );
+      writer.event( Trace_event::Gcda_count, file + 4 )
+         .number( 0xFFFFFFFFFFFFFFFFull );
+   }
+
+   ifstream in( path.c_str(), ios::binary );
+   Trace_reader reader( in );
+   Trace_event event;
+
+   ASSERT_TRUE( reader.read( event ) );
+   EXPECT_EQ( Trace_event::Pair, event.m_tag );
+   EXPECT_EQ( 0u, event.m_offset );
+   ASSERT_EQ( 2u, event.m_strings.size() );
+   EXPECT_EQ( "a.gcda", event.m_strings[1] );
+
+   ASSERT_TRUE( reader.read( event ) );
+   EXPECT_EQ( Trace_event::Gcno_arc, event.m_tag );
+   EXPECT_EQ( 12u, event.m_offset );
+   ASSERT_EQ( 2u, event.m_numbers.size() );
+   EXPECT_EQ( 5u, event.m_numbers[1] );
+
+   ASSERT_TRUE( reader.read( event ) );
+   EXPECT_EQ( 4u, event.m_offset );
+   EXPECT_EQ( 0xFFFFFFFFFFFFFFFFull, event.m_numbers[0] );
+
+   EXPECT_FALSE( reader.read( event ) );
+   EXPECT_TRUE( reader.is_complete() );
+}
+
+// Verify events are formatted as the text of the debug dump.
+TEST_F(TraceTest, writes_dump_text)
+{
+   {
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      writer.event( Trace_event::Gcno_arcs, NULL ).number( 2 ).number( 1 );
+      writer.event( Trace_event::Gcno_arc, NULL ).number( 2 ).number( 4 );
+      writer.event( Trace_event::Gcda_arcs, NULL ).number( 2 );
+   }
+
+   EXPECT_EQ( "Arcs: aLength= 2 aBlockno= 1\n"
+              "      destblock= 2 aFlags= 4\n"
+              "   aLength: 2\n", read_text() );
+}
+
+// Verify events spanning the buffer, and strings longer than it, are kept.
+TEST_F(TraceTest, writes_past_buffer)
+{
+   const string long_name( Trace_writer::Buffer_size + 10, 'x' );
+   const size_t count = Trace_writer::Buffer_size / 4;
+   {
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      for ( size_t i = 0; i < count; ++i )
+      {
+         writer.event( Trace_event::Gcno_line_number, NULL ).number( i );
+      }
+      writer.event( Trace_event::Gcno_line_name, NULL ).text( long_name );
+   }
+
+   ifstream in( path.c_str(), ios::binary );
+   Trace_reader reader( in );
+   Trace_event event;
+   for ( size_t i = 0; i < count; ++i )
+   {
+      ASSERT_TRUE( reader.read( event ) );
+      ASSERT_EQ( i, event.m_numbers[0] );
+   }
+   ASSERT_TRUE( reader.read( event ) );
+   EXPECT_EQ( long_name, event.m_strings[0] );
+   EXPECT_FALSE( reader.read( event ) );
+   EXPECT_TRUE( reader.is_complete() );
+}
+
+// Verify files that are not traces, and cut traces, are rejected.
+TEST_F(TraceTest, rejects_bad_traces)
+{
+   {
+      ofstream out( path.c_str(), ios::binary );
+      out << "Version: 1\n";
+   }
+   bool complete = true;
+   EXPECT_EQ( "", read_text( &complete ) );
+   EXPECT_FALSE( complete );
+
+   {
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      writer.event( Trace_event::Gcno_lines, NULL ).number( 300 );
+   }
+   EXPECT_EQ( "", read_text( &complete ) );
+   EXPECT_FALSE( complete );
+
+   // A text length far past the end of the trace
+   {
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      writer.event( Trace_event::Gcno_line_name, NULL )
+         .number( uint64_t( 1 ) << 62 );
+   }
+   EXPECT_EQ( "", read_text( &complete ) );
+   EXPECT_FALSE( complete );
+}
+
+#ifdef DEBUGFLAG
+// Verify the decoder and the grammars trace the same dump.
+TEST_F(TraceTest, decoder_matches_grammars)
+{
+   vector<char> gcno_buf, gcda_buf;
+   read_file( "../test/resources/BST/bst.gcno", gcno_buf );
+   read_file( "../test/resources/BST/bst.gcda", gcda_buf );
+   vector<string> found_source_files( 1, "bst.cpp" );
+   Selector::get_instance().select( vector<string>() );
+
+   Source_file_map decoded;
+   {
+      Parser_builder builder( decoded, "", found_source_files );
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      Gcov_decoder decoder( builder, true, writer );
+      writer.set_base( &gcno_buf[0] );
+      ASSERT_TRUE( decoder.decode_gcno( &gcno_buf[0], 
+         &gcno_buf[0] + gcno_buf.size(), true ) );
+      writer.set_base( &gcda_buf[0] );
+      ASSERT_TRUE( decoder.decode_gcda( &gcda_buf[0], 
+         &gcda_buf[0] + gcda_buf.size(), true ) );
+   }
+   bool complete = false;
+   const string decoded_text = read_text( &complete );
+   EXPECT_TRUE( complete );
+
+   Source_file_map parsed;
+   {
+      Parser_builder builder( parsed, "", found_source_files );
+      Trace_writer writer;
+      ASSERT_TRUE( writer.open( path ) );
+      Gcno_grammar gcno_grammar( builder, true, writer );
+      Gcda_grammar gcda_grammar( builder, true, writer );
+      raw_parse( &gcno_buf[0], &gcno_buf[0] + gcno_buf.size(), 
+         gcno_grammar, true );
+      raw_parse( &gcda_buf[0], &gcda_buf[0] + gcda_buf.size(), 
+         gcda_grammar, true );
+   }
+
+   EXPECT_EQ( 0u, decoded_text.find( "Version: " ) );
+   EXPECT_NE( string::npos, decoded_text.find( "AnnounceFunction: " ) );
+   EXPECT_NE( string::npos, decoded_text.find( "     aCount: " ) );
+   EXPECT_EQ( read_text(), decoded_text );
+}
+#endif
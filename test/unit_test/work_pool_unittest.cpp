@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////
+//  COPYRIGHT (c) 2009 Schweitzer Engineering Laboratories, Pullman, WA
+///////////////////////////////////////////////////////////////////////////////
+//  Permission is hereby granted, free of charge, to any person
+//  obtaining a copy of this software and associated documentation
+//  files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use,
+//  copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following
+//  conditions:
+// 
+//  The above copyright notice and this permission notice shall be
+//  included in all copies or substantial portions of the Software.
+// 
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//  OTHER DEALINGS IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///  @file
+///  work_pool_unittest.cpp 
+///
+///  @brief
+///  Tests the Work_pool class. 
+///////////////////////////////////////////////////////////////////////////////
+
+// TEST INCLUDE
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+
+// SOURCE FILE 
+
+#include "work_pool.h"
+
+using namespace std;
+
+class WorkPoolTest : public testing::Test
+{
+protected:
+
+   vector<size_t> jobs;
+   vector<unsigned> runs;
+   boost::mutex runs_mutex;
+
+   // Called before every test.  
+   virtual void SetUp()
+   {
+      jobs.clear();
+      runs.assign( 100, 0 );
+      for ( size_t i = 0; i < runs.size(); ++i )
+      {
+         jobs.push_back( i );
+      }
+   }
+
+public:
+
+   void run( size_t job )
+   {
+      boost::mutex::scoped_lock lock( runs_mutex );
+      ++runs[job];
+   }
+
+protected:
+
+   void expect_each_run_once()
+   {
+      for ( size_t i = 0; i < runs.size(); ++i )
+      {
+         EXPECT_EQ( 1u, runs[i] );
+      }
+   }
+};
+
+// Tests every job runs exactly once.
+TEST_F( WorkPoolTest, start )
+{
+   Work_pool pool( 4 );
+   pool.start( jobs, boost::bind( &WorkPoolTest::run, this, _1 ) );
+   pool.join();
+
+   expect_each_run_once();
+}
+
+// Tests a single worker runs every job.
+TEST_F( WorkPoolTest, single_worker )
+{
+   Work_pool pool( 1 );
+   pool.start( jobs, boost::bind( &WorkPoolTest::run, this, _1 ) );
+   pool.join();
+
+   expect_each_run_once();
+}
+
+// Tests more workers than jobs, so some queues start empty and steal.
+TEST_F( WorkPoolTest, more_workers_than_jobs )
+{
+   jobs.resize( 3 );
+   runs.resize( 3 );
+
+   Work_pool pool( 8 );
+   pool.start( jobs, boost::bind( &WorkPoolTest::run, this, _1 ) );
+   pool.join();
+
+   expect_each_run_once();
+}
+
+// Tests the destructor waits for the jobs.
+TEST_F( WorkPoolTest, destructor_joins )
+{
+   {
+      Work_pool pool( 3 );
+      pool.start( jobs, boost::bind( &WorkPoolTest::run, this, _1 ) );
+   }
+
+   expect_each_run_once();
+}